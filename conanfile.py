@@ -94,10 +94,6 @@ class GerberaConan(ConanFile):
         if self.options.curl:
             self.requires("libcurl/[>=7.85.0]")
 
-        if self.options.zip:
-            self.requires("libzip/1.10.1")
-            self.requires("libzippp/7.1-1.10.1")
-
         if self.options.exiv2:
             self.requires("inih/58") # Required by exiv2
             self.requires("exiv2/0.28.3")
@@ -233,7 +233,6 @@ if [[ ! -d "${BUILD_DIR}" ]]; then
     fi
   fi
 
-  install-libzippp static
   install-fmt
   install-spdlog
   install-taglib
@@ -38,9 +38,6 @@ if [[ "${GERBERA_ENV-head}" == "minimum" ]]; then
     JSONCPP="1.7.4"
     CMAKE="3.31.8"
     PQXX="7.10.3"
-    LIBZIP="v1.11.4"
-    LIBZIPPP_COMMIT="8992d6002b6ae941ad1a61d5bc7a512277907be3"
-    LIBZIPPP="v7.1-1.10.1"
     CXXOPTS="3.2.0"
     UTF8CPP="4.1.1"
 
@@ -64,9 +61,6 @@ elif [[ "${GERBERA_ENV-head}" == "default" ]]; then
     JSONCPP="1.9.6"
     CMAKE="3.31.8"
     PQXX="7.10.3"
-    LIBZIP="v1.11.4"
-    LIBZIPPP_COMMIT="8992d6002b6ae941ad1a61d5bc7a512277907be3"
-    LIBZIPPP="v7.1-1.10.1"
     CXXOPTS="3.2.1"
     UTF8CPP="4.1.1"
 
@@ -90,9 +84,6 @@ else
     JSONCPP="1.9.8-rc1"
     CMAKE="4.4.0"
     PQXX="7.10.3"
-    LIBZIP="v1.11.4"
-    LIBZIPPP_COMMIT="7ed7b6e2817dc4b1f247f48b44cb8a013ba18683"
-    LIBZIPPP="v7.1-1.10.1"
     CXXOPTS="3.3.1"
     CXXOPTS_COMMIT="b6135315a54deb2b556219906eda8346f69bf703"
     UTF8CPP="4.1.1"
@@ -55,6 +55,7 @@ void CdsObject::copyTo(const std::shared_ptr<CdsObject>& obj)
     obj->setLocation(location, obj->getEntryType()); // keep the entry type from object creation
     obj->setMTime(mtime);
     obj->setSizeOnDisk(sizeOnDisk);
+    obj->setFileId(fileId);
     obj->setVirtual(virt);
     obj->setMetaData(metaData);
     obj->setAuxData(auxdata);
@@ -115,6 +115,9 @@ protected:
     /// @brief File size on disk (in bytes).
     std::uintmax_t sizeOnDisk {};
 
+    /// @brief Device and inode of the file system entry
+    FileId fileId;
+
     /// @brief virtual object flag
     bool virt {};
 
@@ -237,6 +240,11 @@ public:
     /// @brief Retrieve the file size (in bytes).
     std::uintmax_t getSizeOnDisk() const { return sizeOnDisk; }
 
+    /// @brief Set device and inode of the file system entry.
+    void setFileId(FileId fileId) { this->fileId = fileId; }
+    /// @brief Retrieve device and inode of the file system entry.
+    FileId getFileId() const { return fileId; }
+
     /// @brief Set the virtual flag.
     void setVirtual(bool virt) { this->virt = virt; }
     /// @brief Query the virtual flag.
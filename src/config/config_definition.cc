@@ -267,6 +267,12 @@ std::vector<std::shared_ptr<ConfigSetup>> ConfigDefinition::getServerOptions()
         std::make_shared<ConfigBoolSetup>(ConfigVal::SERVER_HIDE_PC_DIRECTORY_WEB,
             "/server/pc-directory/attribute::web-hide", "config-server.html#confval-web-hide",
             NO),
+        std::make_shared<ConfigUIntSetup>(ConfigVal::SERVER_STREAMING_READ_AHEAD,
+            "/server/streaming/attribute::read-ahead", "config-server.html#confval-read-ahead",
+            4096),
+        std::make_shared<ConfigUIntSetup>(ConfigVal::SERVER_STREAMING_MMAP_SIZE,
+            "/server/streaming/attribute::mmap-size", "config-server.html#confval-mmap-size",
+            0),
         std::make_shared<ConfigPathSetup>(ConfigVal::SERVER_BOOKMARK_FILE,
             "/server/bookmark", "config-server.html#confval-bookmark",
             "gerbera.html", ConfigPathArguments::isFile | ConfigPathArguments::resolveEmpty),
@@ -287,6 +293,12 @@ std::vector<std::shared_ptr<ConfigSetup>> ConfigDefinition::getServerOptions()
         std::make_shared<ConfigUIntSetup>(ConfigVal::SERVER_STORAGE_STRING_LIMIT,
             "/server/storage/attribute::string-limit", "config-server.html#confval-string-limit",
             255),
+        std::make_shared<ConfigUIntSetup>(ConfigVal::SERVER_STORAGE_OBJECT_CACHE_SIZE,
+            "/server/storage/attribute::object-cache-size", "config-server.html#confval-object-cache-size",
+            1024),
+        std::make_shared<ConfigBoolSetup>(ConfigVal::SERVER_STORAGE_SEARCH_INDEX,
+            "/server/storage/attribute::search-index", "config-server.html#confval-search-index",
+            NO),
 
         std::make_shared<ConfigStringSetup>(ConfigVal::SERVER_STORAGE_DRIVER,
             "/server/storage/driver", "config-server.html#storage"),
@@ -298,6 +310,12 @@ std::vector<std::shared_ptr<ConfigSetup>> ConfigDefinition::getServerOptions()
         std::make_shared<ConfigIntSetup>(ConfigVal::SERVER_STORAGE_SQLITE_SHUTDOWN_ATTEMPTS,
             "/server/storage/sqlite3/attribute::shutdown-attempts", "config-server.html#confval-shutdown-attempts",
             5, 2, ConfigIntSetup::CheckMinValue),
+        std::make_shared<ConfigIntSetup>(ConfigVal::SERVER_STORAGE_SQLITE_STATEMENT_CACHE_SIZE,
+            "/server/storage/sqlite3/attribute::statement-cache-size", "config-server.html#confval-statement-cache-size",
+            64, 0, ConfigIntSetup::CheckMinValue),
+        std::make_shared<ConfigIntSetup>(ConfigVal::SERVER_STORAGE_SQLITE_READ_CONNECTIONS,
+            "/server/storage/sqlite3/attribute::read-connections", "config-server.html#confval-read-connections",
+            0, 0, ConfigIntSetup::CheckMinValue),
         std::make_shared<ConfigPathSetup>(ConfigVal::SERVER_STORAGE_SQLITE_DATABASE_FILE,
             "/server/storage/sqlite3/database-file", "config-server.html#confval-database-file",
             "gerbera.db", ConfigPathArguments::isFile | ConfigPathArguments::resolveEmpty),
@@ -665,6 +683,18 @@ std::vector<std::shared_ptr<ConfigSetup>> ConfigDefinition::getServerExtendedOpt
         std::make_shared<ConfigStringSetup>(ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_CACHE_DIR, // ConfigPathSetup
             "/server/extended-runtime-options/ffmpegthumbnailer/cache-dir", "config-extended.html#confval-ffmpegthumbnailer-cache-dir",
             ""),
+        std::make_shared<ConfigUIntSetup>(ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_THREADS,
+            "/server/extended-runtime-options/ffmpegthumbnailer/threads", "config-extended.html#confval-ffmpegthumbnailer-threads",
+            2),
+        std::make_shared<ConfigUIntSetup>(ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_MEMORY_CACHE_SIZE,
+            "/server/extended-runtime-options/ffmpegthumbnailer/memory-cache-size", "config-extended.html#confval-ffmpegthumbnailer-memory-cache-size",
+            4096),
+        std::make_shared<ConfigUIntSetup>(ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_PREGENERATE_THREADS,
+            "/server/extended-runtime-options/ffmpegthumbnailer/pregenerate-threads", "config-extended.html#confval-ffmpegthumbnailer-pregenerate-threads",
+            0),
+        std::make_shared<ConfigUIntSetup>(ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_PREGENERATE_CPU_BUDGET,
+            "/server/extended-runtime-options/ffmpegthumbnailer/pregenerate-cpu-budget", "config-extended.html#confval-ffmpegthumbnailer-pregenerate-cpu-budget",
+            25, CheckPercentageValue),
 #endif
 
         // Playmarks
@@ -1127,6 +1157,12 @@ std::vector<std::shared_ptr<ConfigSetup>> ConfigDefinition::getImportOptions()
         std::make_shared<ConfigBoolSetup>(ConfigVal::IMPORT_CASE_SENSITIVE_TAGS,
             "/import/attribute::case-sensitive-tags", "config-import.html#confval-case-sensitive-tags",
             YES),
+        std::make_shared<ConfigUIntSetup>(ConfigVal::IMPORT_METADATA_THREADS,
+            "/import/attribute::metadata-threads", "config-import.html#confval-metadata-threads",
+            0),
+        std::make_shared<ConfigUIntSetup>(ConfigVal::IMPORT_SCAN_THREADS,
+            "/import/attribute::scan-threads", "config-import.html#confval-scan-threads",
+            0),
         std::make_shared<ConfigVectorSetup>(ConfigVal::IMPORT_VIRTUAL_DIRECTORY_KEYS,
             "/import/virtual-directories", "config-import.html#confval-virtual-directories",
             ConfigVal::A_IMPORT_VIRT_DIR_KEY,
@@ -1376,6 +1412,9 @@ std::vector<std::shared_ptr<ConfigSetup>> ConfigDefinition::getImportOptions()
         std::make_shared<ConfigBoolSetup>(ConfigVal::IMPORT_AUTOSCAN_INOTIFY_ATTRIB,
             "/import/autoscan/attribute::inotify-attrib", "config-import.html#confval-inotify-attrib",
             NO),
+        std::make_shared<ConfigUIntSetup>(ConfigVal::IMPORT_AUTOSCAN_INOTIFY_DELAY,
+            "/import/autoscan/attribute::inotify-delay", "config-import.html#confval-inotify-delay",
+            1000),
         std::make_shared<ConfigAutoscanSetup>(ConfigVal::IMPORT_AUTOSCAN_INOTIFY_LIST,
             "/import/autoscan", "config-import.html#confval-autoscan",
             AutoscanScanMode::INotify),
@@ -2541,6 +2580,10 @@ void ConfigDefinition::initDependencies()
         { ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_IMAGE_QUALITY, ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_ENABLED },
         { ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_CACHE_DIR_ENABLED, ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_ENABLED },
         { ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_CACHE_DIR, ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_ENABLED },
+        { ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_THREADS, ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_ENABLED },
+        { ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_MEMORY_CACHE_SIZE, ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_ENABLED },
+        { ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_PREGENERATE_THREADS, ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_ENABLED },
+        { ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_PREGENERATE_CPU_BUDGET, ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_ENABLED },
 #endif
 #ifdef HAVE_LASTFM
         { ConfigVal::SERVER_EXTOPTS_LASTFM_USERNAME, ConfigVal::SERVER_EXTOPTS_LASTFM_ENABLED },
@@ -51,6 +51,8 @@ enum class ConfigVal {
     SERVER_ALIVE_INTERVAL,
     SERVER_HIDE_PC_DIRECTORY,
     SERVER_HIDE_PC_DIRECTORY_WEB,
+    SERVER_STREAMING_READ_AHEAD,
+    SERVER_STREAMING_MMAP_SIZE,
     SERVER_BOOKMARK_FILE,
     SERVER_UPNP_TITLE_AND_DESC_STRING_LIMIT,
     SERVER_UI_ENABLED,
@@ -80,6 +82,8 @@ enum class ConfigVal {
     SERVER_STORAGE_USE_TRANSACTIONS,
     SERVER_STORAGE_SORT_KEY_ENABLED,
     SERVER_STORAGE_STRING_LIMIT,
+    SERVER_STORAGE_OBJECT_CACHE_SIZE,
+    SERVER_STORAGE_SEARCH_INDEX,
     SERVER_STORAGE_SQLITE_ENABLED,
     SERVER_STORAGE_SQLITE_DATABASE_FILE,
     SERVER_STORAGE_SQLITE_SYNCHRONOUS,
@@ -91,6 +95,8 @@ enum class ConfigVal {
     SERVER_STORAGE_SQLITE_UPGRADE_FILE,
     SERVER_STORAGE_SQLITE_DROP_FILE,
     SERVER_STORAGE_SQLITE_SHUTDOWN_ATTEMPTS,
+    SERVER_STORAGE_SQLITE_STATEMENT_CACHE_SIZE,
+    SERVER_STORAGE_SQLITE_READ_CONNECTIONS,
     SERVER_STORAGE_MYSQL_ENABLED,
 #ifdef HAVE_MYSQL
     SERVER_STORAGE_MYSQL_HOST,
@@ -129,6 +135,10 @@ enum class ConfigVal {
     SERVER_EXTOPTS_FFMPEGTHUMBNAILER_IMAGE_QUALITY,
     SERVER_EXTOPTS_FFMPEGTHUMBNAILER_CACHE_DIR_ENABLED,
     SERVER_EXTOPTS_FFMPEGTHUMBNAILER_CACHE_DIR,
+    SERVER_EXTOPTS_FFMPEGTHUMBNAILER_THREADS,
+    SERVER_EXTOPTS_FFMPEGTHUMBNAILER_MEMORY_CACHE_SIZE,
+    SERVER_EXTOPTS_FFMPEGTHUMBNAILER_PREGENERATE_THREADS,
+    SERVER_EXTOPTS_FFMPEGTHUMBNAILER_PREGENERATE_CPU_BUDGET,
 #endif
     SERVER_EXTOPTS_MARK_PLAYED_ITEMS_ENABLED,
     SERVER_EXTOPTS_MARK_PLAYED_ITEMS_STRING_MODE_PREPEND,
@@ -191,6 +201,7 @@ enum class ConfigVal {
 #ifdef HAVE_INOTIFY
     IMPORT_AUTOSCAN_USE_INOTIFY,
     IMPORT_AUTOSCAN_INOTIFY_ATTRIB,
+    IMPORT_AUTOSCAN_INOTIFY_DELAY,
     IMPORT_AUTOSCAN_INOTIFY_LIST,
 #endif
     IMPORT_MAPPINGS_IGNORE_UNKNOWN_EXTENSIONS,
@@ -331,6 +342,8 @@ enum class ConfigVal {
     UPNP_CAPTION_COUNT,
     IMPORT_READABLE_NAMES,
     IMPORT_CASE_SENSITIVE_TAGS,
+    IMPORT_METADATA_THREADS,
+    IMPORT_SCAN_THREADS,
     SERVER_DYNAMIC_CONTENT_LIST_ENABLED,
     SERVER_DYNAMIC_CONTENT_LIST,
     IMPORT_RESOURCES_ORDER,
@@ -36,10 +36,6 @@ Gerbera - https://gerbera.io/
 #include <spdlog/version.h>
 #include <sqlite3.h>
 
-#ifdef HAVE_ZIP
-#include <zip.h>
-#endif
-
 #ifdef HAVE_JS
 #include <duktape.h>
 #endif
@@ -138,10 +134,6 @@ bool GerberaRuntime::printCompileInfo(const std::string& arg)
             { "SQLITE ", fmt::to_string(SQLITE_VERSION) },
             { "PUGIXML", fmt::to_string(PUGIXML_VERSION) },
             { "JSONCPP", JSONCPP_VERSION_STRING },
-#ifdef HAVE_ZIP
-            { "LIBZIPPP", LIBZIPPP_VERSION },
-            { "LIBZIP", zip_libzip_version() },
-#endif
 #ifdef PACKAGE_DATADIR
             { "PACKAGE_DATADIR", PACKAGE_DATADIR },
 #endif
@@ -119,6 +119,7 @@ void GerberaRuntime::init(
         { GRB_OPTION_CFGDIR, [=](const std::string& arg) { return this->setConfigDir(arg); } },
         { GRB_OPTION_DATABASE, [=](const std::string& arg) { return this->setDatabase(arg); } },
         { GRB_OPTION_DROPTABLES, [=](const std::string& arg) { return this->dropTables(arg); } },
+        { GRB_OPTION_CHECKDATABASE, [=](const std::string& arg) { return this->setCheckDatabase(arg); } },
 #ifdef HAVE_LASTFM
 #ifndef HAVE_LASTFMLIB
         { GRB_OPTION_INITLASTFM, [=](const std::string& arg) { return this->initLastFM(arg); } },
@@ -555,6 +556,15 @@ bool GerberaRuntime::dropTables(const std::string& arg)
     return true;
 }
 
+bool GerberaRuntime::setCheckDatabase(const std::string& arg)
+{
+    checkDatabase = (*results)[arg].as<bool>();
+    if (checkDatabase)
+        log_info("Checking database child counts");
+
+    return true;
+}
+
 #ifdef HAVE_LASTFM
 #ifndef HAVE_LASTFMLIB
 bool GerberaRuntime::initLastFM(const std::string& arg)
@@ -69,6 +69,7 @@ using HandleCallback = std::function<bool()>;
 #define GRB_OPTION_SETOPTION "set-option"
 #define GRB_OPTION_ADDFILE "add-file"
 #define GRB_OPTION_DROPTABLES "drop-tables"
+#define GRB_OPTION_CHECKDATABASE "check-database"
 #define GRB_OPTION_INITLASTFM "init-lastfm"
 
 #define DEFAULT_CONFIG_HOME ".config/gerbera"
@@ -144,6 +145,8 @@ public:
     bool getOffline() const { return offline; }
     /// @brief access property for active drop database flag
     bool getDropDatabase() const { return dropDatabase; }
+    /// @brief access property for active check database flag
+    bool getCheckDatabase() const { return checkDatabase; }
     /// @brief access property for active init Last.FM flag
     bool getLastFM() const { return lastFM; }
     /// @brief access property for database
@@ -175,6 +178,7 @@ private:
     bool debug = false;
     bool offline = false;
     bool dropDatabase = false;
+    bool checkDatabase = false;
     int configModules = { 0 };
     bool lastFM = false;
     ConfigLevel exampleConfigSet;
@@ -233,6 +237,8 @@ private:
     bool setConfigDir(const std::string& arg);
     /// @brief handler to drop database tables
     bool dropTables(const std::string& arg);
+    /// @brief handler to check and repair database content
+    bool setCheckDatabase(const std::string& arg);
 #ifdef HAVE_LASTFM
 #ifndef HAVE_LASTFMLIB
     /// @brief handler to get Last.FM session key
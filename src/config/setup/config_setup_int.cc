@@ -185,6 +185,11 @@ bool CheckPortValue(UIntOptionType value)
     return value >= 0 && value <= 65535;
 }
 
+bool CheckPercentageValue(UIntOptionType value)
+{
+    return value >= 1 && value <= 100;
+}
+
 template class ConfigIntegerSetup<IntOptionType, IntOption>;
 template class ConfigIntegerSetup<UIntOptionType, UIntOption>;
 template class ConfigIntegerSetup<LongOptionType, LongOption>;
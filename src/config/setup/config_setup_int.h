@@ -177,6 +177,7 @@ bool CheckUpnpStringLimitValue(IntOptionType value);
 bool CheckProfileNumberValue(std::string& value);
 bool CheckImageQualityValue(IntOptionType value);
 bool CheckPortValue(UIntOptionType value);
+bool CheckPercentageValue(UIntOptionType value);
 
 using ConfigIntSetup = ConfigIntegerSetup<IntOptionType, IntOption>;
 using ConfigUIntSetup = ConfigIntegerSetup<UIntOptionType, UIntOption>;
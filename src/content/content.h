@@ -122,6 +122,8 @@ public:
     virtual std::deque<std::shared_ptr<GenericTask>> getTasklist() = 0;
     /// @brief Find a task identified by the task ID and invalidate it.
     virtual void invalidateTask(unsigned int taskID, TaskOwner taskOwner) = 0;
+    /// @brief Check if a queued or running import can still add the entry with the file id.
+    virtual bool isImportPending(const FileId& fileId) = 0;
 
     /// @brief Get an AutoscanDirectory given by location on disk from the watch list.
     virtual std::shared_ptr<AutoscanDirectory> getAutoscanDirectory(const fs::path& location) const = 0;
@@ -81,7 +81,23 @@
 #include "content/inotify/scripting_inotify.h"
 #endif
 
+#ifdef HAVE_FFMPEGTHUMBNAILER
+#include "metadata/ffmpeg_thumbnailer_handler.h"
+#endif
+
 #include <algorithm>
+#include <thread>
+
+#ifdef HAVE_JS
+#define MAX_DEFAULT_LAYOUT_HEAPS 4 // each heap loads all scripts for each autoscan directory
+
+/// @brief one layout heap for each metadata thread so the layout can run on all of them
+static std::size_t getLayoutHeapCount(const std::shared_ptr<Config>& config)
+{
+    std::size_t count = config->getUIntOption(ConfigVal::IMPORT_METADATA_THREADS);
+    return count > 0 ? count : std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, MAX_DEFAULT_LAYOUT_HEAPS);
+}
+#endif
 
 ContentManager::ContentManager(const std::shared_ptr<Context>& context,
     const std::shared_ptr<Server>& server, std::shared_ptr<Timer> timer)
@@ -93,7 +109,7 @@ ContentManager::ContentManager(const std::shared_ptr<Context>& context,
     , context(context)
     , timer(std::move(timer))
 #ifdef HAVE_JS
-    , scriptingRuntime(std::make_shared<ScriptingRuntime>())
+    , scriptingRuntime(std::make_shared<ScriptingRuntime>(getLayoutHeapCount(context->getConfig())))
 #endif
 #ifdef HAVE_LASTFM
     , last_fm(std::make_shared<LastFm>(context))
@@ -377,6 +393,11 @@ std::deque<std::shared_ptr<GenericTask>> ContentManager::getTasklist()
     std::deque<std::shared_ptr<GenericTask>> taskList;
 #ifdef ONLINE_SERVICES
     taskList = task_processor->getTasklist();
+#endif
+#ifdef HAVE_FFMPEGTHUMBNAILER
+    auto thumbTask = FfmpegThumbnailerHandler::getPregenerationTask();
+    if (thumbTask)
+        taskList.push_back(std::move(thumbTask));
 #endif
     auto t = getCurrentTask();
 
@@ -396,6 +417,27 @@ std::deque<std::shared_ptr<GenericTask>> ContentManager::getTasklist()
     return taskList;
 }
 
+bool ContentManager::isImportPending(const FileId& fileId)
+{
+    auto lock = threadRunner->lockGuard("isImportPending");
+
+    auto isImport = [&fileId](const std::shared_ptr<GenericTask>& task) {
+        if (!task || !task->isValid())
+            return false;
+        if (task->getType() == TaskType::RescanDirectory)
+            return true;
+        auto addTask = std::dynamic_pointer_cast<CMAddFileTask>(task);
+        if (!addTask)
+            return false;
+        // entry can be anywhere below an imported directory
+        std::error_code ec;
+        return fs::is_directory(addTask->getPath(), ec) || getFileId(addTask->getPath()) == fileId;
+    };
+    return isImport(currentTask)
+        || std::any_of(taskQueue1.begin(), taskQueue1.end(), isImport)
+        || std::any_of(taskQueue2.begin(), taskQueue2.end(), isImport);
+}
+
 std::shared_ptr<ImportService> ContentManager::getImportService(const std::shared_ptr<AutoscanDirectory>& adir) const
 {
     auto result = adir ? adir->getImportService() : nullptr;
@@ -1754,12 +1796,13 @@ void ContentManager::triggerPlayHook(const std::string& group, const std::shared
 {
     log_debug("start");
 
+    // obj may be shared from the object cache, so only the stored play status is changed
     auto item = std::static_pointer_cast<CdsItem>(obj);
     auto playStatus = item->getPlayStatus();
-    if (!playStatus) {
+    if (playStatus && playStatus->getGroup() == group)
+        playStatus = playStatus->clone();
+    else
         playStatus = std::make_shared<ClientStatusDetail>(group, item->getID(), 0, 0, 0, 0);
-        item->setPlayStatus(playStatus);
-    }
     playStatus->increasePlayCount();
     playStatus->setLastPlayed();
     database->savePlayStatus(playStatus);
@@ -1767,7 +1810,7 @@ void ContentManager::triggerPlayHook(const std::string& group, const std::shared
     bool suppress = config->getBoolOption(ConfigVal::SERVER_EXTOPTS_MARK_PLAYED_ITEMS_ENABLED) && config->getBoolOption(ConfigVal::SERVER_EXTOPTS_MARK_PLAYED_ITEMS_SUPPRESS_CDS_UPDATES);
     log_debug("Marking object {} as played", obj->getTitle());
     if (!suppress)
-        updateObject(obj, true);
+        update_manager->containerChanged(obj->getParentID());
 
 #ifdef HAVE_LASTFM
     if (config->getBoolOption(ConfigVal::SERVER_EXTOPTS_LASTFM_ENABLED) && item->isSubClass(UPNP_CLASS_AUDIO_ITEM)) {
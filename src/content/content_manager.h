@@ -95,6 +95,9 @@ public:
     /// @brief Find a task identified by the task ID and invalidate it.
     void invalidateTask(unsigned int taskID, TaskOwner taskOwner) override;
 
+    /// @brief Check if a queued or running import can still add the entry with the file id.
+    bool isImportPending(const FileId& fileId) override;
+
     /// @brief Adds a file or directory to the database.
     /// @param dirEnt absolute path to the file
     /// @param asSetting Settings for import
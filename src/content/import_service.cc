@@ -39,9 +39,11 @@
 #include "metadata/metadata_enums.h"
 #include "metadata/metadata_handler.h"
 #include "metadata/metadata_service.h"
+#include "util/file_probe.h"
 #include "util/mime.h"
 #include "util/string_converter.h"
 #include "util/tools.h"
+#include "util/worker_pool.h"
 
 #ifdef HAVE_JS
 #include "layout/js_layout.h"
@@ -52,8 +54,32 @@
 #endif
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <fcntl.h>
 #include <fmt/chrono.h>
+#include <iterator>
 #include <regex>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+#define METADATA_PENDING_PER_WORKER 16 // files waiting for the database per metadata worker
+#define IMPORT_BATCH_SIZE 100 // new items added to the database in one transaction
+#define MAPPED_TREES_CACHE_SIZE 4096 // container chain paths with layout mapping applied
+
+/// @brief number of layouts running on the current thread
+static thread_local int layoutDepth = 0;
+
+/// @brief marks the current thread as running a layout while in scope
+class LayoutDepth {
+public:
+    LayoutDepth() { layoutDepth++; }
+    ~LayoutDepth() { layoutDepth--; }
+
+    LayoutDepth(const LayoutDepth&) = delete;
+    LayoutDepth& operator=(const LayoutDepth&) = delete;
+};
 
 bool UpnpMap::checkValue(const std::string& op, const std::string& expect, const std::string& actual) const
 {
@@ -131,30 +157,33 @@ ContentState::ContentState(fs::directory_entry dirEntry, ImportState state, std:
     , mtime(mtime)
     , cdsObject(std::move(cdsObject))
 {
-    itemCounter[ObjectType::Audio] = 0;
-    itemCounter[ObjectType::Video] = 0;
-    itemCounter[ObjectType::Image] = 0;
-    itemCounter[ObjectType::Playlist] = 0;
-    itemCounter[ObjectType::Folder] = 0;
-    itemCounter[ObjectType::Unknown] = 0;
+}
+
+void ContentState::increaseItemCounter(ObjectType mt)
+{
+    if (mt == ObjectType::Audio)
+        audioCount++;
+    else if (mt == ObjectType::Image)
+        imageCount++;
+    else if (mt == ObjectType::Video)
+        videoCount++;
 }
 
 AutoscanMediaMode ContentState::getMediaMode() const
 {
     AutoscanMediaMode mediaMode = AutoscanMediaMode::Mixed;
-    std::size_t maxValue = 3; // at least 4 items are required to set upnp_class
-    std::lock_guard<std::mutex> lock(counterMutex);
-    if (itemCounter.at(ObjectType::Audio) > maxValue) {
+    std::uint32_t maxValue = 3; // at least 4 items are required to set upnp_class
+    if (audioCount > maxValue) {
         mediaMode = AutoscanMediaMode::Audio;
-        maxValue = itemCounter.at(ObjectType::Audio);
+        maxValue = audioCount;
     }
-    if (itemCounter.at(ObjectType::Image) > maxValue) {
+    if (imageCount > maxValue) {
         mediaMode = AutoscanMediaMode::Image;
-        maxValue = itemCounter.at(ObjectType::Image);
+        maxValue = imageCount;
     }
-    if (itemCounter.at(ObjectType::Video) > maxValue) {
+    if (videoCount > maxValue) {
         mediaMode = AutoscanMediaMode::Video;
-        maxValue = itemCounter.at(ObjectType::Video);
+        maxValue = videoCount;
     }
     return mediaMode;
 }
@@ -167,6 +196,23 @@ void StateCache::cacheState(
     const std::shared_ptr<CdsObject>& cdsObject)
 {
     auto cacheLock = CacheAutoLock(cacheMutex);
+    storeState(entryPath, dirEntry, state, mtime, cdsObject);
+}
+
+void StateCache::cacheStates(const std::vector<std::pair<fs::directory_entry, std::chrono::seconds>>& entries)
+{
+    auto cacheLock = CacheAutoLock(cacheMutex);
+    for (auto&& [dirEntry, mtime] : entries)
+        storeState(dirEntry.path(), dirEntry, ImportState::New, mtime, nullptr);
+}
+
+void StateCache::storeState(
+    const fs::path& entryPath,
+    const fs::directory_entry& dirEntry,
+    ImportState state,
+    std::chrono::seconds mtime,
+    const std::shared_ptr<CdsObject>& cdsObject)
+{
     log_debug("cache '{}' , '{}' ({})", entryPath.string(), dirEntry.path().string(), state);
 
     if (entryPath.empty())
@@ -185,6 +231,26 @@ void StateCache::cacheState(
     }
 }
 
+std::size_t StateCache::getEntryCount() const
+{
+    auto cacheLock = CacheAutoLock(cacheMutex);
+    return std::max(compactedCount, contentStateCache.size());
+}
+
+void StateCache::compact(const std::string& fileName)
+{
+    auto cacheLock = CacheAutoLock(cacheMutex);
+    compactedCount = std::max(compactedCount, contentStateCache.size());
+    for (auto it = contentStateCache.begin(); it != contentStateCache.end();) {
+        if (!fileName.empty() && it->second && it->first.filename() == fileName) {
+            it->second = std::make_shared<ContentState>(it->second->getDirEntry(), it->second->getState());
+            ++it;
+        } else {
+            it = contentStateCache.erase(it);
+        }
+    }
+}
+
 std::shared_ptr<CdsObject> StateCache::getObject(const fs::path& location) const
 {
     log_debug("start {}", location.string());
@@ -259,11 +325,41 @@ ImportService::ImportService(std::shared_ptr<Context> context, std::shared_ptr<C
     hasDefaultDate = config->getBoolOption(ConfigVal::IMPORT_DEFAULT_DATE);
     mimetypeContenttypeMap = config->getDictionaryOption(ConfigVal::IMPORT_MAPPINGS_MIMETYPE_TO_CONTENTTYPE_LIST);
     mimetypeUpnpclassMap = config->getDictionaryOption(ConfigVal::IMPORT_MAPPINGS_MIMETYPE_TO_UPNP_CLASS_LIST);
-    configLayoutMapping = config->getDictionaryOption(ConfigVal::IMPORT_LAYOUT_MAPPING);
+    for (auto&& [key, val] : config->getDictionaryOption(ConfigVal::IMPORT_LAYOUT_MAPPING)) {
+        try {
+            layoutMappings.emplace_back(std::regex(key), val);
+        } catch (const std::regex_error& e) {
+            log_error("Invalid layout mapping '{}': {}", key, e.what());
+        }
+    }
     containerImageParentCount = config->getIntOption(ConfigVal::IMPORT_RESOURCES_CONTAINERART_PARENTCOUNT);
     containerImageMinDepth = config->getIntOption(ConfigVal::IMPORT_RESOURCES_CONTAINERART_MINDEPTH);
-    virtualDirKeys = config->getVectorOption(ConfigVal::IMPORT_VIRTUAL_DIRECTORY_KEYS);
+    for (auto&& vdirSetting : config->getVectorOption(ConfigVal::IMPORT_VIRTUAL_DIRECTORY_KEYS)) {
+        std::string field;
+        VirtualDirKey dirKey;
+        for (auto&& [key, vdirField] : vdirSetting) {
+            if (key == "metadata")
+                field = vdirField;
+            if (key == "class")
+                dirKey.upnpClass = vdirField;
+        }
+        if (field.empty())
+            continue;
+        if (field != "LOCATION") {
+            dirKey.singleValue = endswith(field, "_1");
+            if (dirKey.singleValue)
+                field.erase(field.size() - 2);
+            dirKey.metaField = MetaEnumMapper::getMetaFieldName(MetaEnumMapper::remapMetaDataField(field));
+        }
+        virtualDirKeys.push_back(std::move(dirKey));
+    }
     noMediaName = config->getOption(ConfigVal::IMPORT_NOMEDIA_FILE);
+    metadataThreads = config->getUIntOption(ConfigVal::IMPORT_METADATA_THREADS);
+    if (metadataThreads == 0)
+        metadataThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    scanThreads = config->getUIntOption(ConfigVal::IMPORT_SCAN_THREADS);
+    if (scanThreads == 0)
+        scanThreads = std::max(std::thread::hardware_concurrency(), 1U);
     UpnpMap::initMap(upnpMap, mimetypeUpnpclassMap);
 }
 
@@ -359,12 +455,16 @@ std::shared_ptr<CdsObject> ImportService::doImport(
     const std::shared_ptr<GenericTask>& task)
 {
     auto stateCache = std::make_shared<StateCache>();
+    auto startPeakMemory = getPeakMemoryUsage();
     log_debug("start {} root '{}' update {}", location.string(), rootPath.string(), !!settings.changedObject);
     if (activeScan.empty()) {
         if (settings.changedObject || !autoscanDir || autoscanDir->getScanMode() != AutoscanScanMode::INotify)
             clearCache();
         activeScan = location;
-        if (importStateCache->contentStateCache.empty() || location == rootPath)
+        probedBytes = 0;
+        mimeLookups.extension = 0;
+        mimeLookups.magic = 0;
+        if (importStateCache->getEntryCount() == 0 || location == rootPath)
             importStateCache = stateCache;
     } else {
         log_debug("Additional scan {}, already active {}", location.c_str(), activeScan.c_str());
@@ -417,11 +517,27 @@ std::shared_ptr<CdsObject> ImportService::doImport(
         log_debug("Updating last_modified for autoscan directory {}", autoscanDir->getLocation().c_str());
         database->updateAutoscanDirectory(autoscanDir);
     }
-    if (activeScan == location)
-        activeScan.clear();
-    if (importStateCache->contentStateCache.size() < stateCache->contentStateCache.size())
+    auto result = stateCache->getObject(location);
+    if (importStateCache->getEntryCount() < stateCache->getEntryCount())
         importStateCache = stateCache;
-    return stateCache->getObject(location);
+    if (activeScan == location) {
+        activeScan.clear();
+        // only the state of nomedia files is required for the following scans
+        importStateCache->compact(noMediaName);
+        // single files are added for each inotify event
+        if (isDir) {
+            auto peakMemory = getPeakMemoryUsage();
+            log_info("Scan of {} finished with {} entries, peak memory {} MiB (+{} MiB), {} KiB read for type detection", location.c_str(), stateCache->getEntryCount(),
+                peakMemory / (1024 * 1024), (peakMemory - std::min(peakMemory, startPeakMemory)) / (1024 * 1024), probedBytes / 1024);
+        } else {
+            log_debug("Import of {} finished, {} KiB read for type detection", location.c_str(), probedBytes / 1024);
+        }
+        if (isDir) {
+            log_info("Mime types of {} detected: {} by extension, {} by filemagic", location.c_str(),
+                mimeLookups.extension.load(), mimeLookups.magic.load());
+        }
+    }
+    return result;
 }
 
 void ImportService::readDir(
@@ -429,31 +545,89 @@ void ImportService::readDir(
     const fs::path& location, AutoScanSetting settings)
 {
     log_debug("start {}", location.string());
-    auto dirIterator = fs::directory_iterator(location, ec);
-    if (ec) {
-        log_error("Failed to iterate {}, {}", location.c_str(), ec.message());
-        return;
+    if (scanThreads <= 1) {
+        std::vector<std::pair<fs::path, AutoScanSetting>> folders { { location, std::move(settings) } };
+        while (!folders.empty()) {
+            auto [folder, folderSettings] = std::move(folders.back());
+            folders.pop_back();
+            for (auto&& subFolder : readDirEntries(stateCache, folder, folderSettings))
+                folders.emplace_back(subFolder, folderSettings);
+        }
+    } else {
+        // each folder is a job, subfolders are queued by the worker that found them
+        WorkerPool workerPool("scan", scanThreads);
+        std::mutex pendingMutex;
+        std::condition_variable pendingCond;
+        std::size_t pending = 0;
+        std::function<void(fs::path, AutoScanSetting)> submit = [&](fs::path folder, AutoScanSetting folderSettings) {
+            {
+                std::scoped_lock lock(pendingMutex);
+                pending++;
+            }
+            workerPool.submit([&, folder = std::move(folder), folderSettings = std::move(folderSettings)](std::size_t) mutable {
+                try {
+                    for (auto&& subFolder : readDirEntries(stateCache, folder, folderSettings))
+                        submit(subFolder, folderSettings);
+                } catch (const std::exception& ex) {
+                    log_error("ImportService::readDir {}: {}", folder.c_str(), ex.what());
+                }
+                std::scoped_lock lock(pendingMutex);
+                if (--pending == 0)
+                    pendingCond.notify_all();
+            });
+        };
+        submit(location, std::move(settings));
+        std::unique_lock lock(pendingMutex);
+        pendingCond.wait(lock, [&pending] { return pending == 0; });
     }
+    log_debug("end {}", location.string());
+}
+
+std::vector<fs::path> ImportService::readDirEntries(
+    const std::shared_ptr<StateCache>& stateCache,
+    const fs::path& location, AutoScanSetting& settings)
+{
+    std::error_code dirEc;
+    auto dirIterator = fs::directory_iterator(location, dirEc);
+    if (dirEc) {
+        log_error("Failed to iterate {}, {}", location.c_str(), dirEc.message());
+        return {};
+    }
+    // entry types come from the directory listing, the modification time is read relative to the folder
+    int dirFd = ::open(location.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
     settings.mergeOptions(config, location);
+
+    std::vector<std::pair<fs::directory_entry, std::chrono::seconds>> entries;
+    std::vector<fs::path> subFolders;
     for (auto&& dirEntry : dirIterator) {
         auto&& entryPath = dirEntry.path();
         if (entryPath.empty() || isHiddenFile(entryPath, true, dirEntry, settings)) {
             continue;
         }
-        stateCache->cacheState(entryPath, dirEntry, ImportState::New, toSeconds(dirEntry.last_write_time(ec)));
-        if (dirEntry.is_directory(ec) && settings.recursive) {
-            if (!ec) {
-                readDir(stateCache, entryPath, settings);
-            } else {
-                stateCache->cacheState(entryPath, dirEntry, ImportState::Broken);
-                log_error("ImportService::readDir {}: Failed to read {}, {}", location.c_str(), entryPath.c_str(), ec.message());
-            }
-        } else if (ec) {
+        std::error_code ec;
+        struct stat statBuf {};
+        bool isDir;
+        std::chrono::seconds mtime;
+        if (dirFd >= 0 && ::fstatat(dirFd, entryPath.filename().c_str(), &statBuf, 0) == 0) {
+            mtime = std::chrono::seconds(statBuf.st_mtime);
+            isDir = S_ISDIR(statBuf.st_mode);
+        } else {
+            mtime = toSeconds(dirEntry.last_write_time(ec));
+            isDir = dirEntry.is_directory(ec);
+        }
+        if (ec) {
             stateCache->cacheState(entryPath, dirEntry, ImportState::Broken);
             log_error("ImportService::readDir {}: Failed to read {}, {}", location.c_str(), entryPath.c_str(), ec.message());
+            continue;
         }
+        entries.emplace_back(dirEntry, mtime);
+        if (isDir && settings.recursive)
+            subFolders.push_back(entryPath);
     }
-    log_debug("end {}", location.string());
+    if (dirFd >= 0)
+        ::close(dirFd);
+    stateCache->cacheStates(entries);
+    return subFolders;
 }
 
 void ImportService::readFile(
@@ -530,6 +704,26 @@ bool ImportService::isHiddenFile(
     return false;
 }
 
+/// @brief file system entry still has the same device, inode, size and modification time as the object
+///
+/// Containers store the newest modification time of their content,
+/// so a directory only must not have been modified after it was scanned.
+static bool isUnchangedFile(const std::shared_ptr<CdsObject>& obj, const fs::directory_entry& dirEntry)
+{
+    if (!obj->getFileId().isValid() || obj->getFileId() != getFileId(dirEntry.path()))
+        return false;
+
+    std::error_code ec;
+    auto mTime = toSeconds(dirEntry.last_write_time(ec));
+    if (ec)
+        return false;
+    if (obj->isContainer())
+        return mTime <= obj->getMTime();
+
+    auto size = dirEntry.file_size(ec);
+    return !ec && size == obj->getSizeOnDisk() && mTime == obj->getMTime();
+}
+
 void ImportService::createContainers(
     const std::shared_ptr<StateCache>& stateCache,
     int parentContainerId,
@@ -543,9 +737,24 @@ void ImportService::createContainers(
         bool doUpdate = false;
         if (dirEntry.exists(ec) && dirEntry.is_directory(ec)) {
             auto cdsObj = stateEntry->getObject();
-            if (cdsObj) {
+            // object of a moved parent or of the directory itself has to get the new location
+            bool isMoved = cdsObj != nullptr;
+            if (!cdsObj) {
+                cdsObj = database->findObjectByPath(contPath, UNUSED_CLIENT_GROUP, DbFileType::Directory);
+                if (!cdsObj) {
+                    cdsObj = findMovedObject(dirEntry, true);
+                    isMoved = cdsObj != nullptr;
+                }
+            }
+            if (isMoved) {
                 auto oldLocation = cdsObj->getLocation();
                 cdsObj->setLocation(contPath, CdsEntryType::Directory);
+                auto parentEntry = stateCache->contentStateCache.find(contPath.parent_path());
+                auto parentId = parentEntry != stateCache->contentStateCache.end() && parentEntry->second && parentEntry->second->getObject()
+                    ? parentEntry->second->getObject()->getID()
+                    : database->ensurePathExistence(contPath.parent_path(), nullptr);
+                if (parentId != INVALID_OBJECT_ID)
+                    cdsObj->setParentID(parentId);
                 log_debug("Container renamed {} {}", cdsObj->getTitle(), contPath.filename().string());
                 cdsObj->setTitle(contPath.filename().string());
                 auto sortKey = expandNumbersString(contPath.filename().stem().string());
@@ -563,9 +772,6 @@ void ImportService::createContainers(
                     }
                 }
             }
-            if (!cdsObj)
-                cdsObj = database->findObjectByPath(contPath, UNUSED_CLIENT_GROUP, DbFileType::Directory);
-
             if (cdsObj) {
                 try {
                     std::shared_ptr<CdsObject> container = std::dynamic_pointer_cast<CdsContainer>(cdsObj);
@@ -577,6 +783,11 @@ void ImportService::createContainers(
                         container->setMTime(lastModified);
                         doUpdate = true;
                     }
+                    auto fileId = getFileId(contPath);
+                    if (fileId.isValid() && fileId != container->getFileId()) {
+                        container->setFileId(fileId);
+                        doUpdate = true;
+                    }
                     if (doUpdate) {
                         database->updateObject(cdsObj, nullptr);
                         stateEntry->setObject(ImportState::Created, cdsObj);
@@ -591,17 +802,18 @@ void ImportService::createContainers(
                 }
             } else {
                 // Create container
-                stateEntry->setObject(ImportState::Created, createSingleContainer(parentContainerId, dirEntry, UPNP_CLASS_CONTAINER_FOLDER));
+                auto container = createSingleContainer(parentContainerId, dirEntry, UPNP_CLASS_CONTAINER_FOLDER);
+                stateEntry->setObject(ImportState::Created, container);
             }
         }
     }
     log_debug("end {}", rootPath.string());
 }
 
-std::tuple<bool, std::string, std::string> ImportService::getMimeForFile(const fs::path& objectPath) const
+std::tuple<bool, std::string, std::string> ImportService::getMimeForFile(const fs::path& objectPath, const std::shared_ptr<FileProbe>& probe) const
 {
     /* retrieve information about item and decide if it should be included */
-    auto [skip, mimetype] = mime->getMimeType(objectPath, MIMETYPE_DEFAULT);
+    auto [skip, mimetype] = probe ? mime->getMimeType(*probe, MIMETYPE_DEFAULT, &mimeLookups) : mime->getMimeType(objectPath, MIMETYPE_DEFAULT, &mimeLookups);
     if (mimetype.empty()) {
         if (skip)
             log_debug("Mime set empty for file {}", objectPath.c_str());
@@ -615,7 +827,7 @@ std::tuple<bool, std::string, std::string> ImportService::getMimeForFile(const f
     if (upnpClass.empty()) {
         std::string contentType = getValueOrDefault(mimetypeContenttypeMap, mimetype);
         if (contentType == CONTENT_TYPE_OGG) {
-            upnpClass = isTheora(objectPath)
+            upnpClass = (probe ? isTheora(*probe) : isTheora(objectPath))
                 ? UPNP_CLASS_VIDEO_ITEM
                 : UPNP_CLASS_MUSIC_TRACK;
         }
@@ -632,11 +844,62 @@ void ImportService::createItems(
 {
     log_debug("start {}", rootPath.string());
     std::shared_ptr<CdsContainer> parentContainer = nullptr;
-    auto lastModifiedCurrentMax = std::chrono::seconds::zero();
-    auto lastModifiedNewMax = lastModifiedCurrentMax;
+    auto lastModifiedNewMax = std::chrono::seconds::zero();
     fs::path contPath;
 
-    for (auto&& [itemPath, stateEntry] : stateCache->contentStateCache) {
+    // metadata is read by the workers, all database changes are done here in order of the files
+    std::unique_ptr<WorkerPool> workerPool;
+    if (metadataThreads > 1) {
+        while (metadataServices.size() < metadataThreads)
+            metadataServices.push_back(std::make_shared<MetadataService>(context, content));
+        workerPool = std::make_unique<WorkerPool>("metadata", metadataThreads);
+    }
+    const std::size_t maxPending = workerPool ? workerPool->getSize() * METADATA_PENDING_PER_WORKER : 0;
+    std::deque<std::pair<std::future<void>, std::function<void()>>> pending;
+    auto finishPending = [&pending](std::size_t keep) {
+        while (pending.size() > keep) {
+            auto [extraction, finish] = std::move(pending.front());
+            pending.pop_front();
+            if (extraction.valid())
+                extraction.get();
+            finish();
+        }
+    };
+    // new items are added to the database in batches
+    std::vector<std::pair<std::shared_ptr<CdsItem>, fs::directory_entry>> newItems;
+    auto flushNewItems = [this, &stateCache, &newItems] {
+        if (newItems.empty())
+            return;
+        std::vector<std::shared_ptr<CdsObject>> objects;
+        objects.reserve(newItems.size());
+        std::transform(newItems.begin(), newItems.end(), std::back_inserter(objects), [](auto&& entry) { return entry.first; });
+        database->addObjects(objects);
+        for (auto&& [item, dirEntry] : newItems) {
+            std::vector<int> newIds;
+            if (metadataService->afterCreation(item, dirEntry, newIds)) {
+                addExtraObjects(stateCache, newIds);
+                database->updateObject(item, nullptr);
+            }
+        }
+        newItems.clear();
+    };
+    // probe holds the header of the file that was already read to detect the mime type
+    auto schedule = [&](const fs::directory_entry& dirEntry, const std::shared_ptr<CdsItem>& item, std::function<void()> finish, std::shared_ptr<FileProbe> probe = {}) {
+        std::future<void> extraction;
+        if (item && workerPool) {
+            extraction = workerPool->submit([this, dirEntry, item, mimetype = item->getMimeType(), probe = std::move(probe)](std::size_t worker) {
+                updateSingleItem(dirEntry, item, mimetype, metadataServices.at(worker), probe);
+            });
+        } else if (item) {
+            updateSingleItem(dirEntry, item, item->getMimeType(), {}, probe);
+        }
+        pending.emplace_back(std::move(extraction), std::move(finish));
+        finishPending(maxPending);
+    };
+
+    for (auto&& cacheEntry : stateCache->contentStateCache) {
+        const auto itemPath = cacheEntry.first;
+        const auto stateEntry = cacheEntry.second;
         if (!stateEntry) {
             log_debug("broken entry {}", itemPath.string());
             continue;
@@ -644,20 +907,20 @@ void ImportService::createItems(
         auto cdsObj = stateEntry->getObject();
         // cache containers as parent item for following item
         if (cdsObj && cdsObj->isContainer()) {
-            std::shared_ptr<CdsContainer> container = std::dynamic_pointer_cast<CdsContainer>(cdsObj);
-            if (!contPath.empty()) {
-                stateCache->contentStateCache.at(contPath)->setMTime(lastModifiedNewMax);
+            parentContainer = std::dynamic_pointer_cast<CdsContainer>(cdsObj);
+            schedule({}, nullptr, [this, &stateCache, &contPath, &lastModifiedNewMax, itemPath, parentContainer = parentContainer] {
+                if (!contPath.empty()) {
+                    stateCache->contentStateCache.at(contPath)->setMTime(lastModifiedNewMax);
+                    if (autoscanDir) {
+                        autoscanDir->setCurrentLMT(contPath, lastModifiedNewMax);
+                    }
+                }
+                contPath = itemPath;
                 if (autoscanDir) {
-                    autoscanDir->setCurrentLMT(contPath, lastModifiedNewMax);
+                    lastModifiedNewMax = autoscanDir->getPreviousLMT(contPath, parentContainer);
+                    autoscanDir->setCurrentLMT(contPath, std::chrono::seconds::zero());
                 }
-            }
-            parentContainer = container;
-            contPath = itemPath;
-            if (autoscanDir) {
-                lastModifiedCurrentMax = autoscanDir->getPreviousLMT(contPath, parentContainer);
-                lastModifiedNewMax = lastModifiedCurrentMax;
-                autoscanDir->setCurrentLMT(contPath, std::chrono::seconds::zero());
-            }
+            });
         }
         if (stateEntry->getState() != ImportState::New) {
             log_debug("wrong state entry {}", itemPath.string());
@@ -665,56 +928,98 @@ void ImportService::createItems(
         }
         // create items from files
         auto dirEntry = stateEntry->getDirEntry();
-        if (isRegularFile(dirEntry, ec)) {
-            // Start with cached item
-            auto contState = stateCache->contentStateCache.at(itemPath.parent_path());
-            if (contState)
-                parentContainer = std::dynamic_pointer_cast<CdsContainer>(contState->getObject());
-            else
-                log_error("No Container parent for Item {}", itemPath.string());
+        if (!isRegularFile(dirEntry, ec)) {
+            log_debug("Not a file {}", itemPath.string());
+            continue;
+        }
 
-            if (!cdsObj) {
-                // Search item in database
-                log_debug("Searching Item {} in database", itemPath.string());
-                cdsObj = database->findObjectByPath(itemPath, UNUSED_CLIENT_GROUP, DbFileType::File);
+        // Start with cached item
+        auto contState = stateCache->contentStateCache.at(itemPath.parent_path());
+        if (contState)
+            parentContainer = std::dynamic_pointer_cast<CdsContainer>(contState->getObject());
+        else
+            log_error("No Container parent for Item {}", itemPath.string());
+
+        // common part of all items after database update
+        auto finishItem = [contState, stateEntry, parentContainer = parentContainer](const std::shared_ptr<CdsObject>& obj) {
+            if (contState && obj) {
+                contState->increaseItemCounter(obj->getMediaType());
+                contState->setFirstObject(obj);
             }
-            if (cdsObj && cdsObj->isItem()) {
-                auto isChanged = stateEntry->getMTime() != cdsObj->getMTime() || cdsObj->getLocation().string() != dirEntry.path().string();
-                if (autoscanDir && autoscanDir->getForceRescan())
-                    isChanged = isChanged || cdsObj->getClass().empty() || cdsObj->getClass() == UPNP_CLASS_ITEM;
-                if (isChanged) {
-                    // Update changed item in database
-                    log_debug("Updating Item {} in database {}", itemPath.string(), cdsObj->getID());
-                    auto item = std::dynamic_pointer_cast<CdsItem>(cdsObj);
-                    if (item->getMimeType().empty() || item->getClass().empty() || item->getClass() == UPNP_CLASS_ITEM) {
-                        auto [skip, mimetype, upnpClass] = getMimeForFile(itemPath);
-                        if (!mimetype.empty()) {
-                            item->setMimeType(mimetype);
-                        }
-                        if (!upnpClass.empty()) {
-                            item->setClass(upnpClass);
-                        }
-                        log_debug("Updating Item properties {} in database: skip {} mimeType {}, upnpClass {}", skip, itemPath.string(), mimetype, upnpClass);
+            if (parentContainer) {
+                stateEntry->setParentObject(parentContainer);
+            }
+        };
+
+        if (!cdsObj) {
+            // Search item in database
+            log_debug("Searching Item {} in database", itemPath.string());
+            cdsObj = database->findObjectByPath(itemPath, UNUSED_CLIENT_GROUP, DbFileType::File);
+            if (!cdsObj)
+                cdsObj = findMovedObject(dirEntry, false);
+        }
+        if (cdsObj && cdsObj->isItem()) {
+            auto isChanged = stateEntry->getMTime() != cdsObj->getMTime() || cdsObj->getLocation().string() != dirEntry.path().string();
+            if (autoscanDir && autoscanDir->getForceRescan())
+                isChanged = isChanged || cdsObj->getClass().empty() || cdsObj->getClass() == UPNP_CLASS_ITEM;
+            if (isChanged && isUnchangedFile(cdsObj, dirEntry) && !cdsObj->getClass().empty() && cdsObj->getClass() != UPNP_CLASS_ITEM) {
+                // Moved or renamed file keeps metadata, resources and layout
+                auto item = std::dynamic_pointer_cast<CdsItem>(cdsObj);
+                auto oldLocation = item->getLocation();
+                log_debug("Moving Item {} to {}", oldLocation.string(), itemPath.string());
+                if (item->getTitle() == makeTitle(oldLocation, item->getClass()))
+                    item->setTitle(makeTitle(itemPath, item->getClass()));
+                if (item->getSortKey() == expandNumbersString(oldLocation.filename().stem().string()))
+                    item->setSortKey(expandNumbersString(itemPath.filename().stem().string()));
+                item->setLocation(itemPath, CdsEntryType::File);
+                item->setParentID(parentContainer ? parentContainer->getID() : INVALID_OBJECT_ID);
+                schedule(dirEntry, nullptr, [this, &lastModifiedNewMax, itemPath, stateEntry, contState, item, finishItem] {
+                    database->updateObject(item, nullptr);
+                    if (contState && contState->getMTime() < item->getMTime()) {
+                        contState->setMTime(item->getMTime());
+                        if (lastModifiedNewMax < item->getMTime())
+                            lastModifiedNewMax = item->getMTime();
                     }
-                    item->clearMetaData();
-                    item->clearAuxData();
-                    item->clearResources();
-                    // get ref'd objects with last mod time
-                    auto refDirs = database->getRefObjects(item->getID(), CdsEntryType::ExtraDirectory);
-                    std::unordered_set<int> refObjects;
-                    for (auto refDir : refDirs) {
-                        database->getObjects(refDir, true, refObjects, false, INVALID_OBJECT_ID);
+                    stateEntry->setObject(ImportState::Existing, item);
+                    log_debug("Item moved {} {}", itemPath.string(), item->getID());
+                    finishItem(item);
+                });
+            } else if (isChanged) {
+                // Update changed item in database
+                log_debug("Updating Item {} in database {}", itemPath.string(), cdsObj->getID());
+                auto item = std::dynamic_pointer_cast<CdsItem>(cdsObj);
+                auto probe = std::make_shared<FileProbe>(itemPath);
+                if (item->getMimeType().empty() || item->getClass().empty() || item->getClass() == UPNP_CLASS_ITEM) {
+                    auto [skip, mimetype, upnpClass] = getMimeForFile(itemPath, probe);
+                    if (!mimetype.empty()) {
+                        item->setMimeType(mimetype);
                     }
-                    log_debug("Changing location {} to {}", item->getLocation().string(), itemPath.string());
-                    item->setLocation(itemPath, CdsEntryType::File);
-                    item->setTitle(makeTitle(itemPath, item->getClass()));
-                    auto sortKey = expandNumbersString(itemPath.filename().stem().string());
-                    if (!sortKey.empty()) {
-                        item->setSortKey(sortKey);
+                    if (!upnpClass.empty()) {
+                        item->setClass(upnpClass);
                     }
-                    updateSingleItem(dirEntry, item, item->getMimeType());
-                    if (lastModifiedNewMax < cdsObj->getMTime())
-                        lastModifiedNewMax = cdsObj->getMTime();
+                    log_debug("Updating Item properties {} in database: skip {} mimeType {}, upnpClass {}", skip, itemPath.string(), mimetype, upnpClass);
+                }
+                item->clearMetaData();
+                item->clearAuxData();
+                item->clearResources();
+                // get ref'd objects with last mod time
+                auto refDirs = database->getRefObjects(item->getID(), CdsEntryType::ExtraDirectory);
+                std::unordered_set<int> refObjects;
+                for (auto refDir : refDirs) {
+                    database->getObjects(refDir, true, refObjects, false, INVALID_OBJECT_ID);
+                }
+                log_debug("Changing location {} to {}", item->getLocation().string(), itemPath.string());
+                item->setLocation(itemPath, CdsEntryType::File);
+                item->setTitle(makeTitle(itemPath, item->getClass()));
+                auto sortKey = expandNumbersString(itemPath.filename().stem().string());
+                if (!sortKey.empty()) {
+                    item->setSortKey(sortKey);
+                }
+                schedule(dirEntry, item, [this, &stateCache, &lastModifiedNewMax, &flushNewItems, itemPath, dirEntry, stateEntry, item, refObjects = std::move(refObjects), finishItem] {
+                    // metafiles may refer to new items
+                    flushNewItems();
+                    if (lastModifiedNewMax < item->getMTime())
+                        lastModifiedNewMax = item->getMTime();
                     std::vector<int> newIds;
                     if (metadataService->afterCreation(item, dirEntry, newIds))
                         addExtraObjects(stateCache, newIds);
@@ -728,10 +1033,21 @@ void ImportService::createItems(
                             database->removeObject(origId, "", false);
                         }
                     }
-                    stateEntry->setObject(ImportState::Created, cdsObj);
-                    log_debug("Item changed {} {}", itemPath.string(), cdsObj->getID());
-                } else {
-                    // Store local item with updated status
+                    stateEntry->setObject(ImportState::Created, item);
+                    log_debug("Item changed {} {}", itemPath.string(), item->getID());
+                    finishItem(item);
+                },
+                    probe);
+            } else {
+                // Store local item with updated status
+                // items imported before file ids were stored get them on the next scan
+                auto fileId = cdsObj->getFileId().isValid() || cdsObj->getRefID() > CDS_ID_ROOT ? FileId() : getFileId(itemPath);
+                schedule(dirEntry, nullptr, [this, &lastModifiedNewMax, itemPath, dirEntry, stateEntry, contState, cdsObj, fileId, finishItem] {
+                    if (fileId.isValid()) {
+                        cdsObj->setFileId(fileId);
+                        cdsObj->setSizeOnDisk(getFileSize(dirEntry));
+                        database->updateObject(cdsObj, nullptr);
+                    }
                     if (contState && contState->getMTime() < cdsObj->getMTime()) {
                         contState->setMTime(cdsObj->getMTime());
                         if (lastModifiedNewMax < cdsObj->getMTime())
@@ -739,53 +1055,70 @@ void ImportService::createItems(
                     }
                     stateEntry->setObject(ImportState::Existing, cdsObj);
                     log_debug("Item found {} {}", itemPath.string(), cdsObj->getID());
-                }
-            } else {
-                // Create item from scratch
-                log_debug("Creating Item {}", itemPath.string());
-                auto [skip, newCdsObj] = createSingleItem(dirEntry);
-                if (newCdsObj) {
-                    cdsObj = newCdsObj;
+                    finishItem(cdsObj);
+                });
+            }
+        } else {
+            // Create item from scratch
+            log_debug("Creating Item {}", itemPath.string());
+            auto probe = std::make_shared<FileProbe>(itemPath);
+            auto [skip, item] = prepareSingleItem(dirEntry, probe);
+            if (!item)
+                probedBytes += probe->getBytesRead();
+            schedule(dirEntry, item, [&newItems, &flushNewItems, &lastModifiedNewMax, dirEntry, stateEntry, contState, cdsObj, parentContainer = parentContainer, item = item, skip = skip, finishItem] {
+                if (item) {
                     if (contState) {
-                        contState->setMTime(cdsObj->getMTime());
-                        if (lastModifiedNewMax < cdsObj->getMTime())
-                            lastModifiedNewMax = cdsObj->getMTime();
+                        contState->setMTime(item->getMTime());
+                        if (lastModifiedNewMax < item->getMTime())
+                            lastModifiedNewMax = item->getMTime();
                     }
-                    stateEntry->setObject(ImportState::Created, cdsObj);
-                    cdsObj->setParentID(parentContainer ? parentContainer->getID() : INVALID_OBJECT_ID);
-                    database->addObject(cdsObj, nullptr);
-                    std::vector<int> newIds;
-                    if (metadataService->afterCreation(std::static_pointer_cast<CdsItem>(cdsObj), dirEntry, newIds))
-                        addExtraObjects(stateCache, newIds);
-                    database->updateObject(cdsObj, nullptr);
+                    stateEntry->setObject(ImportState::Created, item);
+                    item->setParentID(parentContainer ? parentContainer->getID() : INVALID_OBJECT_ID);
+                    newItems.emplace_back(item, dirEntry);
+                    if (newItems.size() >= IMPORT_BATCH_SIZE)
+                        flushNewItems();
                 } else {
                     stateEntry->setObject(ImportState::Broken, cdsObj);
-                    cdsObj = nullptr;
                     if (!skip)
                         log_error("Object not created for file {}", dirEntry.path().string());
                 }
-            }
-            if (contState && cdsObj) {
-                contState->increaseItemCounter(cdsObj->getMediaType());
-                contState->setFirstObject(cdsObj);
-            }
-            if (parentContainer) {
-                stateEntry->setParentObject(parentContainer);
-            }
-        } else {
-            log_debug("Not a file {}", itemPath.string());
+                finishItem(item);
+            },
+                probe);
         }
     }
+    finishPending(0);
+    flushNewItems();
     if (autoscanDir && contPath != "") {
         autoscanDir->setCurrentLMT(contPath, lastModifiedNewMax);
     }
     log_debug("end {}", rootPath.string());
 }
 
-std::pair<bool, std::shared_ptr<CdsObject>> ImportService::createSingleItem(const fs::directory_entry& dirEntry) // ToDo: Use StateEntry here
+std::shared_ptr<CdsObject> ImportService::findMovedObject(const fs::directory_entry& dirEntry, bool isDir) const
+{
+    auto fileId = getFileId(dirEntry.path());
+    if (!fileId.isValid())
+        return nullptr;
+
+    for (auto&& obj : database->findObjectsByFileId(fileId, isDir ? DbFileType::Directory : DbFileType::File)) {
+        std::error_code ec;
+        // old location must be gone, otherwise it is a hard link or the inode was reused
+        if (obj->getLocation() == dirEntry.path() || fs::exists(obj->getLocation(), ec))
+            continue;
+        // a directory with a reused inode is newer than the container and must not take over its subtree
+        if (isUnchangedFile(obj, dirEntry)) {
+            log_debug("Found {} moved from {}", dirEntry.path().c_str(), obj->getLocation().c_str());
+            return obj;
+        }
+    }
+    return nullptr;
+}
+
+std::pair<bool, std::shared_ptr<CdsItem>> ImportService::prepareSingleItem(const fs::directory_entry& dirEntry, const std::shared_ptr<FileProbe>& probe) const
 {
     const auto& objectPath = dirEntry.path();
-    auto [skip, mimetype, upnpClass] = getMimeForFile(objectPath);
+    auto [skip, mimetype, upnpClass] = getMimeForFile(objectPath, probe);
     if (mimetype.empty() && upnpClass.empty()) {
         return { skip, nullptr };
     }
@@ -804,7 +1137,14 @@ std::pair<bool, std::shared_ptr<CdsObject>> ImportService::createSingleItem(cons
     if (!sortKey.empty()) {
         item->setSortKey(sortKey);
     }
-    updateSingleItem(dirEntry, item, mimetype);
+    return { skip, item };
+}
+
+std::pair<bool, std::shared_ptr<CdsObject>> ImportService::createSingleItem(const fs::directory_entry& dirEntry) // ToDo: Use StateEntry here
+{
+    auto [skip, item] = prepareSingleItem(dirEntry);
+    if (item)
+        updateSingleItem(dirEntry, item, item->getMimeType());
 
     return { skip, item };
 }
@@ -828,33 +1168,63 @@ std::string ImportService::makeTitle(const fs::path& objectPath, const std::stri
 void ImportService::updateSingleItem(
     const fs::directory_entry& dirEntry,
     const std::shared_ptr<CdsItem>& item,
-    const std::string& mimetype)
+    const std::string& mimetype,
+    const std::shared_ptr<MetadataService>& service,
+    const std::shared_ptr<FileProbe>& probe)
 {
+    // may run in metadata worker
+    std::error_code ec;
     auto mTime = toSeconds(dirEntry.last_write_time(ec));
     item->setMTime(mTime);
     item->setUTime(mTime);
     item->setSizeOnDisk(getFileSize(dirEntry));
+    item->setFileId(getFileId(dirEntry.path()));
 
     try {
         std::vector<int> newIds;
-        metadataService->extractMetaData(item, dirEntry, newIds);
-        metadataService->attachResourceFiles(item, dirEntry, newIds);
+        auto&& handlerService = service ? service : metadataService;
+        handlerService->extractMetaData(item, dirEntry, newIds, probe);
+        handlerService->attachResourceFiles(item, dirEntry, newIds);
         updateItemData(item, mimetype);
     } catch (const std::runtime_error& ex) {
         log_error("updateSingleItem '{}' failed: {}", dirEntry.path().string(), ex.what());
     }
+    if (probe)
+        probedBytes += probe->getBytesRead();
 }
 
 void ImportService::fillLayout(
     const std::shared_ptr<StateCache>& stateCache,
     const std::shared_ptr<GenericTask>& task)
 {
+    auto created = std::count_if(stateCache->contentStateCache.begin(), stateCache->contentStateCache.end(),
+        [](auto&& entry) { return entry.second && entry.second->getState() == ImportState::Created; });
+    // concurrent layouts run on the metadata threads, each one with its own script
+    // imports started by a script callback, e.g. for playlist entries, run on the thread of the script
+    std::unique_ptr<WorkerPool> workerPool;
+    if (metadataThreads > 1 && created > 1 && layoutDepth == 0 && layout && layout->isConcurrent())
+        workerPool = std::make_unique<WorkerPool>("layout", std::min(metadataThreads, layout->getConcurrency()));
+    const std::size_t maxPending = workerPool ? workerPool->getSize() * METADATA_PENDING_PER_WORKER : 0;
+    std::deque<std::future<void>> pending;
+
     for (auto&& [contPath, stateEntry] : stateCache->contentStateCache) {
         if (!stateEntry || stateEntry->getState() != ImportState::Created)
             continue;
         stateCache->contentStateCache.at(contPath)->setObject(ImportState::Loaded, stateEntry->getObject());
-        fillSingleLayout(stateEntry, nullptr, stateEntry->getParentObject(), task);
+        if (workerPool) {
+            pending.push_back(workerPool->submit([this, stateEntry = stateEntry, task](std::size_t) {
+                fillSingleLayout(stateEntry, nullptr, stateEntry->getParentObject(), task);
+            }));
+            while (pending.size() > maxPending) {
+                pending.front().get();
+                pending.pop_front();
+            }
+        } else {
+            fillSingleLayout(stateEntry, nullptr, stateEntry->getParentObject(), task);
+        }
     }
+    for (auto&& layoutJob : pending)
+        layoutJob.get();
 }
 
 /// @param object used to make code compatible with legacy scan
@@ -866,6 +1236,7 @@ void ImportService::fillSingleLayout(
 {
     std::shared_ptr<CdsObject> cdsObject = state ? state->getObject() : std::move(object);
     log_debug("cds {}, layout {}, autoscanDir {}", !!cdsObject, !!layout, !!autoscanDir);
+    LayoutDepth depth;
 
     if (cdsObject && cdsObject->isItem() && layout) {
         try {
@@ -888,8 +1259,10 @@ void ImportService::fillSingleLayout(
                 log_warning("Playlist {} will not be parsed: Gerbera was compiled without JS support!", cdsObject->getLocation().c_str());
 #endif // HAVE_JS
             } else if (!autoscanDir || autoscanDir->hasContent(cdsObject->getClass())) {
-                // only lock mutex while processing item layout
-                LayoutAutoLock lock(layoutMutex);
+                // only lock mutex while processing item layout, concurrent layouts lock their scripts
+                std::unique_lock lock(layoutMutex, std::defer_lock);
+                if (!layout->isConcurrent())
+                    lock.lock();
                 // get ref'd objects with last mod time
                 auto refObjects = state ? database->getRefObjects(cdsObject->getID(), CdsEntryType::VirtualItem) : std::vector<int> {};
                 log_debug("Updating layout {}", cdsObject->getLocation().c_str());
@@ -913,6 +1286,8 @@ void ImportService::parseMetafile(
 {
 #ifdef HAVE_JS
     try {
+        // called by all metadata workers
+        ScriptAutoLock lock(scriptMutex);
         if (metafileParserScript)
             metafileParserScript->processObject(obj, path);
     } catch (const std::runtime_error& e) {
@@ -1117,6 +1492,11 @@ std::shared_ptr<CdsContainer> ImportService::createSingleContainer(
             cVec.push_back(std::make_shared<CdsContainer>(segment.string(), upnpClass, CdsEntryType::Directory));
         }
     }
+    if (!cVec.empty()) {
+        // stored with the insert, so moves of the directory can be detected
+        cVec.back()->setMTime(toSeconds(dirEntry.last_write_time(ec)));
+        cVec.back()->setFileId(getFileId(location));
+    }
     std::vector<int> createdIds;
     addContainerTree(parentContainerId, cVec, nullptr, createdIds);
 
@@ -1130,6 +1510,31 @@ std::shared_ptr<CdsContainer> ImportService::createSingleContainer(
     return {};
 }
 
+std::string ImportService::mapLayoutTree(const std::string& tree)
+{
+    if (layoutMappings.empty())
+        return tree;
+
+    // chain prefixes are shared by most items of a layout
+    {
+        MappedTreesAutoLock lock(mappedTreesMutex);
+        auto entry = mappedTrees.find(tree);
+        if (entry != mappedTrees.end())
+            return entry->second;
+    }
+
+    auto result = tree;
+    for (auto&& [expression, replacement] : layoutMappings) {
+        result = std::regex_replace(result, expression, replacement);
+    }
+
+    MappedTreesAutoLock lock(mappedTreesMutex);
+    if (mappedTrees.size() >= MAPPED_TREES_CACHE_SIZE)
+        mappedTrees.clear();
+    mappedTrees.emplace(tree, result);
+    return result;
+}
+
 /// @param createdIds used by messaging in ContentManager
 std::pair<int, bool> ImportService::addContainerTree(
     int parentContainerId,
@@ -1138,6 +1543,7 @@ std::pair<int, bool> ImportService::addContainerTree(
     std::vector<int>& createdIds)
 {
     log_debug("start '{}' {}", rootPath.string(), parentContainerId);
+    std::scoped_lock lock(containerTreeMutex);
     std::string tree; // accumulate path to container here
     int result = parentContainerId;
     bool isNew = false;
@@ -1153,38 +1559,25 @@ std::pair<int, bool> ImportService::addContainerTree(
         tree = fmt::format("{}{}{}", tree, VIRTUAL_CONTAINER_SEPARATOR, escape(item->getTitle(), VIRTUAL_CONTAINER_ESCAPE, VIRTUAL_CONTAINER_SEPARATOR));
         log_debug("Received container chain item {}", tree);
         if (isVirtual) {
-            for (auto&& [key, val] : configLayoutMapping) {
-                tree = std::regex_replace(tree, std::regex(key), val);
-            }
+            tree = mapLayoutTree(tree);
             auto dirKeyValues = std::vector<std::string>();
-            for (auto&& vdirSetting : virtualDirKeys) {
-                std::string field;
-                std::string upnpClass;
-                for (auto&& [key, vdirField] : vdirSetting) {
-                    if (key == "metadata")
-                        field = vdirField;
-                    if (key == "class")
-                        upnpClass = vdirField;
-                }
-                if (!item->isSubClass(upnpClass))
+            for (auto&& dirKey : virtualDirKeys) {
+                if (!item->isSubClass(dirKey.upnpClass))
                     continue;
-                if (field == "LOCATION") {
+                if (dirKey.metaField.empty()) {
                     std::string location = item->getLocation().c_str();
                     if (!location.empty()) {
                         dirKeyValues.push_back(location);
                         item->setLocation("", item->getEntryType());
                     }
-                } else if (endswith(field, "_1")) {
-                    auto metaField = MetaEnumMapper::remapMetaDataField(field.replace(field.end() - 2, field.end(), ""));
-                    auto keyValue = item->getMetaData(metaField);
+                } else if (dirKey.singleValue) {
+                    auto keyValue = item->getMetaData(dirKey.metaField);
                     if (!keyValue.empty())
                         dirKeyValues.push_back(keyValue);
-                } else if (!field.empty()) {
-                    auto metaField = MetaEnumMapper::remapMetaDataField(field);
-                    auto keyValueGroup = item->getMetaGroup(metaField);
-                    if (!keyValueGroup.empty())
-                        for (auto&& keyValue : keyValueGroup)
-                            dirKeyValues.push_back(keyValue);
+                } else {
+                    auto keyValueGroup = item->getMetaGroup(dirKey.metaField);
+                    for (auto&& keyValue : keyValueGroup)
+                        dirKeyValues.push_back(keyValue);
                 }
             }
             if (!dirKeyValues.empty()) {
@@ -27,10 +27,14 @@
 #define __IMPORT_SERVICE_H__
 
 #include "util/grb_fs.h"
+#include "util/mime.h"
 
+#include <atomic>
 #include <map>
 #include <mutex>
+#include <regex>
 #include <tuple>
+#include <unordered_map>
 #include <unordered_set>
 
 // forward declarations
@@ -45,12 +49,12 @@ class ContentManager;
 class Context;
 class ConverterManager;
 class Database;
+class FileProbe;
 class GenericTask;
 class ImportService;
 class Layout;
 enum class LayoutType;
 class MetadataService;
-class Mime;
 enum class ObjectType;
 class UpnpMap;
 
@@ -84,14 +88,14 @@ private:
     std::shared_ptr<CdsObject> cdsObject;
     /// @brief CdsObject associated with the container (if cdsObject is a container)
     std::shared_ptr<CdsObject> firstObject;
-    /// @brief counters of child object types for container type
-    std::map<ObjectType, std::size_t> itemCounter;
+    /// @brief counters of child object types for container type, only changed by the import task
+    std::uint32_t audioCount {};
+    std::uint32_t imageCount {};
+    std::uint32_t videoCount {};
 
     /// @brief parent container (if cdsObject is a item)
     std::shared_ptr<CdsContainer> parentObject;
 
-    mutable std::mutex counterMutex;
-
 public:
     ContentState(fs::directory_entry dirEntry,
         ImportState state,
@@ -123,11 +127,7 @@ public:
 
     ImportState getState() const { return state; }
     void setState(ImportState newState) { state = newState; }
-    void increaseItemCounter(ObjectType mt)
-    {
-        std::lock_guard<std::mutex> lock(counterMutex);
-        itemCounter[mt]++;
-    }
+    void increaseItemCounter(ObjectType mt);
     AutoscanMediaMode getMediaMode() const;
 };
 
@@ -146,8 +146,26 @@ public:
         ImportState state,
         std::chrono::seconds mtime = std::chrono::seconds::zero(),
         const std::shared_ptr<CdsObject>& cdsObject = nullptr);
+    /// @brief store new entries of one directory with their modification time
+    void cacheStates(const std::vector<std::pair<fs::directory_entry, std::chrono::seconds>>& entries);
     /// @brief get object if stored in cache map
     std::shared_ptr<CdsObject> getObject(const fs::path& location) const;
+    /// @brief get number of entries found by the scan, also after compact
+    std::size_t getEntryCount() const;
+    /// @brief drop all entries not required to check for the file name and release objects of the scan
+    void compact(const std::string& fileName);
+
+private:
+    /// @brief number of entries before compact
+    std::size_t compactedCount {};
+
+    /// @brief store entry in cache map, cacheMutex must be locked
+    void storeState(
+        const fs::path& entryPath,
+        const fs::directory_entry& dirEntry,
+        ImportState state,
+        std::chrono::seconds mtime,
+        const std::shared_ptr<CdsObject>& cdsObject);
 };
 
 /// @brief Container for cached cdsContainers
@@ -180,6 +198,15 @@ public:
     void clear();
 };
 
+/// @brief Metadata of a virtual container that is added to its path to distinguish containers with the same title
+struct VirtualDirKey {
+    std::string upnpClass;
+    /// @brief name of metadata field, empty for location
+    std::string metaField;
+    /// @brief use first value only instead of all values of the field
+    bool singleValue { false };
+};
+
 /// @brief Mapping logic to generate upnpClass from file (meta) data
 class UpnpMap {
 private:
@@ -212,11 +239,18 @@ private:
     std::shared_ptr<Database> database;
     std::shared_ptr<ContentManager> content;
     std::shared_ptr<MetadataService> metadataService;
+    /// @brief handler instances of each metadata worker
+    std::vector<std::shared_ptr<MetadataService>> metadataServices;
     std::shared_ptr<ConverterManager> converterManager;
 
     std::map<std::string, std::string> mimetypeContenttypeMap;
     std::map<std::string, std::string> mimetypeUpnpclassMap;
-    std::map<std::string, std::string> configLayoutMapping;
+    /// @brief compiled expressions of layout mapping with their replacement
+    std::vector<std::pair<std::regex, std::string>> layoutMappings;
+    /// @brief container chain paths with layout mapping applied
+    std::unordered_map<std::string, std::string> mappedTrees;
+    std::mutex mappedTreesMutex;
+    using MappedTreesAutoLock = std::scoped_lock<decltype(mappedTreesMutex)>;
     std::vector<UpnpMap> upnpMap;
 
     fs::path rootPath;
@@ -233,17 +267,27 @@ private:
     bool pcDirTypes { true };
     int containerImageParentCount { 2 };
     int containerImageMinDepth { 2 };
+    std::size_t metadataThreads { 1 };
+    std::size_t scanThreads { 1 };
+    /// @brief bytes read from files to detect their type in the current scan
+    std::atomic_size_t probedBytes {};
+    /// @brief mimetype detection of the current scan, counted by the const item preparation
+    mutable MimeLookups mimeLookups;
 
-    std::vector<std::vector<std::pair<std::string, std::string>>> virtualDirKeys;
+    std::vector<VirtualDirKey> virtualDirKeys;
 
     mutable std::mutex layoutMutex;
     using LayoutAutoLock = std::scoped_lock<decltype(layoutMutex)>;
     mutable std::shared_ptr<Layout> layout;
+    /// @brief layout scripts running in parallel must not create the same container twice
+    std::recursive_mutex containerTreeMutex;
 
 #ifdef HAVE_JS
     std::shared_ptr<PlaylistParserScript> playlistParserScript;
     std::shared_ptr<MetafileParserScript> metafileParserScript;
     std::shared_ptr<CuesheetParserScript> cuesheetParserScript;
+    mutable std::mutex scriptMutex;
+    using ScriptAutoLock = std::scoped_lock<decltype(scriptMutex)>;
 #endif
 
     std::error_code ec;
@@ -256,13 +300,21 @@ private:
 
     /// @brief read files from one folder depnending on settings
     void readDir(const std::shared_ptr<StateCache>& stateCache, const fs::path& location, AutoScanSetting settings);
+    /// @brief read entries of a single folder and merge its settings
+    /// @return subfolders to read
+    std::vector<fs::path> readDirEntries(const std::shared_ptr<StateCache>& stateCache, const fs::path& location, AutoScanSetting& settings);
     /// @brief read single file (triggered by autoscan)
     void readFile(const std::shared_ptr<StateCache>& stateCache, const fs::path& location);
     /// @brief create containers for all discovered folders
     void createContainers(const std::shared_ptr<StateCache>& stateCache, int parentContainerId, AutoScanSetting& settings);
     /// @brief create items for all discovered files
     void createItems(const std::shared_ptr<StateCache>& stateCache, AutoScanSetting& settings);
-    void updateSingleItem(const fs::directory_entry& dirEntry, const std::shared_ptr<CdsItem>& item, const std::string& mimetype);
+    /// @brief find object of a file or folder that was moved away from a location that no longer exists
+    std::shared_ptr<CdsObject> findMovedObject(const fs::directory_entry& dirEntry, bool isDir) const;
+    /// @brief create item with properties derived from file name, metadata is not read yet
+    std::pair<bool, std::shared_ptr<CdsItem>> prepareSingleItem(const fs::directory_entry& dirEntry, const std::shared_ptr<FileProbe>& probe = {}) const;
+    /// @brief read metadata of file into item with service or the default metadata service
+    void updateSingleItem(const fs::directory_entry& dirEntry, const std::shared_ptr<CdsItem>& item, const std::string& mimetype, const std::shared_ptr<MetadataService>& service = {}, const std::shared_ptr<FileProbe>& probe = {});
     void fillLayout(const std::shared_ptr<StateCache>& stateCache, const std::shared_ptr<GenericTask>& task);
     void updateFanArt(const std::shared_ptr<StateCache>& stateCache, bool isDir);
     /// @brief try to assign fanart to container
@@ -284,7 +336,7 @@ private:
     /// @brief Extract mime type and corresponding upnp class from file
     /// @param objectPath location of the file on the disk
     /// @return pair containing mimetype and upnpclass
-    std::tuple<bool, std::string, std::string> getMimeForFile(const fs::path& objectPath) const;
+    std::tuple<bool, std::string, std::string> getMimeForFile(const fs::path& objectPath, const std::shared_ptr<FileProbe>& probe = {}) const;
     void addExtraObjects(
         const std::shared_ptr<StateCache>& stateCache,
         const std::vector<int>& newIds);
@@ -344,6 +396,8 @@ public:
     /// @brief update properties of object
     void updateItemData(const std::shared_ptr<CdsItem>& item, const std::string& mimetype);
 
+    /// @brief Apply layout mapping to container chain path
+    std::string mapLayoutTree(const std::string& tree);
     /// @brief Adds a virtual container chain specified by path.
     /// @param parentContainerId id of the root container
     /// @param chain list of container objects to create
@@ -36,6 +36,7 @@
 #ifdef HAVE_INOTIFY
 #include "autoscan_inotify.h" // API
 
+#include "cds/cds_objects.h"
 #include "config/config_option_enum.h"
 #include "config/config_val.h"
 #include "config/result/autoscan.h"
@@ -48,6 +49,16 @@
 #include "context.h"
 #include "database/database.h"
 
+#include <algorithm>
+#include <sys/inotify.h>
+
+#define INOTIFY_BUFFERED_EVENTS (IN_CREATE | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM)
+#define INOTIFY_REMOVE_EVENTS (IN_DELETE | IN_MOVED_FROM)
+#define INOTIFY_COMPLETE_EVENTS (IN_CLOSE_WRITE | IN_MOVED_TO | IN_ATTRIB) // file can be imported
+#define INOTIFY_DIRECTORY_BATCH 4 // complete files in one directory that are imported with the directory
+#define INOTIFY_MAX_DELAY_FACTOR 10 // events of a directory written continuously are handled after this multiple of the delay
+#define INOTIFY_MOVE_DELAY 1000 // minimum time in ms to wait for the target of a move
+
 template void InotifyManager<DirectoryWatch>::run();
 
 AutoscanInotify::AutoscanInotify(const std::shared_ptr<Content>& content)
@@ -60,6 +71,7 @@ AutoscanInotify::AutoscanInotify(const std::shared_ptr<Content>& content)
 
     if (this->config->getBoolOption(ConfigVal::IMPORT_AUTOSCAN_INOTIFY_ATTRIB))
         events |= IN_ATTRIB;
+    eventDelay = std::chrono::milliseconds(this->config->getUIntOption(ConfigVal::IMPORT_AUTOSCAN_INOTIFY_DELAY));
 }
 
 void AutoscanInotify::threadProc()
@@ -141,54 +153,215 @@ void AutoscanInotify::threadProc()
 
             lock.unlock();
 
-            /* --- get event --- (blocking) */
-            inotify_event* event = inotify->nextEvent();
+            /* --- get event --- (blocking until pending events are due) */
+            inotify_event* event = inotify->nextEvent(getPendingTimeout());
             /* --- */
 
             if (event && (event->mask & events)) {
-                auto handler = InotifyHandler(this, event, event->mask & events);
-                auto wdObj = getWatch(handler);
-
-                if (!wdObj)
-                    continue;
-
-                fs::path path = handler.getPath(wdObj);
-                auto [isDir, adir] = handler.getAutoscanDirectory(wdObj);
-
-                handler.doMove(wdObj);
-
-                AutoScanSetting asSetting;
-                asSetting.adir = adir;
-                asSetting.followSymlinks = adir ? adir->getFollowSymlinks() : defFollowSymlinks;
-                asSetting.recursive = adir ? adir->getRecursive() : false;
-                asSetting.hidden = adir ? adir->getHidden() : defHidden;
-                asSetting.rescanResource = true;
-                asSetting.async = false;
-                asSetting.resourcePatterns.clear();
-                asSetting.mergeOptions(config, path);
-
-                // changed
-                if (adir && handler.hasEvent()) {
-                    // not new
-                    int wd = handler.doExistingEntry(database, content, wdObj, importMode, isDir);
-                    if (wd > INOTIFY_ROOT)
-                        inotify->removeWatch(wd);
-                    // new file
-                    handler.doNewEntry(asSetting, content, isDir);
-                }
-                // target is directory
-                if (isDir) {
-                    handler.doDirectory(asSetting, content, wdObj);
+                InotifyFlags mask = event->mask & events;
+                std::string name = event->len > 0 ? event->name : "";
+                // events of files are collected until their directory is quiet
+                if (eventDelay.count() > 0 && !name.empty() && !(event->mask & IN_ISDIR) && !(mask & ~INOTIFY_BUFFERED_EVENTS)) {
+                    bufferEvent(event->wd, mask, name);
+                } else {
+                    handlePendingEvents(importMode, true);
+                    handleEvent(event->wd, mask, name, importMode);
                 }
-                handler.doIgnored();
-                log_debug("end event {}", event->wd);
             }
+            handlePendingEvents(importMode, false);
+            handleMovedObjects(false);
         } catch (const std::runtime_error& e) {
             log_error("Inotify thread caught exception: {}", e.what());
         }
     }
 }
 
+AutoScanSetting AutoscanInotify::getSetting(const std::shared_ptr<AutoscanDirectory>& adir, const fs::path& path) const
+{
+    AutoScanSetting asSetting;
+    asSetting.adir = adir;
+    asSetting.followSymlinks = adir ? adir->getFollowSymlinks() : defFollowSymlinks;
+    asSetting.recursive = adir ? adir->getRecursive() : false;
+    asSetting.hidden = adir ? adir->getHidden() : defHidden;
+    asSetting.rescanResource = true;
+    asSetting.async = false;
+    asSetting.resourcePatterns.clear();
+    asSetting.mergeOptions(config, path);
+    return asSetting;
+}
+
+void AutoscanInotify::handleEvent(int wd, InotifyFlags mask, const std::string& name, ImportMode importMode)
+{
+    auto handler = InotifyHandler(this, wd, mask, name);
+    auto wdObj = getWatch(handler);
+
+    if (!wdObj)
+        return;
+
+    fs::path path = handler.getPath(wdObj);
+    auto [isDir, adir] = handler.getAutoscanDirectory(wdObj);
+
+    handler.doMove(wdObj);
+
+    auto asSetting = getSetting(adir, path);
+
+    // changed
+    if (adir && handler.hasEvent()) {
+        // not new
+        int removeWd = handler.doExistingEntry(database, content, wdObj, importMode, isDir);
+        if (removeWd > INOTIFY_ROOT)
+            inotify->removeWatch(removeWd);
+        // new file
+        handler.doNewEntry(asSetting, content, isDir);
+    }
+    // target is directory
+    if (isDir) {
+        handler.doDirectory(asSetting, content, wdObj);
+    }
+    handler.doIgnored();
+    log_debug("end event {}", wd);
+}
+
+void AutoscanInotify::bufferEvent(int wd, InotifyFlags mask, const std::string& name)
+{
+    auto now = std::chrono::steady_clock::now();
+    auto [entry, added] = pendingEvents.try_emplace(wd);
+    auto&& pending = entry->second;
+    if (added)
+        pending.first = now;
+    pending.last = now;
+
+    auto&& fileMask = pending.files[name];
+    // a removal replaces all previous changes, the file is checked in the database
+    if (mask & INOTIFY_REMOVE_EVENTS)
+        fileMask = mask;
+    else
+        fileMask |= mask;
+    log_debug("inotify event buffered: {} mask={} name={}", wd, InotifyUtil::mapFlags(fileMask), name);
+}
+
+int AutoscanInotify::getPendingTimeout() const
+{
+    if (pendingEvents.empty() && movedObjects.empty())
+        return -1;
+
+    auto now = std::chrono::steady_clock::now();
+    auto due = std::chrono::steady_clock::time_point::max();
+    for (auto&& [wd, pending] : pendingEvents) {
+        due = std::min({ due, pending.last + eventDelay, pending.first + eventDelay * INOTIFY_MAX_DELAY_FACTOR });
+    }
+    for (auto&& [path, moved] : movedObjects) {
+        due = std::min(due, moved.due);
+    }
+    return due <= now ? 0 : static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(due - now).count());
+}
+
+void AutoscanInotify::handlePendingEvents(ImportMode importMode, bool all)
+{
+    auto now = std::chrono::steady_clock::now();
+    for (auto it = pendingEvents.begin(); it != pendingEvents.end();) {
+        if (!all && now < it->second.last + eventDelay && now < it->second.first + eventDelay * INOTIFY_MAX_DELAY_FACTOR) {
+            ++it;
+            continue;
+        }
+        auto wd = it->first;
+        auto files = std::move(it->second.files);
+        it = pendingEvents.erase(it);
+
+        // removals first, so a file moved inside the directory is not found twice
+        std::vector<std::pair<std::string, InotifyFlags>> newFiles;
+        std::vector<std::pair<std::string, InotifyFlags>> otherFiles;
+        for (auto&& [name, mask] : files) {
+            if (mask & INOTIFY_REMOVE_EVENTS)
+                handleEvent(wd, mask, name, importMode);
+            else if (mask & INOTIFY_COMPLETE_EVENTS)
+                newFiles.emplace_back(name, mask);
+            else
+                otherFiles.emplace_back(name, mask); // e.g. created, but still being written
+        }
+        for (auto&& [name, mask] : otherFiles)
+            handleEvent(wd, mask, name, importMode);
+
+        auto wdObj = watches.find(wd) != watches.end() ? watches.at(wd) : nullptr;
+        auto watchAs = wdObj ? wdObj->getAppropriateAutoscan(wdObj->getPath()) : nullptr;
+        auto adir = watchAs ? watchAs->getAutoscanDirectory() : nullptr;
+        if (newFiles.size() >= INOTIFY_DIRECTORY_BATCH && adir && importMode == ImportMode::Gerbera) {
+            // one import of the directory instead of one task per file
+            std::error_code ec;
+            auto dirEnt = fs::directory_entry(wdObj->getPath(), ec);
+            if (!ec) {
+                log_debug("Importing {} changed files of {}", newFiles.size(), dirEnt.path().c_str());
+                auto asSetting = getSetting(adir, dirEnt.path());
+                asSetting.recursive = false;
+                content->addFile(dirEnt, adir->getLocation(), asSetting, true, false);
+                continue;
+            }
+            log_error("Failed to read {}: {}", wdObj->getPath().c_str(), ec.message());
+        }
+        for (auto&& [name, mask] : newFiles)
+            handleEvent(wd, mask, name, importMode);
+    }
+}
+
+void AutoscanInotify::deferRemoval(
+    const fs::path& path,
+    const std::shared_ptr<AutoscanDirectory>& adir,
+    int objectId,
+    const FileId& fileId)
+{
+    // target of the move is imported when the events of its directory are handled
+    log_debug("Waiting for target of moved {}", path.c_str());
+    movedObjects.insert_or_assign(path, MovedObject { adir, objectId, fileId, std::chrono::steady_clock::now() + getMoveDelay() });
+}
+
+std::chrono::milliseconds AutoscanInotify::getMoveDelay() const
+{
+    return std::max(eventDelay * (INOTIFY_MAX_DELAY_FACTOR + 1), std::chrono::milliseconds(INOTIFY_MOVE_DELAY));
+}
+
+bool AutoscanInotify::isMoveTargetPending(const FileId& fileId) const
+{
+    for (auto&& [wd, pending] : pendingEvents) {
+        auto wdObj = watches.find(wd);
+        if (wdObj == watches.end())
+            continue;
+        for (auto&& [name, mask] : pending.files) {
+            if ((mask & IN_MOVED_TO) && getFileId(wdObj->second->getPath() / name) == fileId)
+                return true;
+        }
+    }
+    return content->isImportPending(fileId);
+}
+
+void AutoscanInotify::handleMovedObjects(bool all)
+{
+    auto now = std::chrono::steady_clock::now();
+    for (auto it = movedObjects.begin(); it != movedObjects.end();) {
+        if (!all && now < it->second.due) {
+            ++it;
+            continue;
+        }
+        if (!all && isMoveTargetPending(it->second.fileId)) {
+            // wait until the import of the target has finished
+            log_debug("Import pending for target of moved {}", it->first.c_str());
+            it->second.due = now + getMoveDelay();
+            ++it;
+            continue;
+        }
+        auto path = it->first;
+        auto moved = std::move(it->second);
+        it = movedObjects.erase(it);
+
+        // object was not found at another location by the import
+        std::error_code ec;
+        auto obj = database->findObjectByPath(path, UNUSED_CLIENT_GROUP, DbFileType::Any);
+        if (obj && obj->getID() == moved.objectId && !fs::exists(path, ec)) {
+            log_debug("Removing moved {}", path.c_str());
+            content->removeObject(moved.adir, obj, path, true, false);
+        }
+    }
+}
+
 std::shared_ptr<DirectoryWatch> AutoscanInotify::getWatch(const InotifyHandler& handler)
 {
     std::shared_ptr<DirectoryWatch> wdObj;
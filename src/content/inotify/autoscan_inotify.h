@@ -37,10 +37,13 @@
 #include "inotify_manager.h"
 #include "util/grb_fs.h"
 
+#include <chrono>
+#include <map>
 #include <queue>
 
 // forward declarations
 class AutoscanDirectory;
+class AutoScanSetting;
 class Config;
 class Content;
 class Database;
@@ -48,6 +51,7 @@ class InotifyHandler;
 class Watch;
 class DirectoryWatch;
 class WatchAutoscan;
+enum class ImportMode;
 
 /// @brief Manager class for autoscan directories with inotify
 class AutoscanInotify : public InotifyManager<DirectoryWatch> {
@@ -92,6 +96,13 @@ public:
     /// @brief Remove watches recursively under some start point
     void removeDescendants(int wd);
 
+    /// @brief Keep object of an entry that was moved away, it is removed if the entry is not imported at its new location in time
+    void deferRemoval(
+        const fs::path& path,
+        const std::shared_ptr<AutoscanDirectory>& adir,
+        int objectId,
+        const FileId& fileId);
+
 private:
     std::shared_ptr<Config> config;
     std::shared_ptr<Database> database;
@@ -112,6 +123,46 @@ private:
     /// @brief default setting for hidden files/folders
     bool defHidden;
 
+    /// @brief quiet time of a directory before its file events are handled
+    std::chrono::milliseconds eventDelay;
+
+    /// @brief file events of a directory waiting for the quiet time
+    struct PendingEvents {
+        std::chrono::steady_clock::time_point first;
+        std::chrono::steady_clock::time_point last;
+        /// @brief merged event mask by file name
+        std::map<std::string, InotifyFlags> files;
+    };
+    /// @brief pending file events by watch descriptor
+    std::map<int, PendingEvents> pendingEvents;
+
+    /// @brief object of an entry that was moved away
+    struct MovedObject {
+        std::shared_ptr<AutoscanDirectory> adir;
+        int objectId;
+        FileId fileId;
+        std::chrono::steady_clock::time_point due;
+    };
+    /// @brief moved objects by old location
+    std::map<fs::path, MovedObject> movedObjects;
+
+    /// @brief handle single event
+    void handleEvent(int wd, InotifyFlags mask, const std::string& name, ImportMode importMode);
+    /// @brief add file event to pending events of its directory
+    void bufferEvent(int wd, InotifyFlags mask, const std::string& name);
+    /// @brief handle pending events of directories that are quiet, or of all directories
+    void handlePendingEvents(ImportMode importMode, bool all);
+    /// @brief remove objects of moved entries that were not imported at their new location
+    void handleMovedObjects(bool all);
+    /// @brief check if buffered events or pending imports can still add the target of a move
+    bool isMoveTargetPending(const FileId& fileId) const;
+    /// @brief time to wait for the target of a move, longer than events of a directory are buffered
+    std::chrono::milliseconds getMoveDelay() const;
+    /// @brief get time until the next pending events are due in milliseconds, -1 if there are none
+    int getPendingTimeout() const;
+    /// @brief create import settings for path from autoscan directory
+    AutoScanSetting getSetting(const std::shared_ptr<AutoscanDirectory>& adir, const fs::path& path) const;
+
     /// @brief Update monitoring of a directory
     int monitorDirectory(
         const fs::path& path,
@@ -50,18 +50,24 @@
 #define AUTOSCAN_IS_DIR(mask) ((mask) & (IN_ISDIR))
 #define AUTOSCAN_IS_NEW_ENTRY(mask, noFile) ((mask) & (IN_CLOSE_WRITE | IN_MOVED_TO | IN_ATTRIB) || ((noFile) && ((mask) & IN_CREATE)))
 #define AUTOSCAN_IS_MOVED(mask) ((mask) & (IN_MOVED_TO))
+#define AUTOSCAN_IS_MOVED_AWAY(mask) ((mask) & (IN_MOVED_FROM))
 #define AUTOSCAN_IS_NEW(mask) ((mask) & (IN_CREATE | IN_MOVED_TO | IN_ATTRIB))
 #define AUTOSCAN_IS_CREATED(mask) ((mask) & (IN_CREATE | IN_ATTRIB))
 #define AUTOSCAN_IS_WRITTEN(mask) ((mask) & (IN_CLOSE_WRITE | IN_MOVE_SELF | IN_ATTRIB))
 #define AUTOSCAN_IS_IGNORED(mask) ((mask) & (IN_IGNORED))
 
 InotifyHandler::InotifyHandler(AutoscanInotify* ai, struct inotify_event* event, InotifyFlags maskedEvent)
+    : InotifyHandler(ai, event->wd, maskedEvent, event->len > 0 ? event->name : "") // The name field is only present when an event is returned for a file inside a watched directory
+{
+}
+
+InotifyHandler::InotifyHandler(AutoscanInotify* ai, int wd, InotifyFlags maskedEvent, std::string name)
     : ai(ai)
-    , wd(event->wd)
+    , wd(wd)
     , mask(maskedEvent)
-    , name(event->len > 0 ? event->name : "") // The name field is only present when an event is returned for a file inside a watched directory
+    , name(std::move(name))
 {
-    log_debug("inotify event: {} mask={} name={}", wd, InotifyUtil::mapFlags(mask), name);
+    log_debug("inotify event: {} mask={} name={}", wd, InotifyUtil::mapFlags(mask), this->name);
 }
 
 fs::path InotifyHandler::getPath(const std::shared_ptr<DirectoryWatch>& wdObj)
@@ -158,8 +164,13 @@ int InotifyHandler::doExistingEntry(
         if (changedObject)
             isDir = changedObject->isContainer();
         if ((!AUTOSCAN_IS_WRITTEN(mask) || importMode != ImportMode::Gerbera) && changedObject) {
-            log_debug("deleting {}", path.c_str());
-            content->removeObject(adir, changedObject, path, !AUTOSCAN_IS_MOVED(mask), false);
+            if (AUTOSCAN_IS_MOVED_AWAY(mask) && importMode == ImportMode::Gerbera && changedObject->getFileId().isValid()) {
+                // import of the target finds the object by its file id and updates it in place
+                ai->deferRemoval(path, adir, changedObject->getID(), changedObject->getFileId());
+            } else {
+                log_debug("deleting {}", path.c_str());
+                content->removeObject(adir, changedObject, path, !AUTOSCAN_IS_MOVED(mask), false);
+            }
             changedObject = nullptr;
         }
     }
@@ -44,6 +44,7 @@ enum class ImportMode;
 class InotifyHandler {
 public:
     InotifyHandler(AutoscanInotify* ai, struct inotify_event* event, InotifyFlags maskedEvent);
+    InotifyHandler(AutoscanInotify* ai, int wd, InotifyFlags maskedEvent, std::string name);
 
     /// @brief Get File Path for new event
     fs::path getPath(const std::shared_ptr<DirectoryWatch>& wdObj);
@@ -133,7 +133,7 @@ void Inotify::removeWatch(int wd) const
     }
 }
 
-struct inotify_event* Inotify::nextEvent()
+struct inotify_event* Inotify::nextEvent(int timeout)
 {
     static std::array<inotify_event, MAX_EVENTS> event;
     static struct inotify_event* ret = nullptr;
@@ -162,7 +162,7 @@ struct inotify_event* Inotify::nextEvent()
             // how much of the event do we have?
             bytes = reinterpret_cast<char*>(event.data()) + bytes - reinterpret_cast<char*>(ret);
             std::memcpy(event.data(), ret, bytes);
-            return nextEvent();
+            return nextEvent(timeout);
         }
         return ret;
     }
@@ -185,7 +185,12 @@ struct inotify_event* Inotify::nextEvent()
 
     fdMax = std::max(stop_fd_read, fdMax);
 
-    rc = select(fdMax + 1, &readFds, nullptr, nullptr, nullptr);
+    struct timeval timeoutVal {};
+    if (timeout >= 0) {
+        timeoutVal.tv_sec = timeout / 1000;
+        timeoutVal.tv_usec = (timeout % 1000) * 1000;
+    }
+    rc = select(fdMax + 1, &readFds, nullptr, nullptr, timeout >= 0 ? &timeoutVal : nullptr);
     if (rc < 0) {
         return nullptr;
     }
@@ -64,7 +64,8 @@ public:
     /// This function will return the next inotify event that occurs, in case
     /// that there are no events the function will block indefinetely. It can
     /// be unblocked by the stop function.
-    struct inotify_event* nextEvent();
+    /// @param timeout maximum time to wait in milliseconds, negative to wait until an event or stop
+    struct inotify_event* nextEvent(int timeout = -1);
 
     /// @brief Unblock the next_event function.
     void stop() const;
@@ -35,13 +35,63 @@
 #ifdef HAVE_JS
 #include "js_layout.h" // API
 
+#include "content/content.h"
 #include "content/scripting/import_script.h"
+#include "content/scripting/scripting_runtime.h"
+#include "util/logger.h"
 
 JSLayout::JSLayout(const std::shared_ptr<Content>& content, const std::string& parent)
     : Layout(content)
-    , import_script(std::make_shared<ImportScript>(content, parent))
+    , runtime(content->getScriptingRuntime())
+    , scriptParent(parent)
+    , firstHeap(runtime->getFirstLayoutHeap())
+    , maxScripts(runtime->getLayoutHeapCount())
 {
-    import_script->init();
+    // first script is created immediately to report script errors on startup
+    auto script = std::make_shared<ImportScript>(content, parent, firstHeap);
+    script->init();
+    idleScripts.push_back(std::move(script));
+    scriptCount = 1;
+}
+
+std::vector<int> JSLayout::callScript(const std::function<std::vector<int>(ImportScript&)>& function)
+{
+    std::shared_ptr<ImportScript> script;
+    std::size_t heap = 0;
+    {
+        std::unique_lock lock(mutex);
+        cond.wait(lock, [this] { return !idleScripts.empty() || scriptCount < maxScripts; });
+        if (!idleScripts.empty()) {
+            script = std::move(idleScripts.back());
+            idleScripts.pop_back();
+        } else {
+            heap = firstHeap + scriptCount++;
+        }
+    }
+    try {
+        if (!script) {
+            log_debug("Creating import script {} for {}", heap, scriptParent);
+            script = std::make_shared<ImportScript>(content, scriptParent, heap);
+            script->init();
+        }
+        auto result = function(*script);
+        {
+            std::scoped_lock lock(mutex);
+            idleScripts.push_back(std::move(script));
+        }
+        cond.notify_one();
+        return result;
+    } catch (const std::runtime_error&) {
+        {
+            std::scoped_lock lock(mutex);
+            if (script)
+                idleScripts.push_back(std::move(script));
+            else
+                scriptCount--;
+        }
+        cond.notify_one();
+        throw;
+    }
 }
 
 std::vector<int> JSLayout::addAudio(
@@ -50,10 +100,7 @@ std::vector<int> JSLayout::addAudio(
     const fs::path& rootpath,
     const std::map<AutoscanMediaMode, std::string>& containerMap)
 {
-    if (!import_script)
-        return {};
-
-    return import_script->addAudio(obj, parent, rootpath, containerMap);
+    return callScript([&](ImportScript& script) { return script.addAudio(obj, parent, rootpath, containerMap); });
 }
 
 std::vector<int> JSLayout::addVideo(
@@ -62,10 +109,7 @@ std::vector<int> JSLayout::addVideo(
     const fs::path& rootpath,
     const std::map<AutoscanMediaMode, std::string>& containerMap)
 {
-    if (!import_script)
-        return {};
-
-    return import_script->addVideo(obj, parent, rootpath, containerMap);
+    return callScript([&](ImportScript& script) { return script.addVideo(obj, parent, rootpath, containerMap); });
 }
 
 std::vector<int> JSLayout::addImage(
@@ -74,10 +118,7 @@ std::vector<int> JSLayout::addImage(
     const fs::path& rootpath,
     const std::map<AutoscanMediaMode, std::string>& containerMap)
 {
-    if (!import_script)
-        return {};
-
-    return import_script->addImage(obj, parent, rootpath, containerMap);
+    return callScript([&](ImportScript& script) { return script.addImage(obj, parent, rootpath, containerMap); });
 }
 
 #ifdef ONLINE_SERVICES
@@ -87,10 +128,7 @@ std::vector<int> JSLayout::addOnlineItem(
     const fs::path& rootpath,
     const std::map<AutoscanMediaMode, std::string>& containerMap)
 {
-    if (!import_script)
-        return {};
-
-    return import_script->addOnlineItem(obj, rootpath, containerMap);
+    return callScript([&](ImportScript& script) { return script.addOnlineItem(obj, rootpath, containerMap); });
 }
 #endif
 #endif // HAVE_JS
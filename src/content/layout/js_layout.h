@@ -36,19 +36,39 @@
 
 #include "layout.h"
 
+#include <condition_variable>
+#include <functional>
 #include <memory>
+#include <mutex>
 
 class ImportScript;
 class ScriptingRuntime;
 
 /// @brief layout class implementation for flexible java script implemented virtual layout
+///
+/// The layout keeps one import script per layout heap of the scripting runtime.
+/// Additional scripts are created when all existing ones are busy.
 class JSLayout : public Layout {
 public:
     JSLayout(const std::shared_ptr<Content>& content, const std::string& parent);
 
+    std::size_t getConcurrency() const override { return maxScripts; }
+
 protected:
     std::shared_ptr<ScriptingRuntime> runtime;
-    std::shared_ptr<ImportScript> import_script;
+    /// @brief name of the autoscan directory for script context names
+    std::string scriptParent;
+
+    std::size_t firstHeap;
+    std::size_t maxScripts;
+    std::size_t scriptCount { 0 };
+    /// @brief scripts not running a layout function
+    std::vector<std::shared_ptr<ImportScript>> idleScripts;
+    std::mutex mutex;
+    std::condition_variable cond;
+
+    /// @brief run layout function on an idle script
+    std::vector<int> callScript(const std::function<std::vector<int>(ImportScript&)>& function);
 
     std::vector<int> addVideo(
         const std::shared_ptr<CdsObject>& obj,
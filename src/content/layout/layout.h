@@ -68,6 +68,11 @@ public:
         const std::map<AutoscanMediaMode, std::string>& containerMap,
         std::vector<int>& refObjects);
 
+    /// @brief number of objects the layout can process at the same time
+    virtual std::size_t getConcurrency() const { return 1; }
+    /// @brief layout can process several objects at the same time
+    bool isConcurrent() const { return getConcurrency() > 1; }
+
 protected:
     /// @brief create virtual video layout
     virtual std::vector<int> addVideo(
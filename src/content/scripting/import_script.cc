@@ -40,11 +40,12 @@
 #include "config/result/autoscan.h"
 #include "content/content.h"
 #include "context.h"
+#include "scripting_runtime.h"
 #include "util/string_converter.h"
 #include "util/tools.h"
 
-ImportScript::ImportScript(const std::shared_ptr<Content>& content, const std::string& parent)
-    : Script(content, parent, "import", "orig", true, content->getContext()->getConverterManager()->i2i())
+ImportScript::ImportScript(const std::shared_ptr<Content>& content, const std::string& parent, std::size_t heap)
+    : Script(content, parent, "import", "orig", true, content->getContext()->getConverterManager()->i2i(), heap)
 {
 }
 
@@ -57,6 +58,7 @@ std::vector<int> ImportScript::callFunction(
     const std::map<AutoscanMediaMode,
         std::string>& containerMap)
 {
+    ScriptingRuntime::AutoLock lock(getMutex());
     std::vector<int> result;
     processed = obj;
     try {
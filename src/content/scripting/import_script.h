@@ -48,7 +48,7 @@ class ScriptingRuntime;
 
 class ImportScript : public Script {
 public:
-    ImportScript(const std::shared_ptr<Content>& content, const std::string& parent);
+    ImportScript(const std::shared_ptr<Content>& content, const std::string& parent, std::size_t heap = 0);
 
     std::vector<int> addVideo(const std::shared_ptr<CdsObject>& obj,
         const std::shared_ptr<CdsContainer>& cont,
@@ -75,7 +75,7 @@ void MetafileParserScript::processObject(const std::shared_ptr<CdsObject>& obj,
     currentLine = new char[ONE_TEXTLINE_BYTES];
     currentLine[0] = '\0';
 
-    ScriptingRuntime::AutoLock lock(runtime->getMutex());
+    ScriptingRuntime::AutoLock lock(getMutex());
     try {
         call(obj, nullptr, metafileFunction, path, "");
     } catch (const std::runtime_error&) {
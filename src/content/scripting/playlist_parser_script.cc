@@ -192,7 +192,7 @@ void PlaylistParserScript::processPlaylistObject(
     currentLine = new char[ONE_TEXTLINE_BYTES];
     currentLine[0] = '\0';
 
-    ScriptingRuntime::AutoLock lock(runtime->getMutex());
+    ScriptingRuntime::AutoLock lock(getMutex());
     try {
         call(obj, nullptr, playlistFunction, rootPath, "");
     } catch (const std::runtime_error&) {
@@ -114,7 +114,8 @@ Script::Script(
     const std::string& name,
     std::string objName,
     bool needResult,
-    std::shared_ptr<StringConverter> sc)
+    std::shared_ptr<StringConverter> sc,
+    std::size_t heap)
     : config(content->getContext()->getConfig())
     , database(content->getContext()->getDatabase())
     , converterManager(content->getContext()->getConverterManager())
@@ -123,14 +124,15 @@ Script::Script(
     , runtime(content->getScriptingRuntime())
     , sc(std::move(sc))
     , contextName(fmt::format("{}_{}", name, parent))
+    , heap(heap)
     , objectName(std::move(objName))
 {
     hasCaseSensitiveNames = config->getBoolOption(ConfigVal::IMPORT_CASE_SENSITIVE_TAGS);
     entrySeparator = config->getOption(ConfigVal::IMPORT_LIBOPTS_ENTRY_SEP);
     /* create a context and associate it with the JS run time */
-    ScriptingRuntime::AutoLock lock(runtime->getMutex());
+    ScriptingRuntime::AutoLock lock(runtime->getMutex(heap));
     replaceAllString(contextName, "/", "_");
-    ctx = runtime->createContext(contextName);
+    ctx = runtime->createContext(contextName, heap);
     if (!ctx)
         throw_std_runtime_error("Scripting: could not initialize js context");
 
@@ -143,6 +145,7 @@ Script::Script(
 
 void Script::init()
 {
+    ScriptingRuntime::AutoLock lock(runtime->getMutex(heap));
     duk_push_thread_stash(ctx, ctx);
     duk_push_pointer(ctx, this);
     duk_put_prop_string(ctx, -2, "this");
@@ -341,6 +344,7 @@ void Script::init()
 
 void Script::loadContent()
 {
+    ScriptingRuntime::AutoLock lock(runtime->getMutex(heap));
     std::string commonFdrPath = config->getOption(ConfigVal::IMPORT_SCRIPTING_COMMON_FOLDER);
 
     if (commonFdrPath.empty()) {
@@ -357,7 +361,13 @@ void Script::loadContent()
 
 Script::~Script()
 {
-    runtime->destroyContext(contextName);
+    ScriptingRuntime::AutoLock lock(runtime->getMutex(heap));
+    runtime->destroyContext(contextName, heap);
+}
+
+std::recursive_mutex& Script::getMutex() const
+{
+    return runtime->getMutex(heap);
 }
 
 Script* Script::getContextScript(duk_context* ctx)
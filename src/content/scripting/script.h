@@ -38,6 +38,7 @@
 
 #include <duktape.h>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 // forward declaration
@@ -141,6 +142,8 @@ public:
     std::string getOrigName() const { return objectName; }
     /// @brief CdsObject currently processed by script
     std::shared_ptr<CdsObject> getProcessedObject() const { return processed; }
+    /// @brief mutex of the runtime heap the script context belongs to
+    std::recursive_mutex& getMutex() const;
 
 protected:
     Script(
@@ -149,7 +152,8 @@ protected:
         const std::string& name,
         std::string objName,
         bool needResult,
-        std::shared_ptr<StringConverter> sc);
+        std::shared_ptr<StringConverter> sc,
+        std::size_t heap = 0);
 
     /// @brief call js function to generate layout for object
     std::vector<int> call(
@@ -194,6 +198,7 @@ protected:
     std::shared_ptr<ScriptingRuntime> runtime;
     std::shared_ptr<StringConverter> sc;
     std::string contextName;
+    std::size_t heap;
 
 private:
     bool hasCaseSensitiveNames;
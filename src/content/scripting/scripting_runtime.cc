@@ -39,26 +39,46 @@
 #include "script.h"
 #include "util/logger.h"
 
-ScriptingRuntime::ScriptingRuntime()
-    : ctx(duk_create_heap(nullptr, nullptr, nullptr, nullptr, [](auto, auto msg) { log_error("Fatal Duktape error: {}", msg ? msg : "no message"); std::abort(); }))
+ScriptingRuntime::ScriptingRuntime(std::size_t layoutHeapCount)
 {
+    heaps.reserve(layoutHeapCount > 1 ? layoutHeapCount + 1 : 1);
+    while (heaps.size() < heaps.capacity()) {
+        auto heap = std::make_unique<Heap>();
+        heap->ctx = duk_create_heap(nullptr, nullptr, nullptr, nullptr, [](auto, auto msg) { log_error("Fatal Duktape error: {}", msg ? msg : "no message"); std::abort(); });
+        heaps.push_back(std::move(heap));
+    }
+    log_debug("Created {} duktape heaps", heaps.size());
 }
 
 ScriptingRuntime::~ScriptingRuntime()
 {
-    duk_destroy_heap(ctx);
+    for (auto&& heap : heaps)
+        duk_destroy_heap(heap->ctx);
+}
+
+void ScriptingRuntime::addScript(const std::shared_ptr<Script>& script)
+{
+    std::scoped_lock lock(scriptsMutex);
+    activeScripts.push_back(script);
+}
+
+std::vector<std::shared_ptr<Script>> ScriptingRuntime::getScripts()
+{
+    std::scoped_lock lock(scriptsMutex);
+    return activeScripts;
 }
 
 bool ScriptingRuntime::reloadFolders()
 {
-    for (auto&& script : activeScripts) {
+    for (auto&& script : getScripts()) {
         script->loadContent();
     }
     return true;
 }
 
-duk_context* ScriptingRuntime::createContext(const std::string& name)
+duk_context* ScriptingRuntime::createContext(const std::string& name, std::size_t heap)
 {
+    auto ctx = heaps.at(heap)->ctx;
     duk_push_heap_stash(ctx);
     duk_idx_t threadIdx = duk_push_thread_new_globalenv(ctx);
     duk_context* newctx = duk_get_context(ctx, threadIdx);
@@ -67,8 +87,9 @@ duk_context* ScriptingRuntime::createContext(const std::string& name)
     return newctx;
 }
 
-void ScriptingRuntime::destroyContext(const std::string& name)
+void ScriptingRuntime::destroyContext(const std::string& name, std::size_t heap)
 {
+    auto ctx = heaps.at(heap)->ctx;
     duk_push_heap_stash(ctx);
     duk_del_prop_string(ctx, -1, name.c_str());
     duk_pop(ctx);
@@ -44,33 +44,50 @@
 class Script;
 
 /// @brief ScriptingRuntime class definition.
+///
+/// The runtime owns independent duktape heaps. Contexts of different heaps can
+/// run at the same time, all contexts of one heap share the mutex of the heap.
+/// Heap 0 runs the parser scripts. If the layout uses several heaps, it gets
+/// heaps of its own, so a parser that starts an import never waits for a layout script.
 class ScriptingRuntime {
 protected:
-    duk_context* ctx;
-    mutable std::recursive_mutex mutex;
+    struct Heap {
+        duk_context* ctx;
+        mutable std::recursive_mutex mutex;
+    };
+    std::vector<std::unique_ptr<Heap>> heaps;
 
     std::vector<std::shared_ptr<Script>> activeScripts;
+    std::mutex scriptsMutex;
 
 public:
-    ScriptingRuntime();
+    /// @param layoutHeapCount number of heaps for layout scripts, parsers share the first heap with a single layout heap
+    explicit ScriptingRuntime(std::size_t layoutHeapCount = 1);
     virtual ~ScriptingRuntime();
 
     ScriptingRuntime(const ScriptingRuntime&) = delete;
     ScriptingRuntime& operator=(const ScriptingRuntime&) = delete;
 
     /// @brief script listens to changes in folders
-    void addScript(const std::shared_ptr<Script>& script) { activeScripts.push_back(script); }
+    void addScript(const std::shared_ptr<Script>& script);
     /// @brief get scripts
-    const std::vector<std::shared_ptr<Script>>& getScripts() { return activeScripts; }
+    std::vector<std::shared_ptr<Script>> getScripts();
     /// @brief reload scripts in folders
     bool reloadFolders();
 
-    /// @brief Returns a new (sub)context. !!! Not thread-safe !!!
-    duk_context* createContext(const std::string& name);
-    void destroyContext(const std::string& name);
+    /// @brief number of heaps that can run scripts in parallel
+    std::size_t getHeapCount() const { return heaps.size(); }
+    /// @brief first heap of the layout scripts
+    std::size_t getFirstLayoutHeap() const { return heaps.size() > 1 ? 1 : 0; }
+    /// @brief number of heaps that can run layout scripts in parallel
+    std::size_t getLayoutHeapCount() const { return heaps.size() - getFirstLayoutHeap(); }
+
+    /// @brief Returns a new (sub)context in heap. !!! Mutex of heap has to be locked !!!
+    duk_context* createContext(const std::string& name, std::size_t heap = 0);
+    void destroyContext(const std::string& name, std::size_t heap = 0);
 
     using AutoLock = std::scoped_lock<std::recursive_mutex>;
-    std::recursive_mutex& getMutex() const { return mutex; }
+    std::recursive_mutex& getMutex(std::size_t heap = 0) const { return heaps.at(heap)->mutex; }
 };
 
 #endif // __SCRIPTING_RUNTIME_H__
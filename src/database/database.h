@@ -112,6 +112,10 @@ public:
     virtual void dropTables() = 0;
 
     virtual void addObject(const std::shared_ptr<CdsObject>& object, int* changedContainer) = 0;
+    /// @brief Add new objects in one transaction, parents must already exist
+    /// @param objects objects without id, ids are set on success
+    /// @return assigned object ids in order of objects
+    virtual std::vector<int> addObjects(const std::vector<std::shared_ptr<CdsObject>>& objects) = 0;
 
     /// @brief Adds a virtual container chain specified by path.
     /// @param parentContainerId the id of the parent container
@@ -173,6 +177,22 @@ public:
         const std::string& group,
         DbFileType fileType = DbFileType::Auto)
         = 0;
+    /// @brief find id of the object identified by the given path, may be served from path cache
+    /// @param path the path of the object
+    /// @param fileType type of the database entry to search
+    /// @return object id or INVALID_OBJECT_ID
+    virtual int findObjectIdByPath(
+        const fs::path& path,
+        DbFileType fileType = DbFileType::Auto)
+        = 0;
+    /// @brief find physical objects stored with the device and inode of a file system entry
+    /// @param fileId device and inode of the entry
+    /// @param fileType DbFileType::File or DbFileType::Directory
+    /// @return objects with matching file id, may be located elsewhere
+    virtual std::vector<std::shared_ptr<CdsObject>> findObjectsByFileId(
+        const FileId& fileId,
+        DbFileType fileType)
+        = 0;
 
     /// @brief increments the updateIDs for the given objectIDs
     /// @param ids pointer to the array of ids
@@ -185,6 +205,14 @@ public:
         int objectID,
         const std::string& group = UNUSED_CLIENT_GROUP)
         = 0;
+    /// @brief load object for read only access, may be served from object cache
+    /// @param objectID id of the object
+    /// @param group client group for play status
+    /// @return object shared with other readers, must not be modified
+    virtual std::shared_ptr<CdsObject> loadCachedObject(int objectID, const std::string& group)
+    {
+        return loadObject(objectID, group);
+    }
     /// @brief get number of items in container by id
     virtual std::map<int, int> getChildCounts(
         const std::vector<int>& contId,
@@ -192,6 +220,10 @@ public:
         bool items = true,
         bool hideFsRoot = false)
         = 0;
+    /// @brief compare stored child counts of all containers with their actual children
+    /// @param repair write the actual counts for containers that differ
+    /// @return number of containers with wrong counts
+    virtual std::size_t checkChildCounts(bool repair) = 0;
 
     struct ChangedContainers {
         // Signed because IDs start at -1.
@@ -258,6 +290,8 @@ public:
     /* accounting methods */
     virtual long long getFileStats(const StatsParam& stats) = 0;
     virtual std::map<std::string, long long> getGroupStats(const StatsParam& stats) = 0;
+    /// @brief get hits, misses and size of the object cache
+    virtual std::map<std::string, long long> getObjectCacheStats() { return {}; }
 
     /* internal setting methods */
     virtual std::string getInternalSetting(const std::string& key) = 0;
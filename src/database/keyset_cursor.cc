@@ -0,0 +1,57 @@
+/*GRB*
+    Gerbera - https://gerbera.io/
+
+    keyset_cursor.cc - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file database/keyset_cursor.cc
+/// @brief Implementation of the KeysetCursorCache class.
+#define GRB_LOG_FAC GrbLogFacility::sqldatabase
+
+#include "keyset_cursor.h" // API
+
+KeysetCursorCache::KeysetCursorCache(std::size_t capacity)
+    : cursors(capacity)
+{
+}
+
+std::size_t KeysetCursorCache::getGeneration() const
+{
+    AutoLock lock(mutex);
+    return cursors.getGeneration();
+}
+
+std::optional<KeysetCursor> KeysetCursorCache::find(const std::string& query, std::size_t startingIndex)
+{
+    AutoLock lock(mutex);
+    auto entry = cursors.floor({ query, startingIndex });
+    if (entry && entry->first.first == query)
+        return KeysetCursor { entry->first.second, entry->second };
+    return std::nullopt;
+}
+
+void KeysetCursorCache::store(const std::string& query, KeysetCursor cursor, std::size_t generation)
+{
+    AutoLock lock(mutex);
+    cursors.put({ query, cursor.index }, std::move(cursor.values), generation);
+}
+
+void KeysetCursorCache::clear()
+{
+    AutoLock lock(mutex);
+    cursors.clear();
+}
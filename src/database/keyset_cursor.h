@@ -0,0 +1,82 @@
+/*GRB*
+    Gerbera - https://gerbera.io/
+
+    keyset_cursor.h - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file database/keyset_cursor.h
+/// @brief Definition of the KeysetCursorCache class.
+
+#ifndef __KEYSET_CURSOR_H__
+#define __KEYSET_CURSOR_H__
+
+#include "sql_format.h"
+#include "util/lru_cache.h"
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// @brief Term of an ORDER BY clause that can be used to seek behind the last row of a page
+struct KeysetColumn {
+    std::string expression;
+    bool descending {};
+    bool numeric {};
+};
+
+/// @brief sort key values of a row, std::nullopt represents NULL
+using KeysetValues = std::vector<std::optional<SQLParam>>;
+
+/// @brief Position in a sorted result: index of the following row and sort keys of the row before it
+struct KeysetCursor {
+    std::size_t index {};
+    KeysetValues values;
+};
+
+/// @brief Remembers the sort keys of the last row of browse and search pages
+///
+/// The next page of the same query can then be read with a seek on the sort keys
+/// instead of making the database skip all previous rows with OFFSET.
+class KeysetCursorCache {
+public:
+    explicit KeysetCursorCache(std::size_t capacity);
+
+    KeysetCursorCache(const KeysetCursorCache&) = delete;
+    KeysetCursorCache& operator=(const KeysetCursorCache&) = delete;
+
+    /// @brief get generation, has to be retrieved before running the query
+    std::size_t getGeneration() const;
+    /// @brief find the closest cursor of query at or before startingIndex
+    std::optional<KeysetCursor> find(const std::string& query, std::size_t startingIndex);
+    /// @brief remember cursor, dropped if cache was cleared since generation was retrieved
+    void store(const std::string& query, KeysetCursor cursor, std::size_t generation);
+    /// @brief drop all cursors after the content of the database was changed
+    void clear();
+
+private:
+    using CursorKey = std::pair<std::string, std::size_t>;
+
+    /// @brief ordered by query and index, so the closest cursor precedes the requested index
+    LruCache<CursorKey, KeysetValues> cursors;
+
+    mutable std::mutex mutex;
+    using AutoLock = std::scoped_lock<std::mutex>;
+};
+
+#endif // __KEYSET_CURSOR_H__
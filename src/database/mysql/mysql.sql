@@ -27,6 +27,12 @@ CREATE TABLE `mt_cds_object` (
   `service_id` varchar(GRBMAX) default NULL,
   `last_modified` bigint(20) unsigned default NULL,
   `last_updated` bigint(20) unsigned default '0',
+  `container_count` int(11) NOT NULL default '0',
+  `item_count` int(11) NOT NULL default '0',
+  `ancestor_path` varchar(767) CHARACTER SET ascii COLLATE ascii_bin default NULL,
+  `file_device` bigint(20) default NULL,
+  `file_inode` bigint(20) default NULL,
+  `file_size` bigint(20) default NULL,
   PRIMARY KEY  (`id`),
   KEY `cds_object_ref_id` (`ref_id`),
   KEY `cds_object_parent_id` (`parent_id`,`object_type`,`dc_title`),
@@ -36,6 +42,8 @@ CREATE TABLE `mt_cds_object` (
   KEY `cds_object_service_id` (`service_id`),
   KEY `cds_object_title` (`dc_title`),
   KEY `cds_object_sort_key` (`sort_key`),
+  KEY `cds_object_ancestor_path` (`ancestor_path`),
+  KEY `cds_object_file_id` (`file_inode`,`file_device`),
   CONSTRAINT `mt_cds_object_ibfk_1` FOREIGN KEY (`ref_id`) REFERENCES `mt_cds_object` (`id`) ON DELETE CASCADE ON UPDATE CASCADE,
   CONSTRAINT `mt_cds_object_ibfk_2` FOREIGN KEY (`parent_id`) REFERENCES `mt_cds_object` (`id`) ON DELETE CASCADE ON UPDATE CASCADE
 ) ENGINE=GRBENGINE CHARSET=GRBCHARSET;
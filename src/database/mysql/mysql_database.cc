@@ -60,7 +60,7 @@ MySQLDatabase::MySQLDatabase(const std::shared_ptr<Config>& config, const std::s
 
     // if mysql.sql or mysql-upgrade.xml is changed hashies have to be updated
     hashies = {
-        { 0, 3512174326 }, // index 0 is used for create script mysql.sql = Version 1
+        { 0, 172745418 }, // index 0 is used for create script mysql.sql = Version 1
         { 1, 928913698 },
         { 2, 1984244483 },
         { 3, 742641207 },
@@ -89,6 +89,9 @@ MySQLDatabase::MySQLDatabase(const std::shared_ptr<Config>& config, const std::s
         { 26, 1437624385 },
         { 27, 2132165886 },
         { 28, 1529766632 },
+        { 29, 324707319 },
+        { 30, 2420760843 },
+        { 31, 3831071651 },
         { -1, 2131653758 }, // index -1 is used for drop script mysql-drop.sql
     };
 }
@@ -242,6 +245,7 @@ void MySQLDatabase::init()
 
     auto dbVersion = prepareDatabase();
     upgradeDatabase(std::stoul(dbVersion), hashies, ConfigVal::SERVER_STORAGE_MYSQL_UPGRADE_FILE, mysqlUpdateVersion, mysqlAddResourceAttr);
+    initSearchIndex();
 
     auto dbLimit = getInternalSetting("string_limit");
     if (!dbLimit.empty() && std::stoul(dbLimit) > stringLimit)
@@ -263,7 +267,7 @@ void MySQLDatabase::dropTables()
     log_info("Dropping tables with {}", sqlFilePath.c_str());
     auto sql = GrbFile(std::move(sqlFilePath)).readTextFile();
     auto&& myHash = stringHash(sql);
-    if (myHash == hashies.at(DBVERSION)) {
+    if (myHash == hashies.at(-1)) {
         for (auto&& statement : splitString(sql, ';')) {
             trimStringInPlace(statement);
             if (statement.empty()) {
@@ -277,7 +281,7 @@ void MySQLDatabase::dropTables()
             }
         }
     } else {
-        log_warning("Wrong hash for drop script {}: {} != {}", DBVERSION, myHash, hashies.at(DBVERSION));
+        log_warning("Wrong hash for drop script {}: {} != {}", DBVERSION, myHash, hashies.at(-1));
         throw_std_runtime_error("Wrong hash for drop script {}", DBVERSION);
     }
     log_info("Database tables dropped successfully.");
@@ -474,6 +478,12 @@ void MySQLDatabase::storeInternalSetting(const std::string& key, const std::stri
         INTERNAL_SETTINGS_TABLE, quote(key), quote(value)));
 }
 
+std::string MySQLDatabase::concatSql(const std::string& left, const std::string& right) const
+{
+    // || is logical or without PIPES_AS_CONCAT
+    return fmt::format("CONCAT({}, {})", left, right);
+}
+
 void MySQLDatabase::_exec(const std::string& query)
 {
     if (mysql_real_query(&db, query.c_str(), query.size())) {
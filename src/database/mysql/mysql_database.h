@@ -57,6 +57,7 @@ public:
 
 protected:
     void _exec(const std::string& query) override;
+    std::string concatSql(const std::string& left, const std::string& right) const override;
     void checkMysqlThreadInit() const;
     std::string prepareDatabase();
 
@@ -0,0 +1,159 @@
+/*GRB*
+    Gerbera - https://gerbera.io/
+
+    object_cache.cc - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file database/object_cache.cc
+/// @brief Implementation of the CdsObjectCache class.
+#define GRB_LOG_FAC GrbLogFacility::sqldatabase
+
+#include "object_cache.h" // API
+
+#include "cds/cds_item.h"
+#include "common.h"
+#include "upnp/clients.h"
+
+CdsObjectCache::Shard::Shard(std::size_t capacity)
+    : cache(capacity, {}, [this](const Key& key, const std::shared_ptr<CdsObject>& obj) { dropReference(key.first, obj->getRefID()); })
+{
+}
+
+void CdsObjectCache::Shard::eraseObject(int objectId)
+{
+    // empty group is sorted before all others
+    cache.eraseWhile({ objectId, "" }, [objectId](const Key& key) { return key.first == objectId; });
+}
+
+void CdsObjectCache::Shard::dropReference(int objectId, int refId)
+{
+    // objects without reference are loaded with ref id 0 and must not be dropped with the root container
+    if (refId <= CDS_ID_ROOT)
+        return;
+
+    auto refs = refIndex.find(refId);
+    if (refs == refIndex.end())
+        return;
+    auto ref = refs->second.find(objectId);
+    if (ref != refs->second.end())
+        refs->second.erase(ref);
+    if (refs->second.empty())
+        refIndex.erase(refs);
+}
+
+CdsObjectCache::CdsObjectCache(std::size_t capacity)
+{
+    auto shardCapacity = (capacity + SHARD_COUNT - 1) / SHARD_COUNT;
+    for (auto&& shard : shards)
+        shard = std::make_unique<Shard>(shardCapacity);
+}
+
+std::shared_ptr<CdsObject> CdsObjectCache::get(int objectId, const std::string& group)
+{
+    auto&& shard = getShard(objectId);
+    AutoLock lock(shard.mutex);
+    auto obj = shard.cache.get({ objectId, group });
+    if (obj) {
+        hits++;
+        return *obj;
+    }
+    misses++;
+    return nullptr;
+}
+
+std::size_t CdsObjectCache::getGeneration(int objectId) const
+{
+    auto&& shard = getShard(objectId);
+    AutoLock lock(shard.mutex);
+    return shard.cache.getGeneration();
+}
+
+void CdsObjectCache::put(const std::shared_ptr<CdsObject>& obj, const std::string& group, std::size_t generation)
+{
+    auto objectId = obj->getID();
+    auto&& shard = getShard(objectId);
+    AutoLock lock(shard.mutex);
+    Key key { objectId, group };
+    if (shard.cache.peek(key))
+        return;
+
+    // dropped if object was changed while loading
+    auto refId = obj->getRefID();
+    if (shard.cache.put(key, obj, generation) && refId > CDS_ID_ROOT)
+        shard.refIndex[refId].insert(objectId);
+}
+
+void CdsObjectCache::invalidate(const std::vector<int>& objectIds)
+{
+    for (auto&& shard : shards) {
+        AutoLock lock(shard->mutex);
+        // objects referencing the changed ones may be loading in any shard
+        shard->cache.invalidate();
+        if (shard->cache.getSize() == 0)
+            continue;
+
+        for (auto&& objectId : objectIds) {
+            if (&getShard(objectId) == shard.get())
+                shard->eraseObject(objectId);
+
+            auto refs = shard->refIndex.find(objectId);
+            if (refs != shard->refIndex.end()) {
+                auto referencing = std::unordered_set<int>(refs->second.begin(), refs->second.end());
+                for (auto&& refObjectId : referencing)
+                    shard->eraseObject(refObjectId);
+            }
+        }
+    }
+}
+
+void CdsObjectCache::clear()
+{
+    for (auto&& shard : shards) {
+        AutoLock lock(shard->mutex);
+        shard->cache.clear();
+        shard->refIndex.clear();
+    }
+}
+
+void CdsObjectCache::updatePlayStatus(const std::shared_ptr<ClientStatusDetail>& detail)
+{
+    auto objectId = detail->getItemId();
+    auto&& shard = getShard(objectId);
+    AutoLock lock(shard.mutex);
+    // objects loaded concurrently still carry the previous play status
+    shard.cache.invalidate();
+    auto cached = shard.cache.peek({ objectId, detail->getGroup() });
+    if (!cached || !(*cached)->isItem())
+        return;
+
+    // cached object may be in use by readers, so the entry gets a copy with the new status
+    auto copy = CdsObject::createObject((*cached)->getEntryType());
+    (*cached)->copyTo(copy);
+    copy->setUTime((*cached)->getUTime());
+    std::static_pointer_cast<CdsItem>(copy)->setPlayStatus(detail->clone());
+    *cached = std::move(copy);
+}
+
+std::size_t CdsObjectCache::getSize() const
+{
+    std::size_t size = 0;
+    for (auto&& shard : shards) {
+        AutoLock lock(shard->mutex);
+        size += shard->cache.getSize();
+    }
+    return size;
+}
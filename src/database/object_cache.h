@@ -0,0 +1,103 @@
+/*GRB*
+    Gerbera - https://gerbera.io/
+
+    object_cache.h - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file database/object_cache.h
+/// @brief Definition of the CdsObjectCache class.
+
+#ifndef __OBJECT_CACHE_H__
+#define __OBJECT_CACHE_H__
+
+#include "util/lru_cache.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+class CdsObject;
+class ClientStatusDetail;
+
+/// @brief Bounded LRU cache of fully loaded objects keyed by object id and client group
+///
+/// Entries are distributed over shards by object id so parallel requests for
+/// different objects do not contend for the same lock. Cached objects are shared
+/// between all readers and must not be modified.
+class CdsObjectCache {
+public:
+    explicit CdsObjectCache(std::size_t capacity);
+
+    CdsObjectCache(const CdsObjectCache&) = delete;
+    CdsObjectCache& operator=(const CdsObjectCache&) = delete;
+
+    /// @brief find object in cache
+    /// @return cached object or nullptr
+    std::shared_ptr<CdsObject> get(int objectId, const std::string& group);
+    /// @brief get generation of the shard for objectId, has to be retrieved before loading the object
+    std::size_t getGeneration(int objectId) const;
+    /// @brief add loaded object, dropped if the shard was invalidated since generation was retrieved
+    void put(const std::shared_ptr<CdsObject>& obj, const std::string& group, std::size_t generation);
+
+    /// @brief drop all entries of objects and of objects referencing them
+    void invalidate(const std::vector<int>& objectIds);
+    /// @brief drop all entries
+    void clear();
+    /// @brief replace play status of the cached entry for the group of detail, other entries are kept
+    void updatePlayStatus(const std::shared_ptr<ClientStatusDetail>& detail);
+
+    std::size_t getHits() const { return hits; }
+    std::size_t getMisses() const { return misses; }
+    std::size_t getSize() const;
+
+private:
+    static constexpr std::size_t SHARD_COUNT = 16;
+
+    /// @brief object id and client group, entries of all groups of an object are a range
+    using Key = std::pair<int, std::string>;
+
+    struct Shard {
+        explicit Shard(std::size_t capacity);
+
+        LruCache<Key, std::shared_ptr<CdsObject>> cache;
+        /// @brief referenced object id to ids of cached objects referencing it, once for each group
+        std::unordered_map<int, std::unordered_multiset<int>> refIndex;
+        mutable std::mutex mutex;
+
+        /// @brief remove all entries of objectId, shard must be locked
+        void eraseObject(int objectId);
+        /// @brief remove one entry of objectId from refIndex
+        void dropReference(int objectId, int refId);
+    };
+    using AutoLock = std::scoped_lock<std::mutex>;
+
+    Shard& getShard(int objectId) { return *shards[static_cast<unsigned int>(objectId) % SHARD_COUNT]; }
+    const Shard& getShard(int objectId) const { return *shards[static_cast<unsigned int>(objectId) % SHARD_COUNT]; }
+
+    /// @brief shards are not moved, their caches refer to them
+    std::array<std::unique_ptr<Shard>, SHARD_COUNT> shards;
+    std::atomic_size_t hits {};
+    std::atomic_size_t misses {};
+};
+
+#endif // __OBJECT_CACHE_H__
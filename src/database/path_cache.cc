@@ -0,0 +1,74 @@
+/*GRB*
+    Gerbera - https://gerbera.io/
+
+    path_cache.cc - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file database/path_cache.cc
+/// @brief Implementation of the PathIdCache class.
+#define GRB_LOG_FAC GrbLogFacility::sqldatabase
+
+#include "path_cache.h" // API
+
+#include "common.h"
+
+PathIdCache::PathIdCache(std::size_t capacity)
+    : cache(capacity)
+{
+}
+
+int PathIdCache::get(const std::string& location, const std::string& entryTypes)
+{
+    AutoLock lock(mutex);
+    auto objectId = cache.get({ location, entryTypes });
+    return objectId ? *objectId : INVALID_OBJECT_ID;
+}
+
+void PathIdCache::put(const std::string& location, const std::string& entryTypes, int objectId)
+{
+    AutoLock lock(mutex);
+    cache.put({ location, entryTypes }, objectId);
+}
+
+void PathIdCache::erase(const std::string& location, const std::string& entryTypes)
+{
+    AutoLock lock(mutex);
+    cache.erase({ location, entryTypes });
+}
+
+void PathIdCache::invalidate(const std::string& location)
+{
+    AutoLock lock(mutex);
+    // "/a/b c" is sorted between "/a/b" and "/a/b/", so children are a separate range
+    cache.eraseWhile({ location, "" }, [&location](const Key& key) { return key.first == location; });
+    if (!location.empty()) {
+        auto prefix = location.back() == '/' ? location : location + "/";
+        cache.eraseWhile({ prefix, "" }, [&prefix](const Key& key) { return key.first.compare(0, prefix.size(), prefix) == 0; });
+    }
+}
+
+void PathIdCache::clear()
+{
+    AutoLock lock(mutex);
+    cache.clear();
+}
+
+std::size_t PathIdCache::getSize() const
+{
+    AutoLock lock(mutex);
+    return cache.getSize();
+}
@@ -0,0 +1,71 @@
+/*GRB*
+    Gerbera - https://gerbera.io/
+
+    path_cache.h - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file database/path_cache.h
+/// @brief Definition of the PathIdCache class.
+
+#ifndef __PATH_CACHE_H__
+#define __PATH_CACHE_H__
+
+#include "util/lru_cache.h"
+
+#include <mutex>
+#include <string>
+#include <utility>
+
+/// @brief Bounded LRU cache of object ids found by location
+///
+/// Import and inotify handling look up the same paths again on every rescan.
+/// Entries are ordered by location, so moving or renaming a directory drops the
+/// entries of its whole subtree. Ids can still be stale after concurrent changes,
+/// so callers have to check the location of the object and erase mismatches.
+class PathIdCache {
+public:
+    explicit PathIdCache(std::size_t capacity);
+
+    PathIdCache(const PathIdCache&) = delete;
+    PathIdCache& operator=(const PathIdCache&) = delete;
+
+    /// @brief find object id of location with entryTypes
+    /// @return object id or INVALID_OBJECT_ID
+    int get(const std::string& location, const std::string& entryTypes);
+    /// @brief remember object id of location with entryTypes
+    void put(const std::string& location, const std::string& entryTypes, int objectId);
+    /// @brief drop entry that turned out to be stale
+    void erase(const std::string& location, const std::string& entryTypes);
+
+    /// @brief drop entries of location and of all locations below it
+    void invalidate(const std::string& location);
+    /// @brief drop all entries
+    void clear();
+
+    std::size_t getSize() const;
+
+private:
+    using Key = std::pair<std::string, std::string>;
+
+    /// @brief ordered by location, so entries below a location are a range
+    LruCache<Key, int> cache;
+
+    mutable std::mutex mutex;
+    using AutoLock = std::scoped_lock<std::mutex>;
+};
+
+#endif // __PATH_CACHE_H__
@@ -19,6 +19,12 @@ CREATE TABLE "mt_cds_object"(
     "service_id" varchar(GRBMAX) default NULL,
     "last_modified" bigint default NULL,
     "last_updated" bigint default 0,
+    "container_count" integer NOT NULL default 0,
+    "item_count" integer NOT NULL default 0,
+    "ancestor_path" text COLLATE "C" default NULL,
+    "file_device" bigint default NULL,
+    "file_inode" bigint default NULL,
+    "file_size" bigint default NULL,
     CONSTRAINT "mt_cds_object_ibfk_1" FOREIGN KEY("ref_id") REFERENCES "mt_cds_object"("id")ON DELETE CASCADE ON UPDATE CASCADE,
     CONSTRAINT "mt_cds_object_ibfk_2" FOREIGN KEY("parent_id") REFERENCES "mt_cds_object"("id")ON DELETE CASCADE ON UPDATE CASCADE);
 
@@ -32,6 +38,8 @@ CREATE INDEX "cds_object_track_number" ON "mt_cds_object"("part_number", "track_
 CREATE INDEX "cds_object_service_id" ON "mt_cds_object"("service_id");
 CREATE INDEX "cds_object_title" ON "mt_cds_object"("dc_title");
 CREATE INDEX "cds_object_sort_key" ON "mt_cds_object"("sort_key");
+CREATE INDEX "cds_object_ancestor_path" ON "mt_cds_object"("ancestor_path");
+CREATE INDEX "cds_object_file_id" ON "mt_cds_object"("file_inode", "file_device");
 
 CREATE TABLE "mt_internal_setting"(
     "key" varchar(40) NOT NULL PRIMARY KEY,
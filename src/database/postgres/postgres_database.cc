@@ -39,6 +39,8 @@
 #include <netinet/in.h>
 #include <regex>
 
+#define PGSQL_TRIGRAM_LENGTH 3 // shortest search term the trigram index is used for
+
 static constexpr auto postgresUpdateVersion = std::string_view(R"(UPDATE "mt_internal_setting" SET "value"='{}' WHERE "key"='db_version' AND "value"='{}')");
 static const auto postgresAddResourceAttr = std::map<ResourceDataType, std::string_view> {
     { ResourceDataType::String, R"(ALTER TABLE "grb_cds_resource" ADD COLUMN "{}" varchar(255) default NULL)" },
@@ -53,14 +55,18 @@ PostgresDatabase::PostgresDatabase(std::shared_ptr<Config> config,
 {
     table_quote_begin = '"';
     table_quote_end = '"';
+    nullsSortLast = true;
     firstDBVersion = 25; // no need to migrate from older version
     // if postgres.sql or postgres-upgrade.xml is changed hashies have to be updated
     hashies = {
-        { 0, 811947449 }, // index 0 is used for create script postgres.sql = Version 1
+        { 0, 531415347 }, // index 0 is used for create script postgres.sql = Version 1
         { 25, 99037268 },
         { 26, 1496320046 },
         { 27, 1794356798 },
         { 28, 129505793 },
+        { 29, 4174834575 },
+        { 30, 469676638 },
+        { 31, 1353185376 },
         { -1, 2796031870 }, // index -1 is used for drop script postgres-drop.sql
     };
 }
@@ -131,6 +137,7 @@ void PostgresDatabase::init()
 
     try {
         upgradeDatabase(std::stoul(dbVersion), hashies, ConfigVal::SERVER_STORAGE_PGSQL_UPGRADE_FILE, postgresUpdateVersion, postgresAddResourceAttr);
+        initSearchIndex();
 
         auto dbLimit = getInternalSetting("string_limit");
         if (!dbLimit.empty() && std::stoul(dbLimit) > stringLimit)
@@ -155,11 +162,39 @@ void PostgresDatabase::init()
     }
 }
 
+std::string PostgresSearchIndex::emitMatch(
+    const std::string& idColumn,
+    const std::string& property,
+    const std::string& value,
+    const std::string& pattern) const
+{
+    // trigrams cannot narrow down shorter terms, the unindexed search is used for them
+    if (value.size() < PGSQL_TRIGRAM_LENGTH)
+        return {};
+
+    // ILIKE on trigram index is case insensitive like LOWER() on both sides
+    return fmt::format(R"(({} IN (SELECT "item_id" FROM "mt_metadata" WHERE "property_name" = {} AND "property_value" ILIKE {})))",
+        idColumn, database.quote(property), database.quote(pattern));
+}
+
+std::shared_ptr<SearchIndex> PostgresDatabase::prepareSearchIndex(bool enabled)
+{
+    // replaced by trigram index
+    exec(R"(DROP INDEX IF EXISTS "grb_metadata_search")");
+    if (!enabled) {
+        exec(R"(DROP INDEX IF EXISTS "grb_metadata_trgm")");
+        return nullptr;
+    }
+    exec("CREATE EXTENSION IF NOT EXISTS pg_trgm");
+    exec(R"(CREATE INDEX IF NOT EXISTS "grb_metadata_trgm" ON "mt_metadata" USING GIN ("property_value" gin_trgm_ops))");
+    return std::make_shared<PostgresSearchIndex>(*this);
+}
+
 void PostgresDatabase::dropTables()
 {
     auto file = config->getOption(ConfigVal::SERVER_STORAGE_PGSQL_DROP_FILE);
     log_info("Dropping tables with {}", file);
-    auto dtask = std::make_shared<PGScriptTask>(config, hashies.at(DBVERSION), stringLimit, ConfigVal::SERVER_STORAGE_PGSQL_DROP_FILE);
+    auto dtask = std::make_shared<PGScriptTask>(config, hashies.at(-1), stringLimit, ConfigVal::SERVER_STORAGE_PGSQL_DROP_FILE);
     addTask(dtask);
     try {
         dtask->waitForTask();
@@ -24,6 +24,7 @@
 #ifndef __POSTGRES_DATABASE_H__
 #define __POSTGRES_DATABASE_H__
 
+#include "database/search_handler.h"
 #include "database/sql_database.h"
 #include "util/thread_runner.h"
 #include "util/timer.h"
@@ -35,6 +36,24 @@ class PostgresSQLResult;
 class PostgresSQLRow;
 class PGTask;
 
+/// @brief Full text index of metadata values in GIN trigram index of pg_trgm
+class PostgresSearchIndex : public SearchIndex {
+public:
+    explicit PostgresSearchIndex(const SQLDatabase& database)
+        : database(database)
+    {
+    }
+
+    std::string emitMatch(
+        const std::string& idColumn,
+        const std::string& property,
+        const std::string& value,
+        const std::string& pattern) const override;
+
+private:
+    const SQLDatabase& database;
+};
+
 /// @brief The Database class for using Postgres
 class PostgresDatabase
     : public SQLDatabase {
@@ -58,6 +77,7 @@ public:
 
 protected:
     void _exec(const std::string& query) override;
+    std::shared_ptr<SearchIndex> prepareSearchIndex(bool enabled) override;
     std::string prepareDatabase();
     std::string getUnreferencedQuery(const std::string& table) override;
 
@@ -548,12 +548,14 @@ DefaultSQLEmitter::DefaultSQLEmitter(
     std::shared_ptr<ColumnMapper> colMapper,
     std::shared_ptr<ColumnMapper> metaMapper,
     std::shared_ptr<ColumnMapper> resMapper,
-    std::shared_ptr<ColumnMapper> plyMapper)
+    std::shared_ptr<ColumnMapper> plyMapper,
+    std::shared_ptr<SearchIndex> searchIndex)
     : database(std::move(database))
     , colMapper(std::move(colMapper))
     , metaMapper(std::move(metaMapper))
     , resMapper(std::move(resMapper))
     , plyMapper(std::move(plyMapper))
+    , searchIndex(std::move(searchIndex))
 {
 }
 
@@ -605,6 +607,14 @@ static const std::map<std::string, std::string> valueOperator {
     { "@neq", "{}" },
 };
 
+bool DefaultSQLEmitter::isMetaProperty(const std::string& property) const
+{
+    return metaMapper
+        && !(colMapper && colMapper->hasEntry(property))
+        && !(resMapper && resMapper->hasEntry(property))
+        && !(plyMapper && plyMapper->hasEntry(property));
+}
+
 std::tuple<std::string, std::string, FieldType> DefaultSQLEmitter::getPropertyStatement(const std::string& property) const
 {
     if (colMapper && colMapper->hasEntry(property)) {
@@ -690,6 +700,11 @@ std::string DefaultSQLEmitter::emit(
     if (logicOperator.find(stringOperator) == logicOperator.end()) {
         throw SearchParseException(fmt::format("Operation '{}' not yet supported", stringOperator), LINE_MESSAGE);
     }
+    if (searchIndex && (stringOperator == "contains" || stringOperator == "startswith") && isMetaProperty(property)) {
+        auto match = searchIndex->emitMatch(colMapper->mapQuoted(UPNP_SEARCH_ID), property, value, fmt::format(valueOperator.at(stringOperator), value));
+        if (!match.empty())
+            return match;
+    }
     auto [prpUpper, prpLower, prpType] = getPropertyStatement(property);
     auto clsUpper = std::get<0>(getPropertyStatement(UPNP_SEARCH_CLASS));
     return fmt::format(logicOperator.at(stringOperator),
@@ -410,6 +410,29 @@ struct SearchProperty {
     }
 };
 
+/// @brief Full text index of metadata values to answer contains and startswith without scanning all values
+class SearchIndex {
+public:
+    SearchIndex() = default;
+    virtual ~SearchIndex() = default;
+
+    SearchIndex(const SearchIndex&) = delete;
+    SearchIndex& operator=(const SearchIndex&) = delete;
+
+    /// @brief build condition selecting objects with a matching metadata value
+    /// @param idColumn quoted column of the object id
+    /// @param property name of the metadata property
+    /// @param value search term as sent by the client
+    /// @param pattern pattern for LIKE derived from value, not quoted
+    /// @return condition or empty string if the index cannot be used for value
+    virtual std::string emitMatch(
+        const std::string& idColumn,
+        const std::string& property,
+        const std::string& value,
+        const std::string& pattern) const
+        = 0;
+};
+
 class DefaultSQLEmitter : public SQLEmitter {
 public:
     DefaultSQLEmitter(
@@ -417,7 +440,8 @@ public:
         std::shared_ptr<ColumnMapper> colMapper,
         std::shared_ptr<ColumnMapper> metaMapper,
         std::shared_ptr<ColumnMapper> resMapper,
-        std::shared_ptr<ColumnMapper> plyMapper);
+        std::shared_ptr<ColumnMapper> plyMapper,
+        std::shared_ptr<SearchIndex> searchIndex = nullptr);
 
     std::pair<std::string, std::string> emitSQL(const ASTNode* node) const override;
     std::string emit(const ASTAsterisk* node) const override { return {}; }
@@ -444,8 +468,11 @@ private:
     std::shared_ptr<ColumnMapper> metaMapper;
     std::shared_ptr<ColumnMapper> resMapper;
     std::shared_ptr<ColumnMapper> plyMapper;
+    std::shared_ptr<SearchIndex> searchIndex;
 
     std::tuple<std::string, std::string, FieldType> getPropertyStatement(const std::string& property) const;
+    /// @brief property is stored in metadata table
+    bool isMetaProperty(const std::string& property) const;
 };
 
 class SearchParser {
@@ -45,6 +45,9 @@
 #include "db_param.h"
 #include "exceptions.h"
 #include "metadata/metadata_enums.h"
+#include "keyset_cursor.h"
+#include "path_cache.h"
+#include "object_cache.h"
 #include "search_handler.h"
 #include "sql_migration.h"
 #include "sql_result.h"
@@ -57,10 +60,19 @@
 #include "util/url_utils.h"
 
 #include <algorithm>
+#include <array>
+#include <tuple>
 #include <vector>
 
 #define MAX_REMOVE_SIZE 1000
 #define MAX_REMOVE_RECURSION 500
+#define MAX_LOAD_BATCH_SIZE 500 // below SQLITE_MAX_VARIABLE_NUMBER of SQLite < 3.32
+#define KEYSET_CURSOR_CACHE_SIZE 256 // cursors of browse and search pages
+#define PATH_CACHE_SIZE 4096 // locations of imported objects
+#define MAX_INSERT_ROWS 500 // rows combined in one INSERT statement
+
+#define CONTAINER_COUNT_COLUMN "container_count"
+#define ITEM_COUNT_COLUMN "item_count"
 
 #define AUS_ALIAS "as"
 #define CFG_ALIAS "co"
@@ -74,6 +86,20 @@
 
 #define WILDCARD "%"
 
+/// @brief lengths of IN lists of batched loads, so only a few prepared statements are needed
+static constexpr std::array<std::size_t, 4> LOAD_BATCH_BUCKETS { 10, 50, 100, MAX_LOAD_BATCH_SIZE };
+
+/// @brief get ids of the batch starting at start, padded with the last id to the next bucket size
+static std::vector<SQLParam> getBatchParams(const std::vector<int>& ids, std::size_t start)
+{
+    auto end = std::min(ids.size(), start + MAX_LOAD_BATCH_SIZE);
+    std::vector<SQLParam> params(ids.begin() + start, ids.begin() + end);
+    auto bucket = *std::find_if(LOAD_BATCH_BUCKETS.begin(), LOAD_BATCH_BUCKETS.end(), [&params](auto size) { return size >= params.size(); });
+    auto last = params.back();
+    params.resize(bucket, last);
+    return params;
+}
+
 /// @brief search column ids
 enum class SearchColumn {
     Id = 0,
@@ -124,6 +150,10 @@ static std::map<BrowseColumn, SearchProperty> browseColMap {
     { BrowseColumn::ServiceId, { ITM_ALIAS, "service_id" } },
     { BrowseColumn::LastModified, { ITM_ALIAS, "last_modified", FieldType::Date } },
     { BrowseColumn::LastUpdated, { ITM_ALIAS, "last_updated", FieldType::Date } },
+    { BrowseColumn::AncestorPath, { ITM_ALIAS, "ancestor_path" } },
+    { BrowseColumn::FileDevice, { ITM_ALIAS, "file_device", FieldType::Integer } },
+    { BrowseColumn::FileInode, { ITM_ALIAS, "file_inode", FieldType::Integer } },
+    { BrowseColumn::FileSize, { ITM_ALIAS, "file_size", FieldType::Integer } },
     { BrowseColumn::RefUpnpClass, { REF_ALIAS, "upnp_class" } },
     { BrowseColumn::RefLocation, { REF_ALIAS, "location" } },
     { BrowseColumn::RefAuxdata, { REF_ALIAS, "auxdata" } },
@@ -326,20 +356,6 @@ static const std::vector<std::pair<std::string, ClientColumn>> clientTagMap {
 };
 
 // Format string for a recursive query of a parent container
-static constexpr auto sql_search_container_query_raw = R"(
--- Find all children of parent_id
-WITH {0} AS (SELECT * FROM {2} WHERE {4} = {{}}
-UNION
-SELECT {3}.* FROM {2} JOIN {0} AS {1} ON {3}.{4} = {1}.{5}
-),
--- Find all physical items and de-reference any virtual item (i.e. follow ref-id)
-items AS (SELECT * from {0} AS {1} WHERE {6} IS NULL
-UNION
-SELECT {3}.* FROM {0} AS {1} JOIN {2} ON {1}.{6} = {3}.{5}
-)
--- Select desired cols from items
-SELECT {{}} FROM items AS {3})";
-
 #define getCol(rw, idx) (rw)->col(to_underlying((idx)))
 #define getColInt(rw, idx, def) (rw)->col_int(to_underlying((idx)), (def))
 #define setCol(dict, key, val, map) (dict).emplace((key), quote((val), (map).at((key)).length))
@@ -366,6 +382,11 @@ SQLDatabase::SQLDatabase(
     , dynamicContentEnabled(this->config->getBoolOption(ConfigVal::SERVER_DYNAMIC_CONTENT_LIST_ENABLED))
     , sortKeyEnabled(this->config->getBoolOption(ConfigVal::SERVER_STORAGE_SORT_KEY_ENABLED))
 {
+    cursorCache = std::make_shared<KeysetCursorCache>(KEYSET_CURSOR_CACHE_SIZE);
+    pathCache = std::make_shared<PathIdCache>(PATH_CACHE_SIZE);
+    auto objectCacheSize = this->config->getUIntOption(ConfigVal::SERVER_STORAGE_OBJECT_CACHE_SIZE);
+    if (objectCacheSize > 0)
+        objectCache = std::make_shared<CdsObjectCache>(objectCacheSize);
     for (auto&& [key, val] : browseColMap) {
         if (val.type == FieldType::String && val.length > stringLimit)
             val.length = stringLimit;
@@ -487,16 +508,6 @@ void SQLDatabase::init()
             playstatusColumnMapper->tableQuoted(),
             searchColumnMapper->mapQuoted(UPNP_SEARCH_ID), playstatusColumnMapper->mapQuoted(UPNP_SEARCH_ID));
         this->sql_search_query = fmt::format("{} {} {}", searchColumnMapper->tableQuoted(), join2, join3);
-
-        // Build container query format string
-        auto sql_container_query = fmt::format(sql_search_container_query_raw,
-            identifier("containers"), // defines an alias in in query_raw
-            identifier("cont"), // defines an alias in in query_raw
-            searchColumnMapper->tableQuoted(), searchColumnMapper->getAlias(),
-            searchColumnMapper->mapQuoted(UPNP_SEARCH_PARENTID, true),
-            searchColumnMapper->mapQuoted(UPNP_SEARCH_ID, true),
-            searchColumnMapper->mapQuoted(UPNP_SEARCH_REFID, true));
-        this->sql_search_container_query_format = fmt::format("{} {} {}", sql_container_query, join2, join3);
     }
     // Statement for metadata
     {
@@ -527,9 +538,28 @@ void SQLDatabase::init()
         this->sql_resource_query = fmt::format("SELECT {} ", fmt::join(buf, ", "));
     }
 
+    createSqlEmitter(nullptr);
+}
+
+void SQLDatabase::createSqlEmitter(const std::shared_ptr<SearchIndex>& searchIndex)
+{
     auto self = shared_from_this();
     auto metaSearchMapper = std::make_shared<EnumColumnMapper<MetadataColumn>>(table_quote_begin, table_quote_end, MTA_ALIAS, METADATA_TABLE, metaTagMap, metaColMap);
-    sqlEmitter = std::make_shared<DefaultSQLEmitter>(self, searchColumnMapper, metaSearchMapper, resourceColumnMapper, playstatusColumnMapper);
+    sqlEmitter = std::make_shared<DefaultSQLEmitter>(self, searchColumnMapper, metaSearchMapper, resourceColumnMapper, playstatusColumnMapper, searchIndex);
+}
+
+void SQLDatabase::initSearchIndex()
+{
+    bool enabled = config->getBoolOption(ConfigVal::SERVER_STORAGE_SEARCH_INDEX);
+    std::shared_ptr<SearchIndex> searchIndex;
+    try {
+        searchIndex = prepareSearchIndex(enabled);
+        if (enabled && !searchIndex)
+            log_warning("Full text search index is not supported by this database");
+    } catch (const std::runtime_error& e) {
+        log_warning("Full text search index is not available: {}", e.what());
+    }
+    createSqlEmitter(searchIndex);
 }
 
 static std::shared_ptr<CdsContainer> setDefaultContainer(
@@ -579,6 +609,7 @@ void SQLDatabase::fillDatabase()
         cdsObjectSql.emplace(BrowseColumn::ObjectType, quote(obj->getObjectType()));
         cdsObjectSql.emplace(BrowseColumn::EntryType, quote(int(obj->getEntryType())));
         cdsObjectSql.emplace(BrowseColumn::Flags, quote(obj->getFlags()));
+        cdsObjectSql.emplace(BrowseColumn::AncestorPath, quote(obj->getParentID() < CDS_ID_ROOT ? "/" : fmt::format("/{}/", obj->getParentID())));
         if (!obj->getClass().empty())
             cdsObjectSql.emplace(BrowseColumn::UpnpClass, quote(obj->getClass()));
 
@@ -611,6 +642,8 @@ void SQLDatabase::fillDatabase()
             }
         }
     }
+    // ids of the initial objects are fixed after insert
+    checkChildCounts(true);
 }
 
 void SQLDatabase::upgradeDatabase(
@@ -656,6 +689,42 @@ std::string SQLDatabase::quote(const std::string& value, std::size_t len) const
     return quote(value);
 }
 
+std::string SQLDatabase::inlineParams(const std::string& query, const std::vector<SQLParam>& params) const
+{
+    std::string result;
+    result.reserve(query.size() + params.size() * 10);
+    std::size_t paramIndex = 0;
+    char quoteEnd = '\0';
+    for (auto&& c : query) {
+        if (quoteEnd != '\0') {
+            if (c == quoteEnd)
+                quoteEnd = '\0';
+        } else if (c == '\'') {
+            quoteEnd = '\'';
+        } else if (c == table_quote_begin) {
+            quoteEnd = table_quote_end;
+        } else if (c == '?') {
+            if (paramIndex >= params.size())
+                throw DatabaseException(fmt::format("Missing parameter {} for query {}", paramIndex, query), LINE_MESSAGE);
+            auto&& param = params.at(paramIndex++);
+            if (std::holds_alternative<long long>(param))
+                result += quote(std::get<long long>(param));
+            else
+                result += quote(std::get<std::string>(param));
+            continue;
+        }
+        result += c;
+    }
+    if (paramIndex != params.size())
+        throw DatabaseException(fmt::format("Got {} parameters for {} placeholders in query {}", params.size(), paramIndex, query), LINE_MESSAGE);
+    return result;
+}
+
+std::shared_ptr<SQLResult> SQLDatabase::preparedSelect(const std::string& query, const std::vector<SQLParam>& params)
+{
+    return select(inlineParams(query, params));
+}
+
 std::string SQLDatabase::getSearchCapabilities()
 {
     auto searchKeys = std::vector {
@@ -711,7 +780,8 @@ std::shared_ptr<CdsObject> SQLDatabase::checkRefID(const std::shared_ptr<CdsObje
 std::vector<std::shared_ptr<AddUpdateTable<CdsObject>>> SQLDatabase::_addUpdateObject(
     const std::shared_ptr<CdsObject>& obj,
     Operation op,
-    int* changedContainer)
+    int* changedContainer,
+    std::map<int, std::optional<std::string>>* ancestorPaths)
 {
     std::shared_ptr<CdsObject> refObj;
     bool hasReference = false;
@@ -781,6 +851,14 @@ std::vector<std::shared_ptr<AddUpdateTable<CdsObject>>> SQLDatabase::_addUpdateO
     }
     cdsObjectSql.emplace(BrowseColumn::LastUpdated, quote(currentTime().count()));
 
+    // file id is kept if unknown, it allows to find the object after the file was moved
+    auto fileId = obj->getFileId();
+    if (fileId.isValid() && !hasReference && (obj->isPureItem() || obj->getEntryType() == CdsEntryType::Directory)) {
+        cdsObjectSql.emplace(BrowseColumn::FileDevice, quote(static_cast<long long>(fileId.device)));
+        cdsObjectSql.emplace(BrowseColumn::FileInode, quote(static_cast<long long>(fileId.inode)));
+        cdsObjectSql.emplace(BrowseColumn::FileSize, obj->isPureItem() ? quote(static_cast<long long>(obj->getSizeOnDisk())) : SQL_NULL);
+    }
+
     int parentID = obj->getParentID();
     if (obj->isContainer() && op == Operation::Update) {
         std::string dbLocation = obj->getLocation();
@@ -836,6 +914,19 @@ std::vector<std::shared_ptr<AddUpdateTable<CdsObject>>> SQLDatabase::_addUpdateO
     }
 
     cdsObjectSql.emplace(BrowseColumn::ParentId, quote(parentID));
+    if (op == Operation::Insert) {
+        // moves are handled by updateObject
+        std::optional<std::string> ancestorPath;
+        if (ancestorPaths) {
+            auto entry = ancestorPaths->find(parentID);
+            if (entry == ancestorPaths->end())
+                entry = ancestorPaths->emplace(parentID, getChildAncestorPath(parentID)).first;
+            ancestorPath = entry->second;
+        } else {
+            ancestorPath = getChildAncestorPath(parentID);
+        }
+        cdsObjectSql.emplace(BrowseColumn::AncestorPath, ancestorPath ? quote(*ancestorPath) : SQL_NULL);
+    }
 
     std::vector<std::shared_ptr<AddUpdateTable<CdsObject>>> returnVal;
     // check for a duplicate (virtual) object
@@ -887,11 +978,68 @@ void SQLDatabase::addObject(const std::shared_ptr<CdsObject>& obj, int* changedC
         if (!addUpdateTable->hasInsertResult().empty()) {
             int newId = exec(qb, addUpdateTable->hasInsertResult());
             obj->setID(newId);
+            _changeChildCounts(obj->getParentID(), obj->getObjectType(), 1);
         } else {
             execOnTable(CDS_OBJECT_TABLE, qb, obj->getID());
         }
     }
     commit("addObject");
+    cursorCache->clear();
+}
+
+std::vector<int> SQLDatabase::addObjects(const std::vector<std::shared_ptr<CdsObject>>& objects)
+{
+    std::vector<std::vector<std::shared_ptr<AddUpdateTable<CdsObject>>>> objectTables;
+    objectTables.reserve(objects.size());
+    // objects of a batch mostly share few parents
+    std::map<int, std::optional<std::string>> ancestorPaths;
+    for (auto&& obj : objects) {
+        if (obj->getID() != INVALID_OBJECT_ID)
+            throw DatabaseException("Tried to add an object with an object ID set", LINE_MESSAGE);
+        objectTables.push_back(_addUpdateObject(obj, Operation::Insert, nullptr, &ancestorPaths));
+    }
+
+    std::vector<int> result;
+    result.reserve(objects.size());
+    // rows of metadata and resources per table, combined after all ids are known
+    std::map<std::string, std::vector<InsertRow>> tableRows;
+    // container and item delta per parent
+    std::map<int, std::pair<int, int>> childCounts;
+
+    beginTransaction("addObjects");
+    for (std::size_t index = 0; index < objects.size(); index++) {
+        auto&& obj = objects.at(index);
+        for (auto&& addUpdateTable : objectTables.at(index)) {
+            if (!addUpdateTable->hasInsertResult().empty()) {
+                auto qb = addUpdateTable->sqlForInsert(obj);
+                log_debug("Generated insert: {}", qb);
+                obj->setID(exec(qb, addUpdateTable->hasInsertResult()));
+                auto&& [containerDelta, itemDelta] = childCounts[obj->getParentID()];
+                if (obj->getObjectType() == OBJECT_TYPE_CONTAINER)
+                    containerDelta++;
+                else if ((obj->getObjectType() & OBJECT_TYPE_ITEM) == OBJECT_TYPE_ITEM)
+                    itemDelta++;
+            } else {
+                tableRows[addUpdateTable->getTableName()].push_back(addUpdateTable->getInsertRow(obj));
+            }
+        }
+        result.push_back(obj->getID());
+    }
+    for (auto&& [tableName, rows] : tableRows) {
+        for (std::size_t start = 0; start < rows.size(); start += MAX_INSERT_ROWS) {
+            auto end = std::min<std::size_t>(start + MAX_INSERT_ROWS, rows.size());
+            auto qb = sqlForInsertRows(fmt::to_string(identifier(tableName)), { rows.begin() + start, rows.begin() + end });
+            log_debug("Generated insert: {}", qb);
+            execOnly(qb);
+        }
+    }
+    for (auto&& [parentID, delta] : childCounts) {
+        _changeChildCounts(parentID, delta.first, delta.second);
+    }
+    commit("addObjects");
+    cursorCache->clear();
+
+    return result;
 }
 
 void SQLDatabase::updateObject(const std::shared_ptr<CdsObject>& obj, int* changedContainer)
@@ -912,6 +1060,34 @@ void SQLDatabase::updateObject(const std::shared_ptr<CdsObject>& obj, int* chang
     }
 
     beginTransaction("updateObject");
+    if (obj->getID() != CDS_ID_FS_ROOT) {
+        // object may have been moved to another container
+        auto res = select(fmt::format("SELECT {}, {}, {}, {} FROM {} WHERE {}",
+            browseColumnMapper->mapQuoted(BrowseColumn::ParentId, true),
+            browseColumnMapper->mapQuoted(BrowseColumn::ObjectType, true),
+            browseColumnMapper->mapQuoted(BrowseColumn::AncestorPath, true),
+            browseColumnMapper->mapQuoted(BrowseColumn::Location, true),
+            browseColumnMapper->getTableName(),
+            browseColumnMapper->getClause(BrowseColumn::Id, obj->getID(), true)));
+        std::unique_ptr<SQLRow> row;
+        if (res && (row = res->nextRow())) {
+            const int oldParentID = row->col_int(0, INVALID_OBJECT_ID);
+            const unsigned int oldObjectType = row->col_int(1, 0);
+            if (oldParentID != obj->getParentID() || oldObjectType != obj->getObjectType()) {
+                _changeChildCounts(oldParentID, oldObjectType, -1);
+                _changeChildCounts(obj->getParentID(), obj->getObjectType(), 1);
+            }
+            if (oldParentID != obj->getParentID()) {
+                auto oldPath = row->isNullOrEmpty(2) ? std::nullopt : std::optional(row->col(2));
+                _moveAncestorPath(obj->getID(), oldPath, obj->getParentID());
+            }
+            if (row->col(3) != obj->getLocation().string()) {
+                // locations of children of a renamed directory change as well
+                pathCache->invalidate(row->col(3));
+                pathCache->invalidate(obj->getLocation().string());
+            }
+        }
+    }
     for (auto&& addUpdateTable : data) {
         Operation op = addUpdateTable->getOperation();
         auto qb = [&obj, op, &addUpdateTable] {
@@ -941,6 +1117,8 @@ void SQLDatabase::updateObject(const std::shared_ptr<CdsObject>& obj, int* chang
         }
     }
     commit("updateObject");
+    invalidateCachedObjects({ obj->getID() });
+    cursorCache->clear();
 }
 
 std::shared_ptr<CdsObject> SQLDatabase::loadObject(
@@ -951,16 +1129,18 @@ std::shared_ptr<CdsObject> SQLDatabase::loadObject(
         return dynamicContainers.at(objectID);
     }
 
+    ReadScope readScope(*this);
     beginTransaction("loadObject");
     auto loadSql = fmt::format("SELECT {} FROM {} WHERE {}",
         sql_browse_columns,
         sql_browse_query,
-        browseColumnMapper->getClause(BrowseColumn::Id, quote(objectID)));
-    auto res = select(loadSql);
+        browseColumnMapper->getClause(BrowseColumn::Id, "?"));
+    auto res = preparedSelect(loadSql, { objectID });
     if (res) {
         auto row = res->nextRow();
         if (row) {
-            auto result = createObjectFromRow(group, row);
+            auto result = createObjectFromRow(row);
+            loadObjectDetails({ result }, group, true);
             commit("loadObject");
             return result;
         }
@@ -970,6 +1150,132 @@ std::shared_ptr<CdsObject> SQLDatabase::loadObject(
     throw ObjectNotFoundException(fmt::format("Object not found: {}", objectID));
 }
 
+std::shared_ptr<CdsObject> SQLDatabase::loadCachedObject(int objectID, const std::string& group)
+{
+    if (!objectCache || dynamicContainers.find(objectID) != dynamicContainers.end())
+        return loadObject(objectID, group);
+
+    auto result = objectCache->get(objectID, group);
+    if (!result) {
+        auto generation = objectCache->getGeneration(objectID);
+        result = loadObject(objectID, group);
+        objectCache->put(result, group, generation);
+    }
+    return result;
+}
+
+void SQLDatabase::invalidateCachedObjects(const std::vector<int>& objectIds)
+{
+    if (objectCache && !objectIds.empty())
+        objectCache->invalidate(objectIds);
+}
+
+std::optional<KeysetColumn> SQLDatabase::getKeysetColumn(const std::string& orderQb, const std::string& titleColumn, const std::string& sortKeyColumn)
+{
+    for (auto&& column : { titleColumn, sortKeyColumn }) {
+        if (orderQb == column || orderQb == fmt::format("{} ASC", column))
+            return KeysetColumn { column, false, false };
+        if (orderQb == fmt::format("{} DESC", column))
+            return KeysetColumn { column, true, false };
+    }
+    // sort criteria with metadata or several properties are paged with OFFSET
+    return std::nullopt;
+}
+
+std::vector<std::string> SQLDatabase::keysetExpressions(const std::vector<KeysetColumn>& keyset)
+{
+    std::vector<std::string> result;
+    result.reserve(keyset.size());
+    std::transform(keyset.begin(), keyset.end(), std::back_inserter(result), [](auto&& column) { return column.expression; });
+    return result;
+}
+
+KeysetValues SQLDatabase::getKeysetValues(const std::vector<KeysetColumn>& keyset, const std::unique_ptr<SQLRow>& row, std::size_t firstColumn)
+{
+    KeysetValues result;
+    result.reserve(keyset.size());
+    for (std::size_t index = 0; index < keyset.size(); index++) {
+        auto column = static_cast<int>(firstColumn + index);
+        if (!row->col_c_str(column))
+            result.emplace_back(std::nullopt);
+        else if (keyset.at(index).numeric)
+            result.emplace_back(row->col_long(column, 0));
+        else
+            result.emplace_back(row->col(column));
+    }
+    return result;
+}
+
+std::string SQLDatabase::containerFirstExpression() const
+{
+    // integer instead of a comparison, which is boolean in PostgreSQL and cannot be compared with the keyset value
+    return fmt::format("(CASE WHEN {} = {} THEN 1 ELSE 0 END)", browseColumnMapper->mapQuoted(BrowseColumn::ObjectType), OBJECT_TYPE_CONTAINER);
+}
+
+std::string SQLDatabase::keysetCondition(const std::vector<KeysetColumn>& keyset, const KeysetValues& values, std::vector<SQLParam>& params) const
+{
+    // (k0 after v0) OR (k0 = v0 AND k1 after v1) OR ...
+    std::vector<std::string> alternatives;
+    std::vector<std::string> equalPrefix;
+    std::vector<SQLParam> equalParams;
+    for (std::size_t index = 0; index < keyset.size(); index++) {
+        auto&& column = keyset.at(index);
+        auto&& value = values.at(index);
+        // direction in which rows behind the cursor are found, NULL sorts as smallest or largest value
+        bool greater = !column.descending;
+        std::string after;
+        std::vector<SQLParam> afterParams;
+        if (!value) {
+            if (greater != nullsSortLast)
+                after = fmt::format("{} IS NOT NULL", column.expression);
+        } else {
+            after = fmt::format("{} {} ?", column.expression, greater ? ">" : "<");
+            if (greater == nullsSortLast)
+                after = fmt::format("({} OR {} IS NULL)", after, column.expression);
+            afterParams.push_back(*value);
+        }
+        if (!after.empty()) {
+            auto alternative = equalPrefix;
+            alternative.push_back(std::move(after));
+            alternatives.push_back(fmt::format("({})", fmt::join(alternative, " AND ")));
+            params.insert(params.end(), equalParams.begin(), equalParams.end());
+            params.insert(params.end(), afterParams.begin(), afterParams.end());
+        }
+
+        if (!value) {
+            equalPrefix.push_back(fmt::format("{} IS NULL", column.expression));
+        } else {
+            equalPrefix.push_back(fmt::format("{} = ?", column.expression));
+            equalParams.push_back(*value);
+        }
+    }
+    if (alternatives.empty())
+        return "0 = 1";
+    return fmt::format("({})", fmt::join(alternatives, " OR "));
+}
+
+std::string SQLDatabase::joinParams(const std::vector<SQLParam>& params)
+{
+    std::vector<std::string> result;
+    result.reserve(params.size());
+    for (auto&& param : params) {
+        result.push_back(std::visit([](auto&& value) { return fmt::to_string(value); }, param));
+    }
+    return fmt::format("{}", fmt::join(result, "|"));
+}
+
+std::map<std::string, long long> SQLDatabase::getObjectCacheStats()
+{
+    if (!objectCache)
+        return {};
+
+    return {
+        { "objectCacheHits", objectCache->getHits() },
+        { "objectCacheMisses", objectCache->getMisses() },
+        { "objectCacheSize", objectCache->getSize() },
+    };
+}
+
 std::shared_ptr<CdsObject> SQLDatabase::loadObjectByServiceID(const std::string& serviceID, const std::string& group)
 {
     auto loadSql = fmt::format("SELECT {} FROM {} WHERE {} = {}", sql_browse_columns, sql_browse_query, browseColumnMapper->mapQuoted(BrowseColumn::ServiceId), quote(serviceID));
@@ -978,8 +1284,10 @@ std::shared_ptr<CdsObject> SQLDatabase::loadObjectByServiceID(const std::string&
     if (res) {
         auto row = res->nextRow();
         if (row) {
+            auto result = createObjectFromRow(row);
+            loadObjectDetails({ result }, group, true);
             commit("loadObjectByServiceID");
-            return createObjectFromRow(group, row);
+            return result;
         }
     }
     commit("loadObjectByServiceID");
@@ -1027,6 +1335,7 @@ std::vector<int> SQLDatabase::getServiceObjectIDs(char servicePrefix)
 
 std::vector<std::shared_ptr<CdsObject>> SQLDatabase::browse(BrowseParam& param)
 {
+    ReadScope readScope(*this);
     const auto parent = param.getObject();
     bool getContainers = param.getFlag(BROWSE_CONTAINERS);
     bool getItems = param.getFlag(BROWSE_ITEMS);
@@ -1054,10 +1363,14 @@ std::vector<std::shared_ptr<CdsObject>> SQLDatabase::browse(BrowseParam& param)
     bool hideFsRoot = param.getFlag(BROWSE_HIDE_FS_ROOT);
     int childCount = 1;
     std::vector<std::string> where;
+    std::vector<SQLParam> params;
     std::string orderBy;
     std::string limit;
     std::string addColumns;
     std::string addJoin;
+    std::vector<KeysetColumn> keyset;
+    std::string cursorQuery;
+    auto cursorGeneration = cursorCache->getGeneration();
 
     if (param.getSources().size() > 0) {
         where.push_back(fmt::format("{} IN ({})",
@@ -1074,7 +1387,8 @@ std::vector<std::shared_ptr<CdsObject>> SQLDatabase::browse(BrowseParam& param)
         childCount = childCounts.empty() ? 0 : childCounts.at(parent->getID());
         param.setTotalMatches(childCount);
 
-        where.push_back(fmt::format("{} = {}", browseColumnMapper->mapQuoted(BrowseColumn::ParentId), parent->getID()));
+        where.push_back(fmt::format("{} = ?", browseColumnMapper->mapQuoted(BrowseColumn::ParentId)));
+        params.emplace_back(parent->getID());
 
         if (parent->getID() == CDS_ID_ROOT && hideFsRoot)
             where.push_back(fmt::format("{} != {:d}", browseColumnMapper->mapQuoted(BrowseColumn::Id), CDS_ID_FS_ROOT));
@@ -1082,8 +1396,10 @@ std::vector<std::shared_ptr<CdsObject>> SQLDatabase::browse(BrowseParam& param)
         if (getItems && !forbiddenDirectories.empty()) {
             std::vector<std::string> forbiddenList;
             for (auto&& forbDir : forbiddenDirectories) {
-                forbiddenList.push_back(fmt::format("({0} is not null AND {0} like {1})", browseColumnMapper->mapQuoted(BrowseColumn::RefLocation), quote(forbDir + WILDCARD)));
-                forbiddenList.push_back(fmt::format("({0} is not null AND {0} like {1})", browseColumnMapper->mapQuoted(BrowseColumn::Location), quote(forbDir + WILDCARD)));
+                forbiddenList.push_back(fmt::format("({0} is not null AND {0} like ?)", browseColumnMapper->mapQuoted(BrowseColumn::RefLocation)));
+                forbiddenList.push_back(fmt::format("({0} is not null AND {0} like ?)", browseColumnMapper->mapQuoted(BrowseColumn::Location)));
+                params.emplace_back(forbDir + WILDCARD);
+                params.emplace_back(forbDir + WILDCARD);
             }
             where.push_back(fmt::format("(NOT (({0} & {1}) = {1} AND ({2})) OR ({0} & {1}) != {1})", browseColumnMapper->mapQuoted(BrowseColumn::ObjectType), OBJECT_TYPE_ITEM, fmt::join(forbiddenList, " OR ")));
         }
@@ -1106,17 +1422,24 @@ std::vector<std::shared_ptr<CdsObject>> SQLDatabase::browse(BrowseParam& param)
             return orderQb;
         };
 
-        auto limitCode = [](int startingIndex, int requestedCount) {
+        // paging values are bound to keep statement text identical for all pages
+        auto limitCode = [&params](int startingIndex, int requestedCount) {
             if (startingIndex > 0 && requestedCount > 0) {
-                return fmt::format(" LIMIT {} OFFSET {}", requestedCount, startingIndex);
+                params.emplace_back(requestedCount);
+                params.emplace_back(startingIndex);
+                return std::string(" LIMIT ? OFFSET ?");
             } else if (startingIndex > 0) {
-                return fmt::format(" LIMIT ~0 OFFSET {}", startingIndex);
+                params.emplace_back(startingIndex);
+                return std::string(" LIMIT ~0 OFFSET ?");
             } else if (requestedCount > 0) {
-                return fmt::format(" LIMIT {}", requestedCount);
+                params.emplace_back(requestedCount);
+                return std::string(" LIMIT ?");
             }
             return std::string();
         };
 
+        auto orderQb = (getContainers || getItems) ? orderByCode() : std::string();
+        auto keysetColumn = getKeysetColumn(orderQb, browseColumnMapper->mapQuoted(BrowseColumn::DcTitle), browseColumnMapper->mapQuoted(BrowseColumn::SortKey));
         if (!getContainers && !getItems) {
             auto zero = std::string("0 = 1");
             where.push_back(std::move(zero));
@@ -1125,41 +1448,73 @@ std::vector<std::shared_ptr<CdsObject>> SQLDatabase::browse(BrowseParam& param)
             // Sorting by UpnpClass will avoid mixing different types of containers
             // "Special" containers like "All Songs" (which are of upnp_class 'object.container') will be displayed before
             // albums (which are of upnp_class 'object.container.album.musicAlbum')
-            orderBy = fmt::format(" ORDER BY {}, {}", browseColumnMapper->mapQuoted(BrowseColumn::UpnpClass), orderByCode());
+            orderBy = fmt::format(" ORDER BY {}, {}", browseColumnMapper->mapQuoted(BrowseColumn::UpnpClass), orderQb);
+            if (keysetColumn)
+                keyset = { { browseColumnMapper->mapQuoted(BrowseColumn::UpnpClass) }, *keysetColumn };
         } else if (!getContainers && getItems) {
             where.push_back(fmt::format("({0} & {1}) = {1}", browseColumnMapper->mapQuoted(BrowseColumn::ObjectType), OBJECT_TYPE_ITEM));
-            orderBy = fmt::format(" ORDER BY {}", orderByCode());
+            orderBy = fmt::format(" ORDER BY {}", orderQb);
+            if (keysetColumn)
+                keyset = { *keysetColumn };
         } else {
-            // ORDER BY (object_type = OBJECT_TYPE_CONTAINER) ensures that containers are returned before items
+            // ORDER BY containerFirst ensures that containers are returned before items
             // Sorting by UpnpClass will avoid mixing different types of containers
-            orderBy = fmt::format(" ORDER BY ({} = {}) DESC, {}, {}", browseColumnMapper->mapQuoted(BrowseColumn::ObjectType), OBJECT_TYPE_CONTAINER,
-                browseColumnMapper->mapQuoted(BrowseColumn::UpnpClass), orderByCode());
+            auto containerFirst = containerFirstExpression();
+            orderBy = fmt::format(" ORDER BY {} DESC, {}, {}", containerFirst, browseColumnMapper->mapQuoted(BrowseColumn::UpnpClass), orderQb);
+            if (keysetColumn)
+                keyset = { { containerFirst, true, true }, { browseColumnMapper->mapQuoted(BrowseColumn::UpnpClass) }, *keysetColumn };
         }
 
-        limit = limitCode(param.getStartingIndex(), param.getRequestedCount());
+        if (keyset.empty()) {
+            limit = limitCode(param.getStartingIndex(), param.getRequestedCount());
+        } else {
+            // id makes the sort order unique, so a page can be continued behind its last row
+            keyset.push_back({ browseColumnMapper->mapQuoted(BrowseColumn::Id), false, true });
+            orderBy.append(fmt::format(", {}", browseColumnMapper->mapQuoted(BrowseColumn::Id)));
+            cursorQuery = fmt::format("{}{}|{}", fmt::join(where, " AND "), orderBy, joinParams(params));
+
+            auto cursor = param.getStartingIndex() > 0 ? cursorCache->find(cursorQuery, param.getStartingIndex()) : std::nullopt;
+            if (cursor) {
+                log_debug("Continue browse behind row {} for starting index {}", cursor->index, param.getStartingIndex());
+                where.push_back(keysetCondition(keyset, cursor->values, params));
+                limit = limitCode(param.getStartingIndex() - static_cast<int>(cursor->index), param.getRequestedCount());
+            } else {
+                limit = limitCode(param.getStartingIndex(), param.getRequestedCount());
+            }
+            addColumns = fmt::format(", {}{}", fmt::join(keysetExpressions(keyset), ", "), addColumns);
+        }
     } else { // metadata
         param.setTotalMatches(1);
-        where.push_back(fmt::format("{} = {}", browseColumnMapper->mapQuoted(BrowseColumn::Id), parent->getID()));
+        where.push_back(fmt::format("{} = ?", browseColumnMapper->mapQuoted(BrowseColumn::Id)));
+        params.emplace_back(parent->getID());
         limit = " LIMIT 1";
     }
 
     auto qb = fmt::format("SELECT {} {} FROM {} {} WHERE {}{}{}", sql_browse_columns, addColumns, sql_browse_query, addJoin, fmt::join(where, " AND "), orderBy, limit);
     log_debug("QUERY: {}", qb);
     beginTransaction("browse");
-    std::shared_ptr<SQLResult> sqlResult = select(qb);
+    std::shared_ptr<SQLResult> sqlResult = preparedSelect(qb, params);
     commit("browse");
 
     std::vector<std::shared_ptr<CdsObject>> result;
     std::vector<std::shared_ptr<CdsContainer>> containers;
     result.reserve(sqlResult->getNumRows());
     std::unique_ptr<SQLRow> row;
+    KeysetValues lastValues;
     while ((row = sqlResult->nextRow())) {
-        auto obj = createObjectFromRow(param.getGroup(), row);
+        auto obj = createObjectFromRow(row);
         if (obj->isContainer()) {
             containers.push_back(std::static_pointer_cast<CdsContainer>(obj));
         }
         result.push_back(std::move(obj));
+        if (!keyset.empty())
+            lastValues = getKeysetValues(keyset, row, browseColMap.size());
+    }
+    if (!keyset.empty() && param.getRequestedCount() > 0 && result.size() == static_cast<std::size_t>(param.getRequestedCount())) {
+        cursorCache->store(cursorQuery, { param.getStartingIndex() + result.size(), std::move(lastValues) }, cursorGeneration);
     }
+    // load metadata and resources of complete page
+    loadObjectDetails(result, param.getGroup(), true);
 
     // update childCount fields of containers (query all containers in one batch)
     if (!containers.empty()) {
@@ -1247,6 +1602,7 @@ void SQLDatabase::initDynContainers(const std::shared_ptr<CdsObject>& sParent)
 
 std::vector<std::shared_ptr<CdsObject>> SQLDatabase::search(SearchParam& param)
 {
+    ReadScope readScope(*this);
     auto searchParser = SearchParser(*sqlEmitter, param.getSearchCriteria());
     std::shared_ptr<ASTNode> rootNode = searchParser.parse();
     auto sql = rootNode->emitSQL();
@@ -1277,20 +1633,28 @@ std::vector<std::shared_ptr<CdsObject>> SQLDatabase::search(SearchParam& param)
         }
         searchSQL.append(fmt::format(" AND (NOT (({0} & {1}) = {1} AND ({2})) OR ({0} & {1}) != {1})", searchColumnMapper->mapQuoted(SearchColumn::ObjectType), OBJECT_TYPE_ITEM, fmt::join(forbiddenList, " OR ")));
     }
-    log_debug("Search query resolves to SQL [\n{}\n]", searchSQL);
 
     bool rootContainer = param.getContainerID().empty() || param.getContainerID() == "0";
-
-    std::string countSQL;
-    if (rootContainer) {
-        // Use faster, non-recursive search for root container
-        countSQL = fmt::format("SELECT COUNT(DISTINCT {}) FROM {} WHERE {}", searchColumnMapper->mapQuoted(UPNP_SEARCH_ID), coreSQL, searchSQL);
-    } else {
-        // Use recursive container search
-        const std::string countSelect = fmt::format("COUNT(DISTINCT {})", searchColumnMapper->mapQuoted(UPNP_SEARCH_ID));
-        countSQL = fmt::format(sql_search_container_query_format, param.getContainerID(), countSelect);
-        countSQL += fmt::format(" {} WHERE {}", sql.second, searchSQL);
+    if (!rootContainer) {
+        // descendants of the container, virtual items are replaced by the referenced objects
+        auto containerID = stoiString(param.getContainerID(), INVALID_OBJECT_ID);
+        auto ancestorPath = getChildAncestorPath(containerID);
+        if (!ancestorPath) {
+            log_debug("Search container {} not found", param.getContainerID());
+            param.setTotalMatches(0);
+            return {};
+        }
+        searchSQL = fmt::format("{} IN (SELECT COALESCE({}, {}) FROM {} WHERE {}) AND ({})",
+            searchColumnMapper->mapQuoted(UPNP_SEARCH_ID),
+            browseColumnMapper->mapQuoted(BrowseColumn::RefId, true),
+            browseColumnMapper->mapQuoted(BrowseColumn::Id, true),
+            browseColumnMapper->getTableName(),
+            getSubtreeClause(*ancestorPath),
+            searchSQL);
     }
+    log_debug("Search query resolves to SQL [\n{}\n]", searchSQL);
+
+    std::string countSQL = fmt::format("SELECT COUNT(DISTINCT {}) FROM {} WHERE {}", searchColumnMapper->mapQuoted(UPNP_SEARCH_ID), coreSQL, searchSQL);
 
     log_debug("Search count resolves to SQL [\n{}\n]", countSQL);
     beginTransaction("search");
@@ -1317,11 +1681,12 @@ std::vector<std::shared_ptr<CdsObject>> SQLDatabase::search(SearchParam& param)
         return orderQb;
     };
 
-    auto orderBy = fmt::format(" ORDER BY {}", orderByCode());
+    auto orderQb = orderByCode();
+    auto orderBy = fmt::format(" ORDER BY {}", orderQb);
 
     auto startingIndex = param.getStartingIndex();
     auto requestedCount = param.getRequestedCount();
-    auto limitCode = [&]() {
+    auto limitCode = [&requestedCount](long long startingIndex) {
         if (startingIndex > 0 && requestedCount > 0) {
             return fmt::format(" LIMIT {} OFFSET {}", requestedCount, startingIndex);
         } else if (startingIndex > 0) {
@@ -1332,31 +1697,57 @@ std::vector<std::shared_ptr<CdsObject>> SQLDatabase::search(SearchParam& param)
         return std::string();
     };
 
-    std::string limit = limitCode();
-    log_vdebug("limitCode {}", limit);
+    auto retrievalCode = [&](const std::string& where, const std::string& limit) {
+        return fmt::format("SELECT DISTINCT {} {} FROM {} {} WHERE {}{}{}", sql_search_columns, addColumns, coreSQL, addJoin, where, orderBy, limit);
+    };
 
-    std::string retrievalSQL;
-    if (rootContainer) {
-        // Use faster, non-recursive search for root container
-        retrievalSQL = fmt::format("SELECT DISTINCT {} {} FROM {} {} WHERE {}{}{}", sql_search_columns, addColumns, coreSQL, addJoin, searchSQL, orderBy, limit);
+    std::vector<KeysetColumn> keyset;
+    std::vector<SQLParam> params;
+    std::string cursorQuery;
+    auto cursorGeneration = cursorCache->getGeneration();
+    std::string limit;
+    auto keysetColumn = getKeysetColumn(orderQb, searchColumnMapper->mapQuoted(SearchColumn::DcTitle), searchColumnMapper->mapQuoted(SearchColumn::SortKey));
+    if (keysetColumn) {
+        // id makes the sort order unique, so a page can be continued behind its last row
+        keyset = { *keysetColumn, { searchColumnMapper->mapQuoted(UPNP_SEARCH_ID), false, true } };
+        orderBy.append(fmt::format(", {}", searchColumnMapper->mapQuoted(UPNP_SEARCH_ID)));
+        addColumns = fmt::format(", {}{}", fmt::join(keysetExpressions(keyset), ", "), addColumns);
+        cursorQuery = retrievalCode(searchSQL, "");
+
+        auto cursor = startingIndex > 0 ? cursorCache->find(cursorQuery, startingIndex) : std::nullopt;
+        if (cursor) {
+            log_debug("Continue search behind row {} for starting index {}", cursor->index, startingIndex);
+            searchSQL = fmt::format("{} AND {}", searchSQL, keysetCondition(keyset, cursor->values, params));
+            limit = limitCode(startingIndex - cursor->index);
+        } else {
+            limit = limitCode(startingIndex);
+        }
     } else {
-        // Use recursive container search
-        const std::string retrievalSelect = fmt::format("DISTINCT {} {}", sql_search_columns, addColumns);
-        retrievalSQL = fmt::format(sql_search_container_query_format, param.getContainerID(), retrievalSelect);
-        retrievalSQL += fmt::format(" {} {} WHERE {}{}{}", addJoin, sql.second, searchSQL, orderBy, limit);
+        limit = limitCode(startingIndex);
     }
+    log_vdebug("limitCode {}", limit);
+
+    std::string retrievalSQL = retrievalCode(searchSQL, limit);
 
     log_debug("Search statement resolves to SQL [\n{}\n]", retrievalSQL);
     beginTransaction("search 2");
-    sqlResult = select(retrievalSQL);
+    sqlResult = preparedSelect(retrievalSQL, params);
     commit("search 2");
 
     std::vector<std::shared_ptr<CdsObject>> result;
     result.reserve(sqlResult->getNumRows());
     std::unique_ptr<SQLRow> row;
+    KeysetValues lastValues;
     while ((row = sqlResult->nextRow())) {
-        result.push_back(createObjectFromSearchRow(param.getGroup(), row));
+        result.push_back(createObjectFromSearchRow(row));
+        if (!keyset.empty())
+            lastValues = getKeysetValues(keyset, row, searchColMap.size());
+    }
+    if (!keyset.empty() && requestedCount > 0 && static_cast<long long>(result.size()) == requestedCount) {
+        cursorCache->store(cursorQuery, { startingIndex + result.size(), std::move(lastValues) }, cursorGeneration);
     }
+    // load metadata and resources of complete page
+    loadObjectDetails(result, param.getGroup(), false);
 
     if (static_cast<long long>(result.size()) < requestedCount) {
         param.setTotalMatches(startingIndex + result.size()); // make sure we do not report too many hits
@@ -1378,33 +1769,148 @@ std::map<int, int> SQLDatabase::getChildCounts(
     if (contId.empty())
         return result;
 
-    auto where = std::vector {
-        fmt::format("{} IN ({})", browseColumnMapper->mapQuoted(BrowseColumn::ParentId, true), fmt::join(contId, ","))
-    };
-    if (containers && !items)
-        where.push_back(browseColumnMapper->getClause(BrowseColumn::ObjectType, OBJECT_TYPE_CONTAINER, true));
-    else if (items && !containers)
-        where.push_back(fmt::format("({0} & {1}) = {1}", browseColumnMapper->mapQuoted(BrowseColumn::ObjectType, true), OBJECT_TYPE_ITEM));
-    if (hideFsRoot && std::find(contId.begin(), contId.end(), CDS_ID_ROOT) != contId.end()) {
-        where.push_back(fmt::format("{} != {:d}", browseColumnMapper->mapQuoted(BrowseColumn::Id, true), CDS_ID_FS_ROOT));
-    }
-
+    // counts are maintained on insert and remove
+    ReadScope readScope(*this);
     beginTransaction("getChildCounts");
-    auto res = select(fmt::format("SELECT {0}, COUNT(*) FROM {1} WHERE {2} GROUP BY {0} ORDER BY {0}",
-        browseColumnMapper->mapQuoted(BrowseColumn::ParentId, true),
+    auto res = select(fmt::format("SELECT {}, {}, {} FROM {} WHERE {} IN ({})",
+        browseColumnMapper->mapQuoted(BrowseColumn::Id, true),
+        identifier(CONTAINER_COUNT_COLUMN),
+        identifier(ITEM_COUNT_COLUMN),
         browseColumnMapper->getTableName(),
-        fmt::join(where, " AND ")));
+        browseColumnMapper->mapQuoted(BrowseColumn::Id, true),
+        fmt::join(contId, ",")));
     commit("getChildCounts");
 
     if (res) {
         std::unique_ptr<SQLRow> row;
         while ((row = res->nextRow())) {
-            result.emplace_hint(result.end(), row->col_int(0, INVALID_OBJECT_ID), row->col_int(1, 0));
+            const int id = row->col_int(0, INVALID_OBJECT_ID);
+            int containerCount = containers ? row->col_int(1, 0) : 0;
+            if (containers && hideFsRoot && id == CDS_ID_ROOT && containerCount > 0)
+                containerCount--;
+            const int count = containerCount + (items ? row->col_int(2, 0) : 0);
+            if (count > 0)
+                result.emplace(id, count);
         }
     }
     return result;
 }
 
+std::size_t SQLDatabase::checkChildCounts(bool repair)
+{
+    auto colParentId = browseColumnMapper->mapQuoted(BrowseColumn::ParentId, true);
+    auto colObjectType = browseColumnMapper->mapQuoted(BrowseColumn::ObjectType, true);
+    auto colContainerCount = identifier(CONTAINER_COUNT_COLUMN);
+    auto colItemCount = identifier(ITEM_COUNT_COLUMN);
+
+    // actual counts of all objects having children
+    std::map<int, std::pair<int, int>> actual;
+    auto res = select(fmt::format("SELECT {0}, SUM(CASE WHEN {1} = {2} THEN 1 ELSE 0 END), SUM(CASE WHEN ({1} & {3}) = {3} THEN 1 ELSE 0 END) FROM {4} GROUP BY {0}",
+        colParentId, colObjectType, OBJECT_TYPE_CONTAINER, OBJECT_TYPE_ITEM, browseColumnMapper->getTableName()));
+    if (!res)
+        throw DatabaseException(fmt::format("error selecting from {}", CDS_OBJECT_TABLE), LINE_MESSAGE);
+    std::unique_ptr<SQLRow> row;
+    while ((row = res->nextRow())) {
+        actual.emplace(row->col_int(0, INVALID_OBJECT_ID), std::pair(row->col_int(1, 0), row->col_int(2, 0)));
+    }
+
+    // stored counts of all objects that have or should have children
+    std::map<int, std::pair<int, int>> stored;
+    res = select(fmt::format("SELECT {0}, {1}, {2} FROM {3} WHERE {1} != 0 OR {2} != 0 OR {0} IN (SELECT DISTINCT {4} FROM {3})",
+        browseColumnMapper->mapQuoted(BrowseColumn::Id, true), colContainerCount, colItemCount, browseColumnMapper->getTableName(), colParentId));
+    if (!res)
+        throw DatabaseException(fmt::format("error selecting from {}", CDS_OBJECT_TABLE), LINE_MESSAGE);
+    while ((row = res->nextRow())) {
+        stored.emplace(row->col_int(0, INVALID_OBJECT_ID), std::pair(row->col_int(1, 0), row->col_int(2, 0)));
+    }
+
+    std::size_t wrongCount = 0;
+    for (auto&& [id, counts] : stored) {
+        auto entry = actual.find(id);
+        auto expected = entry != actual.end() ? entry->second : std::pair(0, 0);
+        if (counts == expected)
+            continue;
+
+        wrongCount++;
+        log_debug("Object {} has child counts {}/{} instead of {}/{}", id, counts.first, counts.second, expected.first, expected.second);
+        if (repair) {
+            execOnly(fmt::format("UPDATE {} SET {} = {}, {} = {} WHERE {} = {}",
+                identifier(CDS_OBJECT_TABLE), colContainerCount, expected.first, colItemCount, expected.second, identifier("id"), id));
+        }
+    }
+    return wrongCount;
+}
+
+std::optional<std::string> SQLDatabase::getChildAncestorPath(int objectID)
+{
+    if (objectID < CDS_ID_ROOT)
+        return "/";
+
+    auto res = select(fmt::format("SELECT {} FROM {} WHERE {}",
+        browseColumnMapper->mapQuoted(BrowseColumn::AncestorPath, true),
+        browseColumnMapper->getTableName(),
+        browseColumnMapper->getClause(BrowseColumn::Id, objectID, true)));
+    std::unique_ptr<SQLRow> row;
+    if (!res || !(row = res->nextRow()) || row->isNullOrEmpty(0))
+        return std::nullopt;
+    return fmt::format("{}{}/", row->col(0), objectID);
+}
+
+std::string SQLDatabase::getSubtreeClause(const std::string& ancestorPath) const
+{
+    // all paths starting with "/1/2/" sort before "/1/20", '0' follows '/'
+    auto upperBound = ancestorPath;
+    upperBound.back() = '0';
+    return fmt::format("{0} >= {1} AND {0} < {2}", browseColumnMapper->mapQuoted(BrowseColumn::AncestorPath, true), quote(ancestorPath), quote(upperBound));
+}
+
+std::string SQLDatabase::concatSql(const std::string& left, const std::string& right) const
+{
+    return fmt::format("{} || {}", left, right);
+}
+
+void SQLDatabase::_moveAncestorPath(int objectID, const std::optional<std::string>& oldPath, int parentID)
+{
+    auto newPath = getChildAncestorPath(parentID);
+    auto colAncestorPath = browseColumnMapper->mapQuoted(BrowseColumn::AncestorPath, true);
+    execOnly(fmt::format("UPDATE {} SET {} = {} WHERE {}",
+        browseColumnMapper->getTableName(), colAncestorPath,
+        newPath ? quote(*newPath) : SQL_NULL,
+        browseColumnMapper->getClause(BrowseColumn::Id, objectID, true)));
+    if (!oldPath || !newPath)
+        return;
+
+    // replace prefix of all descendants
+    auto oldPrefix = fmt::format("{}{}/", *oldPath, objectID);
+    auto newPrefix = fmt::format("{}{}/", *newPath, objectID);
+    execOnly(fmt::format("UPDATE {} SET {} = {} WHERE {}",
+        browseColumnMapper->getTableName(), colAncestorPath,
+        concatSql(quote(newPrefix), fmt::format("SUBSTR({}, {})", colAncestorPath, oldPrefix.size() + 1)),
+        getSubtreeClause(oldPrefix)));
+}
+
+void SQLDatabase::_changeChildCounts(int parentID, unsigned int objectType, int delta)
+{
+    if (objectType == OBJECT_TYPE_CONTAINER)
+        _changeChildCounts(parentID, delta, 0);
+    else if ((objectType & OBJECT_TYPE_ITEM) == OBJECT_TYPE_ITEM)
+        _changeChildCounts(parentID, 0, delta);
+}
+
+void SQLDatabase::_changeChildCounts(int parentID, int containerDelta, int itemDelta)
+{
+    if (containerDelta == 0 && itemDelta == 0)
+        return;
+
+    auto colContainerCount = identifier(CONTAINER_COUNT_COLUMN);
+    auto colItemCount = identifier(ITEM_COUNT_COLUMN);
+    execOnly(fmt::format("UPDATE {} SET {} = {} + ({}), {} = {} + ({}) WHERE {} = {}",
+        identifier(CDS_OBJECT_TABLE),
+        colContainerCount, colContainerCount, containerDelta,
+        colItemCount, colItemCount, itemDelta,
+        identifier("id"), parentID));
+}
+
 std::vector<std::string> SQLDatabase::getMimeTypes()
 {
     beginTransaction("getMimeTypes");
@@ -1451,10 +1957,7 @@ std::map<std::string, std::shared_ptr<CdsContainer>> SQLDatabase::getShortcuts()
     return result;
 }
 
-std::shared_ptr<CdsObject> SQLDatabase::findObjectByPath(
-    const fs::path& fullpath,
-    const std::string& group,
-    DbFileType fileType)
+std::pair<std::string, std::vector<SQLParam>> SQLDatabase::getPathClause(const fs::path& fullpath, DbFileType fileType, std::string& entryTypes) const
 {
     std::vector<int> et;
     switch (fileType) {
@@ -1496,26 +1999,34 @@ std::shared_ptr<CdsObject> SQLDatabase::findObjectByPath(
         break;
     }
     auto where = std::vector {
-        browseColumnMapper->getClause(BrowseColumn::LocationHash, quote(stringHash(fullpath.c_str()))),
-        browseColumnMapper->getClause(BrowseColumn::Location, quote(fullpath)),
+        browseColumnMapper->getClause(BrowseColumn::LocationHash, "?"),
+        browseColumnMapper->getClause(BrowseColumn::Location, "?"),
+        fmt::format("{} IN ({})", browseColumnMapper->mapQuoted(BrowseColumn::EntryType), fmt::join(et, ",")),
     };
-    where.push_back(fmt::format("{} IN ({})", browseColumnMapper->mapQuoted(BrowseColumn::EntryType), fmt::join(et, ",")));
-
-    auto countSQL = fmt::format("SELECT COUNT(*) FROM {} WHERE {}", sql_browse_query, fmt::join(where, " AND "));
+    entryTypes = fmt::format("{}", fmt::join(et, ","));
+    // prefer the physical object over references with the same location
+    return {
+        fmt::format("{} ORDER BY {} IS NULL DESC LIMIT 1", fmt::join(where, " AND "), browseColumnMapper->mapQuoted(BrowseColumn::RefId)),
+        { static_cast<long long>(stringHash(fullpath.c_str())), fullpath.string() },
+    };
+}
 
-    beginTransaction("countFind");
-    auto sqlResult = select(countSQL);
-    commit("countFind");
+std::shared_ptr<CdsObject> SQLDatabase::findObjectByPath(
+    const fs::path& fullpath,
+    const std::string& group,
+    DbFileType fileType)
+{
+    std::string entryTypes;
+    auto [where, params] = getPathClause(fullpath, fileType, entryTypes);
 
-    auto countRow = sqlResult->nextRow();
-    if (countRow && countRow->col_int(0, 0) > 1) {
-        where.push_back(fmt::format("{} IS NULL", browseColumnMapper->mapQuoted(BrowseColumn::RefId)));
-    }
+    auto cached = getCachedPathObject(fullpath, entryTypes, group);
+    if (cached)
+        return cached;
 
-    auto findSql = fmt::format("SELECT {} FROM {} WHERE {} LIMIT 1", sql_browse_columns, sql_browse_query, fmt::join(where, " AND "));
+    auto findSql = fmt::format("SELECT {} FROM {} WHERE {}", sql_browse_columns, sql_browse_query, where);
 
     beginTransaction("findObjectByPath");
-    auto res = select(findSql);
+    auto res = preparedSelect(findSql, params);
     log_debug("{} -> res={} ({})", findSql, !!res, res ? res->getNumRows() : -1);
     if (!res) {
         commit("findObjectByPath");
@@ -1523,8 +2034,10 @@ std::shared_ptr<CdsObject> SQLDatabase::findObjectByPath(
     }
     auto row = res->nextRow();
     if (row) {
-        auto result = createObjectFromRow(group, row);
+        auto result = createObjectFromRow(row);
+        loadObjectDetails({ result }, group, true);
         commit("findObjectByPath");
+        pathCache->put(fullpath.string(), entryTypes, result->getID());
         return result;
     }
 
@@ -1532,6 +2045,81 @@ std::shared_ptr<CdsObject> SQLDatabase::findObjectByPath(
     return nullptr;
 }
 
+int SQLDatabase::findObjectIdByPath(
+    const fs::path& fullpath,
+    DbFileType fileType)
+{
+    std::string entryTypes;
+    auto [where, params] = getPathClause(fullpath, fileType, entryTypes);
+
+    auto cached = getCachedPathObject(fullpath, entryTypes, UNUSED_CLIENT_GROUP);
+    if (cached)
+        return cached->getID();
+
+    int objectID = INVALID_OBJECT_ID;
+    auto findSql = fmt::format("SELECT {} FROM {} WHERE {}", browseColumnMapper->mapQuoted(BrowseColumn::Id), browseColumnMapper->tableQuoted(), where);
+
+    beginTransaction("findObjectIdByPath");
+    auto res = preparedSelect(findSql, params);
+    std::unique_ptr<SQLRow> row;
+    if (res && (row = res->nextRow()))
+        objectID = row->col_int(0, INVALID_OBJECT_ID);
+    commit("findObjectIdByPath");
+
+    if (objectID != INVALID_OBJECT_ID)
+        pathCache->put(fullpath.string(), entryTypes, objectID);
+    return objectID;
+}
+
+std::shared_ptr<CdsObject> SQLDatabase::getCachedPathObject(const fs::path& fullpath, const std::string& entryTypes, const std::string& group)
+{
+    auto objectID = pathCache->get(fullpath.string(), entryTypes);
+    if (objectID == INVALID_OBJECT_ID)
+        return nullptr;
+
+    try {
+        auto obj = loadObject(objectID, group);
+        if (obj->getLocation() == fullpath)
+            return obj;
+    } catch (const ObjectNotFoundException&) {
+    }
+    // object was moved, renamed or removed after its location was cached
+    pathCache->erase(fullpath.string(), entryTypes);
+    return nullptr;
+}
+
+std::vector<std::shared_ptr<CdsObject>> SQLDatabase::findObjectsByFileId(
+    const FileId& fileId,
+    DbFileType fileType)
+{
+    std::vector<std::shared_ptr<CdsObject>> result;
+    if (!fileId.isValid())
+        return result;
+
+    auto entryType = fileType == DbFileType::Directory ? CdsEntryType::Directory : CdsEntryType::File;
+    auto where = std::vector {
+        browseColumnMapper->getClause(BrowseColumn::FileInode, "?"),
+        browseColumnMapper->getClause(BrowseColumn::FileDevice, "?"),
+        browseColumnMapper->getClause(BrowseColumn::EntryType, int(entryType)),
+        fmt::format("{} IS NULL", browseColumnMapper->mapQuoted(BrowseColumn::RefId)),
+    };
+    auto findSql = fmt::format("SELECT {} FROM {} WHERE {}", sql_browse_columns, sql_browse_query, fmt::join(where, " AND "));
+
+    beginTransaction("findObjectsByFileId");
+    auto res = preparedSelect(findSql, { static_cast<long long>(fileId.inode), static_cast<long long>(fileId.device) });
+    if (!res) {
+        commit("findObjectsByFileId");
+        throw DatabaseException(fmt::format("error while doing select: {}", findSql), LINE_MESSAGE);
+    }
+    std::unique_ptr<SQLRow> row;
+    while ((row = res->nextRow())) {
+        result.push_back(createObjectFromRow(row));
+    }
+    loadObjectDetails(result, UNUSED_CLIENT_GROUP, true);
+    commit("findObjectsByFileId");
+    return result;
+}
+
 int SQLDatabase::ensurePathExistence(const fs::path& path, int* changedContainer)
 {
     if (changedContainer)
@@ -1540,9 +2128,9 @@ int SQLDatabase::ensurePathExistence(const fs::path& path, int* changedContainer
     if (path == std::string(1, DIR_SEPARATOR))
         return CDS_ID_FS_ROOT;
 
-    auto obj = findObjectByPath(path, UNUSED_CLIENT_GROUP, DbFileType::Directory);
-    if (obj)
-        return obj->getID();
+    auto objectID = findObjectIdByPath(path, DbFileType::Directory);
+    if (objectID != INVALID_OBJECT_ID)
+        return objectID;
 
     int parentID = ensurePathExistence(path.parent_path(), changedContainer);
 
@@ -1594,9 +2182,12 @@ int SQLDatabase::createContainer(
         { BrowseColumn::RefId, (refID > CDS_ID_ROOT) ? quote(refID) : SQL_NULL },
     };
     beginTransaction("createContainer");
+    auto ancestorPath = getChildAncestorPath(parentID);
+    dict.emplace(BrowseColumn::AncestorPath, ancestorPath ? quote(*ancestorPath) : SQL_NULL);
     Object2Table ot(std::move(dict), Operation::Insert, browseColumnMapper);
     int newId = exec(ot.sqlForInsert(nullptr), browseColumnMapper->mapQuoted(BrowseColumn::Id, true)); // get last id#
     log_debug("Created object row, id: {}", newId);
+    _changeChildCounts(parentID, 1, 0);
 
     const std::string newIdStr = quote(newId);
     if (!itemMetadata.empty()) {
@@ -1643,6 +2234,7 @@ int SQLDatabase::createContainer(
         log_debug("Wrote resources for cds_object {}", newId);
     }
     commit("createContainer");
+    cursorCache->clear();
 
     return newId;
 }
@@ -1735,9 +2327,7 @@ bool SQLDatabase::addContainer(
     return true;
 }
 
-std::shared_ptr<CdsObject> SQLDatabase::createObjectFromRow(
-    const std::string& group,
-    const std::unique_ptr<SQLRow>& row)
+std::shared_ptr<CdsObject> SQLDatabase::createObjectFromRow(const std::unique_ptr<SQLRow>& row)
 {
     auto entryType = CdsEntryType(std::stoi(getCol(row, BrowseColumn::EntryType)));
     int objectType = std::stoi(getCol(row, BrowseColumn::ObjectType));
@@ -1755,36 +2345,14 @@ std::shared_ptr<CdsObject> SQLDatabase::createObjectFromRow(
     obj->setEntryType(entryType);
     obj->setMTime(std::chrono::seconds(stoulString(getCol(row, BrowseColumn::LastModified))));
     obj->setUTime(std::chrono::seconds(stoulString(getCol(row, BrowseColumn::LastUpdated))));
-
-    // handle metadata
-    auto metaData = retrieveMetaDataForObject(obj->getID());
-    if (!metaData.empty()) {
-        obj->setMetaData(std::move(metaData));
-    } else if (obj->getRefID() != CDS_ID_ROOT) {
-        metaData = retrieveMetaDataForObject(obj->getRefID());
-        if (!metaData.empty())
-            obj->setMetaData(std::move(metaData));
-    }
+    obj->setFileId({ static_cast<std::uint64_t>(stolString(getCol(row, BrowseColumn::FileDevice))), static_cast<std::uint64_t>(stolString(getCol(row, BrowseColumn::FileInode))) });
+    obj->setSizeOnDisk(static_cast<std::uintmax_t>(stolString(getCol(row, BrowseColumn::FileSize))));
 
     // handle aux data
     std::string auxdataStr = fallbackString(getCol(row, BrowseColumn::Auxdata), getCol(row, BrowseColumn::RefAuxdata));
     std::map<std::string, std::string> aux = URLUtils::dictDecode(auxdataStr);
     obj->setAuxData(aux);
 
-    // handle resources
-    bool resourceZeroOk = false;
-    auto resources = retrieveResourcesForObject(obj->getID());
-    if (!resources.empty()) {
-        resourceZeroOk = true;
-        obj->setResources(std::move(resources));
-    } else if (obj->getRefID() != CDS_ID_ROOT) {
-        resources = retrieveResourcesForObject(obj->getRefID());
-        if (!resources.empty()) {
-            resourceZeroOk = true;
-            obj->setResources(std::move(resources));
-        }
-    }
-
     obj->setVirtual(entryType == CdsEntryType::VirtualContainer || entryType == CdsEntryType::VirtualItem || entryType == CdsEntryType::ExternalUrl);
 
     bool matchedType = false;
@@ -1807,9 +2375,6 @@ std::shared_ptr<CdsObject> SQLDatabase::createObjectFromRow(
             cont->setAutoscanType(AutoscanType::None);
         matchedType = true;
     } else if (obj->isItem()) {
-        if (!resourceZeroOk)
-            throw DatabaseException("tried to create object without at least one resource", LINE_MESSAGE);
-
         // set item properties
         auto item = std::static_pointer_cast<CdsItem>(obj);
         item->setMimeType(fallbackString(getCol(row, BrowseColumn::MimeType), getCol(row, BrowseColumn::RefMimeType)));
@@ -1827,12 +2392,6 @@ std::shared_ptr<CdsObject> SQLDatabase::createObjectFromRow(
             item->setServiceID(getCol(row, BrowseColumn::RefServiceId));
         else
             item->setServiceID(getCol(row, BrowseColumn::ServiceId));
-
-        if (!group.empty()) {
-            auto playStatus = getPlayStatus(group, obj->getID());
-            if (playStatus)
-                item->setPlayStatus(playStatus);
-        }
         matchedType = true;
     }
 
@@ -1843,7 +2402,7 @@ std::shared_ptr<CdsObject> SQLDatabase::createObjectFromRow(
     return obj;
 }
 
-std::shared_ptr<CdsObject> SQLDatabase::createObjectFromSearchRow(const std::string& group, const std::unique_ptr<SQLRow>& row)
+std::shared_ptr<CdsObject> SQLDatabase::createObjectFromSearchRow(const std::unique_ptr<SQLRow>& row)
 {
     auto entryType = CdsEntryType(std::stoi(getCol(row, SearchColumn::EntryType)));
     int objectType = std::stoi(getCol(row, SearchColumn::ObjectType));
@@ -1861,40 +2420,14 @@ std::shared_ptr<CdsObject> SQLDatabase::createObjectFromSearchRow(const std::str
     obj->setSource(ObjectSource(std::stoi(getCol(row, SearchColumn::Source))));
     obj->setEntryType(entryType);
 
-    // handle metadata
-    auto metaData = retrieveMetaDataForObject(obj->getID());
-    if (!metaData.empty())
-        obj->setMetaData(std::move(metaData));
-
-    // handle resources
-    bool resourceZeroOk = false;
-    auto resources = retrieveResourcesForObject(obj->getID());
-    if (!resources.empty()) {
-        resourceZeroOk = true;
-        obj->setResources(std::move(resources));
-    } else if (obj->getRefID() != CDS_ID_ROOT) {
-        resources = retrieveResourcesForObject(obj->getRefID());
-        if (!resources.empty()) {
-            resourceZeroOk = true;
-            obj->setResources(std::move(resources));
-        }
-    }
-
     obj->setLocation(getCol(row, SearchColumn::Location), entryType);
     if (obj->isItem()) {
         // set item properties
-        if (!resourceZeroOk)
-            throw DatabaseException("tried to create object without at least one resource", LINE_MESSAGE);
-
         auto item = std::static_pointer_cast<CdsItem>(obj);
         item->setMimeType(getCol(row, SearchColumn::MimeType));
 
         item->setPartNumber(stoiString(getCol(row, SearchColumn::PartNumber)));
         item->setTrackNumber(stoiString(getCol(row, SearchColumn::TrackNumber)));
-
-        auto playStatus = getPlayStatus(group, obj->getID());
-        if (playStatus)
-            item->setPlayStatus(playStatus);
     } else if (!obj->isContainer()) {
         throw DatabaseException(fmt::format("Unknown object type: {}", objectType), LINE_MESSAGE);
     }
@@ -1902,22 +2435,109 @@ std::shared_ptr<CdsObject> SQLDatabase::createObjectFromSearchRow(const std::str
     return obj;
 }
 
-std::vector<std::pair<std::string, std::string>> SQLDatabase::retrieveMetaDataForObject(int objectId)
+void SQLDatabase::loadObjectDetails(
+    const std::vector<std::shared_ptr<CdsObject>>& objects,
+    const std::string& group,
+    bool refMetaData)
 {
-    auto query = fmt::format("{} FROM {} WHERE {}",
-        sql_meta_query,
-        metaColumnMapper->getTableName(),
-        metaColumnMapper->getClause(MetadataColumn::ItemId, quote(objectId), true));
-    auto res = select(query);
-    if (!res)
-        return {};
+    if (objects.empty())
+        return;
 
-    std::vector<std::pair<std::string, std::string>> metaData;
-    metaData.reserve(res->getNumRows());
+    std::vector<int> objectIds;
+    objectIds.reserve(objects.size());
+    for (auto&& obj : objects) {
+        objectIds.push_back(obj->getID());
+    }
 
-    std::unique_ptr<SQLRow> row;
-    while ((row = res->nextRow())) {
-        metaData.emplace_back(getCol(row, MetadataColumn::PropertyName), getCol(row, MetadataColumn::PropertyValue));
+    // handle metadata, referenced objects are only loaded if required
+    auto metaData = retrieveMetaDataForObjects(objectIds);
+    if (refMetaData) {
+        std::vector<int> refIds;
+        for (auto&& obj : objects) {
+            if (obj->getRefID() != CDS_ID_ROOT && metaData.find(obj->getID()) == metaData.end() && metaData.find(obj->getRefID()) == metaData.end())
+                refIds.push_back(obj->getRefID());
+        }
+        if (!refIds.empty())
+            metaData.merge(retrieveMetaDataForObjects(refIds));
+    }
+
+    // handle resources
+    auto resources = retrieveResourcesForObjects(objectIds);
+    {
+        std::vector<int> refIds;
+        for (auto&& obj : objects) {
+            if (obj->getRefID() != CDS_ID_ROOT && resources.find(obj->getID()) == resources.end() && resources.find(obj->getRefID()) == resources.end())
+                refIds.push_back(obj->getRefID());
+        }
+        if (!refIds.empty())
+            resources.merge(retrieveResourcesForObjects(refIds));
+    }
+
+    // handle play status of items
+    std::map<int, std::shared_ptr<ClientStatusDetail>> playStatus;
+    if (!group.empty()) {
+        std::vector<int> itemIds;
+        for (auto&& obj : objects) {
+            if (obj->isItem())
+                itemIds.push_back(obj->getID());
+        }
+        playStatus = retrievePlayStatusForObjects(group, itemIds);
+    }
+
+    for (auto&& obj : objects) {
+        auto metaEntry = metaData.find(obj->getID());
+        if (metaEntry == metaData.end() && refMetaData && obj->getRefID() != CDS_ID_ROOT)
+            metaEntry = metaData.find(obj->getRefID());
+        if (metaEntry != metaData.end())
+            obj->setMetaData(metaEntry->second);
+
+        bool resourceZeroOk = false;
+        auto resEntry = resources.find(obj->getID());
+        if (resEntry != resources.end()) {
+            resourceZeroOk = true;
+            obj->setResources(resEntry->second);
+        } else if (obj->getRefID() != CDS_ID_ROOT && (resEntry = resources.find(obj->getRefID())) != resources.end()) {
+            // resources of referenced object may be shared by several objects on the page
+            std::vector<std::shared_ptr<CdsResource>> refResources;
+            refResources.reserve(resEntry->second.size());
+            for (auto&& resource : resEntry->second) {
+                auto refResource = resource->clone();
+                refResource->setResId(resource->getResId());
+                refResources.push_back(std::move(refResource));
+            }
+            resourceZeroOk = true;
+            obj->setResources(std::move(refResources));
+        }
+
+        if (obj->isItem()) {
+            if (!resourceZeroOk)
+                throw DatabaseException("tried to create object without at least one resource", LINE_MESSAGE);
+
+            auto statusEntry = playStatus.find(obj->getID());
+            if (statusEntry != playStatus.end())
+                std::static_pointer_cast<CdsItem>(obj)->setPlayStatus(statusEntry->second);
+        }
+    }
+}
+
+std::map<int, std::vector<std::pair<std::string, std::string>>> SQLDatabase::retrieveMetaDataForObjects(const std::vector<int>& objectIds)
+{
+    std::map<int, std::vector<std::pair<std::string, std::string>>> metaData;
+    for (std::size_t start = 0; start < objectIds.size(); start += MAX_LOAD_BATCH_SIZE) {
+        auto params = getBatchParams(objectIds, start);
+        auto query = fmt::format("{} FROM {} WHERE {} IN ({})",
+            sql_meta_query,
+            metaColumnMapper->getTableName(),
+            metaColumnMapper->mapQuoted(MetadataColumn::ItemId, true),
+            fmt::join(std::vector<std::string_view>(params.size(), "?"), ","));
+        auto res = preparedSelect(query, params);
+        if (!res)
+            continue;
+
+        std::unique_ptr<SQLRow> row;
+        while ((row = res->nextRow())) {
+            metaData[std::stoi(getCol(row, MetadataColumn::ItemId))].emplace_back(getCol(row, MetadataColumn::PropertyName), getCol(row, MetadataColumn::PropertyValue));
+        }
     }
     return metaData;
 }
@@ -2025,6 +2645,7 @@ std::string SQLDatabase::incrementUpdateIDs(const std::unordered_set<int>& ids)
         throw DatabaseException("Error while fetching update ids", LINE_MESSAGE);
     }
     commit("incrementUpdateIDs 2");
+    invalidateCachedObjects(std::vector<int>(ids.begin(), ids.end()));
 
     std::unique_ptr<SQLRow> row;
     std::vector<std::string> rows;
@@ -2212,9 +2833,32 @@ void SQLDatabase::_removeObjects(const std::vector<std::int32_t>& objectIDs)
         }
     }
 
+    // update counts of remaining parents, references are removed by cascade
+    auto colId = browseColumnMapper->mapQuoted(BrowseColumn::Id, true);
+    auto colParentId = browseColumnMapper->mapQuoted(BrowseColumn::ParentId, true);
+    auto colObjectType = browseColumnMapper->mapQuoted(BrowseColumn::ObjectType, true);
+    res = select(fmt::format("SELECT {0}, {1}, COUNT(*) FROM {2} WHERE ({3} IN ({5}) OR {4} IN ({5})) AND {0} NOT IN ({5}) GROUP BY {0}, {1}",
+        colParentId,
+        colObjectType,
+        browseColumnMapper->getTableName(),
+        colId,
+        browseColumnMapper->mapQuoted(BrowseColumn::RefId, true),
+        fmt::join(objectIDs, ",")));
+    if (res) {
+        std::vector<std::tuple<int, unsigned int, int>> removedChildren;
+        std::unique_ptr<SQLRow> row;
+        while ((row = res->nextRow())) {
+            removedChildren.emplace_back(row->col_int(0, INVALID_OBJECT_ID), row->col_int(1, 0), row->col_int(2, 0));
+        }
+        for (auto&& [parentID, objectType, count] : removedChildren)
+            _changeChildCounts(parentID, objectType, -count);
+    }
+
     deleteRows(CDS_OBJECT_TABLE, "id", objectIDs);
     del(RESOURCE_TABLE, fmt::format("{} IN ('{}')", identifier(EnumMapper::getAttributeName(ResourceAttribute::FANART_OBJ_ID)), fmt::join(objectIDs, "','")), objectIDs);
     commit("_removeObjects");
+    invalidateCachedObjects(objectIDs);
+    cursorCache->clear();
 }
 
 std::unique_ptr<Database::ChangedContainers> SQLDatabase::removeObject(int objectID, const fs::path& path, bool all)
@@ -2251,8 +2895,12 @@ std::unique_ptr<Database::ChangedContainers> SQLDatabase::removeObject(int objec
         itemIds.push_back(objectID);
     }
     auto changedContainers = _recursiveRemove(itemIds, containerIds, all);
-    if (!path.empty())
+    if (!path.empty()) {
         del(RESOURCE_TABLE, fmt::format("{} = {}", identifier(EnumMapper::getAttributeName(ResourceAttribute::RESOURCE_FILE)), quote(path.string())), {});
+        // owners of the removed resources are unknown
+        if (objectCache)
+            objectCache->clear();
+    }
     return _purgeEmptyContainers(changedContainers);
 }
 
@@ -2645,13 +3293,14 @@ std::shared_ptr<ClientStatusDetail> SQLDatabase::getPlayStatus(const std::string
         fields.push_back(fmt::format("{}", playstatusColumnMapper->mapQuoted(key)));
     }
     std::vector<std::string> where {
-        playstatusColumnMapper->getClause(PlaystatusColumn::Group, quote(group)),
-        playstatusColumnMapper->getClause(PlaystatusColumn::ItemId, quote(objectId)),
+        playstatusColumnMapper->getClause(PlaystatusColumn::Group, "?"),
+        playstatusColumnMapper->getClause(PlaystatusColumn::ItemId, "?"),
     };
-    auto res = select(fmt::format("SELECT {} FROM {} WHERE {}",
-        fmt::join(fields, ", "),
-        playstatusColumnMapper->tableQuoted(),
-        fmt::join(where, " AND ")));
+    auto res = preparedSelect(fmt::format("SELECT {} FROM {} WHERE {}",
+                                  fmt::join(fields, ", "),
+                                  playstatusColumnMapper->tableQuoted(),
+                                  fmt::join(where, " AND ")),
+        { group, objectId });
     if (!res)
         return {};
 
@@ -2670,6 +3319,44 @@ std::shared_ptr<ClientStatusDetail> SQLDatabase::getPlayStatus(const std::string
     return {};
 }
 
+std::map<int, std::shared_ptr<ClientStatusDetail>> SQLDatabase::retrievePlayStatusForObjects(const std::string& group, const std::vector<int>& objectIds)
+{
+    std::vector<std::string> fields;
+    fields.reserve(playstatusColMap.size());
+    for (auto&& [key, col] : playstatusColMap) {
+        fields.push_back(fmt::format("{}", playstatusColumnMapper->mapQuoted(key)));
+    }
+
+    std::map<int, std::shared_ptr<ClientStatusDetail>> result;
+    for (std::size_t start = 0; start < objectIds.size(); start += MAX_LOAD_BATCH_SIZE) {
+        auto params = getBatchParams(objectIds, start);
+        auto query = fmt::format("SELECT {} FROM {} WHERE {} AND {} IN ({})",
+            fmt::join(fields, ", "),
+            playstatusColumnMapper->tableQuoted(),
+            playstatusColumnMapper->getClause(PlaystatusColumn::Group, "?"),
+            playstatusColumnMapper->mapQuoted(PlaystatusColumn::ItemId),
+            fmt::join(std::vector<std::string_view>(params.size(), "?"), ","));
+        params.insert(params.begin(), group);
+        auto res = preparedSelect(query, params);
+        if (!res)
+            continue;
+
+        std::unique_ptr<SQLRow> row;
+        while ((row = res->nextRow())) {
+            auto itemId = getColInt(row, PlaystatusColumn::ItemId, INVALID_OBJECT_ID);
+            result[itemId] = std::make_shared<ClientStatusDetail>(
+                getCol(row, PlaystatusColumn::Group),
+                itemId,
+                getColInt(row, PlaystatusColumn::PlayCount, 0),
+                getColInt(row, PlaystatusColumn::LastPlayed, 0),
+                getColInt(row, PlaystatusColumn::LastPlayedPosition, 0),
+                getColInt(row, PlaystatusColumn::BookMarkPosition, 0));
+        }
+    }
+    log_debug("Loaded {} of {} items from {}", result.size(), objectIds.size(), PLAYSTATUS_TABLE);
+    return result;
+}
+
 std::vector<std::shared_ptr<ClientStatusDetail>> SQLDatabase::getPlayStatusList(int objectId)
 {
     std::vector<std::string> fields;
@@ -2741,6 +3428,9 @@ void SQLDatabase::savePlayStatus(const std::shared_ptr<ClientStatusDetail>& deta
     }
 
     commit("savePlayStatus");
+    // play status is not part of any sort key, so cursors stay valid
+    if (objectCache)
+        objectCache->updatePlayStatus(detail);
 }
 
 std::vector<std::map<std::string, std::string>> SQLDatabase::getClientGroupStats()
@@ -2835,6 +3525,9 @@ void SQLDatabase::updateAutoscanList(AutoscanScanMode scanmode, const std::share
     at = Autoscan2Table(dict, Operation::Delete, autoscanColumnMapper);
     del(AUTOSCAN_TABLE, at.sqlForDeleteAll(whereDict), {});
     commit("updateAutoscanList delete");
+    // autoscan type of untouched containers was reset
+    if (objectCache)
+        objectCache->clear();
 }
 
 std::shared_ptr<AutoscanList> SQLDatabase::getAutoscanList(AutoscanScanMode scanmode)
@@ -2970,6 +3663,7 @@ void SQLDatabase::addAutoscanDirectory(const std::shared_ptr<AutoscanDirectory>&
     }
     Autoscan2Table at(fields, Operation::Insert, autoscanColumnMapper);
     adir->setDatabaseID(exec(at.sqlForInsert(adir), autoscanColumnMapper->mapQuoted(AutoscanColumn::ObjId, true)));
+    invalidateCachedObjects({ objectID });
 }
 
 void SQLDatabase::updateAutoscanDirectory(const std::shared_ptr<AutoscanDirectory>& adir)
@@ -3013,6 +3707,7 @@ void SQLDatabase::updateAutoscanDirectory(const std::shared_ptr<AutoscanDirector
     }
     Autoscan2Table at(fields, Operation::Update, autoscanColumnMapper);
     execOnTable(AUTOSCAN_TABLE, at.sqlForUpdate(adir), adir->getDatabaseID());
+    invalidateCachedObjects({ objectID });
 }
 
 void SQLDatabase::removeAutoscanDirectory(const std::shared_ptr<AutoscanDirectory>& adir)
@@ -3060,6 +3755,7 @@ void SQLDatabase::_autoscanChangePersistentFlag(int objectID, bool persistent)
     };
     auto ot = Object2Table(std::move(dict), Operation::Update, browseColumnMapper);
     exec(ot.sqlForUpdate(nullptr));
+    invalidateCachedObjects({ objectID });
 }
 
 void SQLDatabase::checkOverlappingAutoscans(const std::shared_ptr<AutoscanDirectory>& adir)
@@ -3217,35 +3913,48 @@ void SQLDatabase::generateMetaDataDBOperations(
 
 std::vector<std::shared_ptr<CdsResource>> SQLDatabase::retrieveResourcesForObject(int objectId)
 {
-    auto rsql = fmt::format("{} FROM {} WHERE {} ORDER BY {}",
-        sql_resource_query,
-        resColumnMapper->getTableName(),
-        resColumnMapper->getClause(ResourceColumn::ItemId, objectId, true),
-        resColumnMapper->mapQuoted(ResourceColumn::ResId, true));
-    log_debug("SQLDatabase::retrieveResourcesForObject {}", rsql);
-    auto&& res = select(rsql);
-
-    if (!res)
+    auto resources = retrieveResourcesForObjects({ objectId });
+    auto entry = resources.find(objectId);
+    if (entry == resources.end())
         return {};
+    return std::move(entry->second);
+}
+
+std::map<int, std::vector<std::shared_ptr<CdsResource>>> SQLDatabase::retrieveResourcesForObjects(const std::vector<int>& objectIds)
+{
+    std::map<int, std::vector<std::shared_ptr<CdsResource>>> resources;
+    for (std::size_t start = 0; start < objectIds.size(); start += MAX_LOAD_BATCH_SIZE) {
+        auto params = getBatchParams(objectIds, start);
+        auto rsql = fmt::format("{} FROM {} WHERE {} IN ({}) ORDER BY {}, {}",
+            sql_resource_query,
+            resColumnMapper->getTableName(),
+            resColumnMapper->mapQuoted(ResourceColumn::ItemId, true),
+            fmt::join(std::vector<std::string_view>(params.size(), "?"), ","),
+            resColumnMapper->mapQuoted(ResourceColumn::ItemId, true),
+            resColumnMapper->mapQuoted(ResourceColumn::ResId, true));
+        log_debug("SQLDatabase::retrieveResourcesForObjects {}", rsql);
+        auto&& res = preparedSelect(rsql, params);
+        if (!res)
+            continue;
 
-    std::vector<std::shared_ptr<CdsResource>> resources;
-    resources.reserve(res->getNumRows());
-    std::unique_ptr<SQLRow> row;
-    while ((row = res->nextRow())) {
-        auto resource = std::make_shared<CdsResource>(
-            EnumMapper::remapContentHandler(std::stoi(getCol(row, ResourceColumn::HandlerType))),
-            EnumMapper::remapPurpose(std::stoi(getCol(row, ResourceColumn::Purpose))),
-            getCol(row, ResourceColumn::Options),
-            getCol(row, ResourceColumn::Parameters));
-        resource->setResId(resources.size());
-        for (auto&& resAttrId : ResourceAttributeIterator()) {
-            auto index = to_underlying(ResourceColumn::Attributes) + to_underlying(resAttrId);
-            auto value = row->col_c_str(index);
-            if (value) {
-                resource->addAttribute(resAttrId, value);
+        std::unique_ptr<SQLRow> row;
+        while ((row = res->nextRow())) {
+            auto& itemResources = resources[std::stoi(getCol(row, ResourceColumn::ItemId))];
+            auto resource = std::make_shared<CdsResource>(
+                EnumMapper::remapContentHandler(std::stoi(getCol(row, ResourceColumn::HandlerType))),
+                EnumMapper::remapPurpose(std::stoi(getCol(row, ResourceColumn::Purpose))),
+                getCol(row, ResourceColumn::Options),
+                getCol(row, ResourceColumn::Parameters));
+            resource->setResId(itemResources.size());
+            for (auto&& resAttrId : ResourceAttributeIterator()) {
+                auto index = to_underlying(ResourceColumn::Attributes) + to_underlying(resAttrId);
+                auto value = row->col_c_str(index);
+                if (value) {
+                    resource->addAttribute(resAttrId, value);
+                }
             }
+            itemResources.push_back(std::move(resource));
         }
-        resources.push_back(std::move(resource));
     }
 
     return resources;
@@ -37,10 +37,13 @@
 #include "config/config.h"
 #include "config/config_val.h"
 #include "database.h"
+#include "keyset_cursor.h"
 #include "sql_format.h"
 
 #include <array>
+#include <map>
 #include <mutex>
+#include <optional>
 #include <unordered_set>
 #include <utility>
 
@@ -48,8 +51,11 @@
 template <class Item>
 class AddUpdateTable;
 class CdsContainer;
+class CdsObjectCache;
 class CdsResource;
+class PathIdCache;
 class SQLEmitter;
+class SearchIndex;
 class SQLResult;
 class SQLRow;
 template <class Col>
@@ -59,7 +65,7 @@ enum class ResourceDataType;
 enum class ObjectSource;
 enum class Operation;
 
-#define DBVERSION 29
+#define DBVERSION 32
 #define STRING_LIMIT "GRBMAX"
 
 #define INTERNAL_SETTINGS_TABLE "mt_internal_setting"
@@ -88,24 +94,36 @@ public:
     virtual void beginTransaction(std::string_view tName) { }
     virtual void rollback(std::string_view tName) { }
     virtual void commit(std::string_view tName) { }
+    // hooks for read only operations
+    /// @brief start read only operation, drivers may serve selects of the calling thread from a separate connection
+    virtual void beginRead() { }
+    /// @brief finish read only operation started with beginRead
+    virtual void endRead() { }
 
     virtual void del(std::string_view tableName, const std::string& clause, const std::vector<int>& ids) = 0;
     virtual void execOnTable(std::string_view tableName, const std::string& query, int objId) = 0;
     virtual int exec(const std::string& query, const std::string& getLastInsertId = "") = 0;
     virtual void execOnly(const std::string& query) = 0;
     virtual std::shared_ptr<SQLResult> select(const std::string& query) = 0;
+    /// @brief select with "?" placeholders for all values, drivers without prepared statements get the quoted values inlined
+    /// @param query statement without string literals containing values
+    /// @param params values for the placeholders in order of appearance
+    virtual std::shared_ptr<SQLResult> preparedSelect(const std::string& query, const std::vector<SQLParam>& params);
 
     void addObject(const std::shared_ptr<CdsObject>& obj, int* changedContainer) override;
+    std::vector<int> addObjects(const std::vector<std::shared_ptr<CdsObject>>& objects) override;
     void updateObject(const std::shared_ptr<CdsObject>& obj, int* changedContainer) override;
 
     std::shared_ptr<CdsObject> loadObject(
         int objectID,
         const std::string& group = UNUSED_CLIENT_GROUP) override;
+    std::shared_ptr<CdsObject> loadCachedObject(int objectID, const std::string& group) override;
     std::map<int, int> getChildCounts(
         const std::vector<int>& contId,
         bool containers,
         bool items,
         bool hideFsRoot) override;
+    std::size_t checkChildCounts(bool repair) override;
 
     std::size_t getObjects(
         int parentID,
@@ -139,6 +157,12 @@ public:
         const fs::path& fullpath,
         const std::string& group,
         DbFileType fileType = DbFileType::Auto) override;
+    int findObjectIdByPath(
+        const fs::path& fullpath,
+        DbFileType fileType = DbFileType::Auto) override;
+    std::vector<std::shared_ptr<CdsObject>> findObjectsByFileId(
+        const FileId& fileId,
+        DbFileType fileType) override;
     std::string incrementUpdateIDs(const std::unordered_set<int>& ids) override;
 
     fs::path buildContainerPath(int parentID, const std::string& title) override;
@@ -151,6 +175,7 @@ public:
     /* accounting methods */
     long long getFileStats(const StatsParam& stats) override;
     std::map<std::string, long long> getGroupStats(const StatsParam& stats) override;
+    std::map<std::string, long long> getObjectCacheStats() override;
 
     std::string getInternalSetting(const std::string& key) override;
     void storeInternalSetting(const std::string& key, const std::string& value) override = 0;
@@ -206,8 +231,17 @@ protected:
 
     /// @brief Initial db version with gerbera
     std::size_t firstDBVersion = 1;
+    /// @brief NULL sorts behind all other values in ascending order
+    bool nullsSortLast {};
     /// @brief Maximum length designated as GRBMAX in ddl statement
     unsigned int stringLimit;
+    /// @brief read keyset columns selected behind the object columns
+    static KeysetValues getKeysetValues(const std::vector<KeysetColumn>& keyset, const std::unique_ptr<SQLRow>& row, std::size_t firstColumn);
+    /// @brief build condition for rows sorted behind the cursor values
+    std::string keysetCondition(const std::vector<KeysetColumn>& keyset, const KeysetValues& values, std::vector<SQLParam>& params) const;
+    /// @brief integer sort key of browse results, 1 for containers and 0 for items
+    std::string containerFirstExpression() const;
+
     /// @brief lock for special sql commands
     mutable std::recursive_mutex sqlMutex;
     using SqlAutoLock = std::scoped_lock<decltype(sqlMutex)>;
@@ -215,6 +249,23 @@ protected:
 
     std::shared_ptr<EnumColumnMapper<BrowseColumn>> browseColumnMapper;
 
+    /// @brief calls beginRead and endRead for the lifetime of the object
+    class ReadScope {
+    public:
+        explicit ReadScope(SQLDatabase& database)
+            : database(database)
+        {
+            database.beginRead();
+        }
+        ~ReadScope() { database.endRead(); }
+
+        ReadScope(const ReadScope&) = delete;
+        ReadScope& operator=(const ReadScope&) = delete;
+
+    private:
+        SQLDatabase& database;
+    };
+
     /// @brief constructor for derived classes
     explicit SQLDatabase(const std::shared_ptr<Config>& config, std::shared_ptr<Mime> mime, std::shared_ptr<ConverterManager> converterManager);
 
@@ -236,14 +287,25 @@ protected:
     /// @brief internal version of sql exec command
     virtual void _exec(const std::string& query) = 0;
 
+    /// @brief replace "?" placeholders outside of literals and identifiers by quoted values
+    std::string inlineParams(const std::string& query, const std::vector<SQLParam>& params) const;
+
     /// @brief Get query for unreferenced objects depending on database
     virtual std::string getUnreferencedQuery(const std::string& table);
+    /// @brief Get expression concatenating two string expressions depending on database
+    virtual std::string concatSql(const std::string& left, const std::string& right) const;
+
+    /// @brief create or remove full text index of metadata, has to be called after upgrade
+    void initSearchIndex();
+    /// @brief create or remove database objects of the full text index
+    /// @param enabled index is requested by configuration
+    /// @return index to be used for searches or nullptr if not supported
+    virtual std::shared_ptr<SearchIndex> prepareSearchIndex(bool enabled) { return nullptr; }
 
 private:
     std::string sql_browse_columns;
     std::string sql_browse_query;
     std::string sql_search_columns;
-    std::string sql_search_container_query_format;
     std::string sql_search_query;
     std::string sql_meta_query;
     std::string sql_autoscan_query;
@@ -255,16 +317,44 @@ private:
     bool dynamicContentEnabled;
     /// @brief Is sorting by sort_key enabled in config
     bool sortKeyEnabled;
-
-    std::shared_ptr<CdsObject> createObjectFromRow(const std::string& group, const std::unique_ptr<SQLRow>& row);
-    std::shared_ptr<CdsObject> createObjectFromSearchRow(const std::string& group, const std::unique_ptr<SQLRow>& row);
-    std::vector<std::pair<std::string, std::string>> retrieveMetaDataForObject(int objectId);
+    /// @brief Cache of loaded objects for read only access, nullptr if disabled
+    std::shared_ptr<CdsObjectCache> objectCache;
+
+    /// @brief drop objects from object cache after they were changed
+    void invalidateCachedObjects(const std::vector<int>& objectIds);
+    /// @brief Ids of objects found by location
+    std::shared_ptr<PathIdCache> pathCache;
+    /// @brief get entry types matching fileType and condition for objects at fullpath
+    std::pair<std::string, std::vector<SQLParam>> getPathClause(const fs::path& fullpath, DbFileType fileType, std::string& entryTypes) const;
+    /// @brief load object of cached id if it is still at fullpath, stale entries are dropped
+    std::shared_ptr<CdsObject> getCachedPathObject(const fs::path& fullpath, const std::string& entryTypes, const std::string& group);
+
+    /// @brief Sort keys of the last rows of browse and search pages
+    std::shared_ptr<KeysetCursorCache> cursorCache;
+    /// @brief get keyset column if order is by title or sort key only
+    static std::optional<KeysetColumn> getKeysetColumn(const std::string& orderQb, const std::string& titleColumn, const std::string& sortKeyColumn);
+    static std::vector<std::string> keysetExpressions(const std::vector<KeysetColumn>& keyset);
+    /// @brief serialize query parameters for cursor lookup
+    static std::string joinParams(const std::vector<SQLParam>& params);
+
+    /// @brief create object from browse row without metadata and resources, complete with loadObjectDetails
+    std::shared_ptr<CdsObject> createObjectFromRow(const std::unique_ptr<SQLRow>& row);
+    /// @brief create object from search row without metadata and resources, complete with loadObjectDetails
+    std::shared_ptr<CdsObject> createObjectFromSearchRow(const std::unique_ptr<SQLRow>& row);
+    /// @brief load metadata, resources and play status for all objects of a page with one query per table
+    /// @param refMetaData fall back to metadata of referenced object if object has none
+    void loadObjectDetails(const std::vector<std::shared_ptr<CdsObject>>& objects, const std::string& group, bool refMetaData);
+    std::map<int, std::vector<std::pair<std::string, std::string>>> retrieveMetaDataForObjects(const std::vector<int>& objectIds);
     std::vector<std::shared_ptr<CdsResource>> retrieveResourcesForObject(int objectId);
+    std::map<int, std::vector<std::shared_ptr<CdsResource>>> retrieveResourcesForObjects(const std::vector<int>& objectIds);
+    std::map<int, std::shared_ptr<ClientStatusDetail>> retrievePlayStatusForObjects(const std::string& group, const std::vector<int>& objectIds);
 
+    /// @param ancestorPaths ancestor paths of children by parent id, shared by the objects of a batch insert
     std::vector<std::shared_ptr<AddUpdateTable<CdsObject>>> _addUpdateObject(
         const std::shared_ptr<CdsObject>& obj,
         Operation op,
-        int* changedContainer);
+        int* changedContainer,
+        std::map<int, std::optional<std::string>>* ancestorPaths = nullptr);
 
     void generateMetaDataDBOperations(
         const std::shared_ptr<CdsObject>& obj,
@@ -275,6 +365,17 @@ private:
         Operation op,
         std::vector<std::shared_ptr<AddUpdateTable<CdsObject>>>& operations);
 
+    /// @brief get ancestor path of the children of objectID, std::nullopt if objectID has no path
+    std::optional<std::string> getChildAncestorPath(int objectID);
+    /// @brief condition for all objects with ancestor path starting with ancestorPath
+    std::string getSubtreeClause(const std::string& ancestorPath) const;
+    /// @brief update ancestor path of objectID and its descendants after it was moved to parentID
+    void _moveAncestorPath(int objectID, const std::optional<std::string>& oldPath, int parentID);
+
+    /// @brief add delta to the stored child counts of parentID
+    void _changeChildCounts(int parentID, unsigned int objectType, int delta);
+    void _changeChildCounts(int parentID, int containerDelta, int itemDelta);
+
     /* helper for removeObject(s) */
     void _removeObjects(const std::vector<std::int32_t>& objectIDs);
 
@@ -308,6 +409,7 @@ private:
     static bool remapBool(int field) { return field == 1; }
 
     std::shared_ptr<SQLEmitter> sqlEmitter;
+    void createSqlEmitter(const std::shared_ptr<SearchIndex>& searchIndex);
 
     using AutoLock = std::scoped_lock<std::mutex>;
     friend class SQLMigration;
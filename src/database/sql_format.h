@@ -30,6 +30,12 @@
 #include <fmt/ranges.h>
 #endif
 
+#include <string>
+#include <variant>
+
+/// @brief value bound to a "?" placeholder of a prepared select
+using SQLParam = std::variant<long long, std::string>;
+
 struct SQLIdentifier {
     SQLIdentifier(std::string name, char quote_begin, char quote_end)
         : name(std::move(name))
@@ -33,8 +33,10 @@
 #include "util/logger.h"
 #include "util/url_utils.h"
 
+#include <algorithm>
 #include <fmt/core.h>
 #include <pugixml.hpp>
+#include <unordered_map>
 
 #define RES_COLS "GRB_RES_COLS"
 
@@ -87,6 +89,7 @@ void SQLMigration::upgradeDatabase(
         { "metadata", &SQLMigration::doMetadataMigration },
         { "resources", &SQLMigration::doResourceMigration },
         { "location", &SQLMigration::doLocationMigration },
+        { "ancestor_path", &SQLMigration::doAncestorPathMigration },
     };
 
     auto resourceColumns = splitString(database->getInternalSetting("resource_attribute"), ',');
@@ -327,3 +330,41 @@ void SQLMigration::migrateLocation(int objectId, const std::string& location)
         log_debug("Skipping migration - no location for cds object {}", objectId);
     }
 }
+
+// ancestor path is added in DBVERSION 31
+bool SQLMigration::doAncestorPathMigration()
+{
+    log_info("About to fill ancestor path in {}", CDS_OBJECT_TABLE);
+
+    auto colParentId = browseColumnMapper->mapQuoted(BrowseColumn::ParentId, true);
+    auto res = database->select(fmt::format("SELECT {}, {} FROM {} WHERE {}",
+        browseColumnMapper->mapQuoted(BrowseColumn::Id, true),
+        colParentId,
+        browseColumnMapper->getTableName(),
+        browseColumnMapper->getClause(BrowseColumn::ObjectType, OBJECT_TYPE_CONTAINER, true)));
+    std::unordered_map<int, int> containerParents;
+    std::unique_ptr<SQLRow> row;
+    while ((row = res->nextRow())) {
+        containerParents.emplace(row->col_int(0, INVALID_OBJECT_ID), row->col_int(1, INVALID_OBJECT_ID));
+    }
+
+    // all children of a container share the same ancestor path
+    auto colAncestorPath = browseColumnMapper->mapQuoted(BrowseColumn::AncestorPath, true);
+    database->exec(fmt::format("UPDATE {} SET {} = {} WHERE {} < {}",
+        browseColumnMapper->getTableName(), colAncestorPath, database->quote("/"), colParentId, CDS_ID_ROOT));
+    for (auto&& [containerId, parentId] : containerParents) {
+        std::vector<int> ancestors { containerId };
+        auto parent = containerParents.find(containerId);
+        while (parent != containerParents.end() && parent->second >= CDS_ID_ROOT && ancestors.size() <= containerParents.size()) {
+            ancestors.push_back(parent->second);
+            parent = containerParents.find(parent->second);
+        }
+        std::reverse(ancestors.begin(), ancestors.end());
+        auto ancestorPath = fmt::format("/{}/", fmt::join(ancestors, "/"));
+        database->exec(fmt::format("UPDATE {} SET {} = {} WHERE {}",
+            browseColumnMapper->getTableName(), colAncestorPath, database->quote(ancestorPath),
+            browseColumnMapper->getClause(BrowseColumn::ParentId, containerId, true)));
+    }
+    log_info("Migrated ancestor path - container count: {}", containerParents.size());
+    return true;
+}
@@ -96,6 +96,9 @@ private:
 
     /// @brief migrate a location for cdsObject
     void migrateLocation(int objectId, const std::string& location);
+
+    /// @brief fill ancestor path of all objects (DBVERSION 31)
+    bool doAncestorPathMigration();
 };
 
 #endif
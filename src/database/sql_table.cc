@@ -31,6 +31,8 @@
 #include "upnp/clients.h"
 #include "util/grb_net.h"
 
+#include <algorithm>
+
 const std::vector<BrowseColumn> Object2Table::tableColumnOrder = {
     BrowseColumn::Id,
     BrowseColumn::RefId,
@@ -52,6 +54,10 @@ const std::vector<BrowseColumn> Object2Table::tableColumnOrder = {
     BrowseColumn::ServiceId,
     BrowseColumn::LastModified,
     BrowseColumn::LastUpdated,
+    BrowseColumn::AncestorPath,
+    BrowseColumn::FileDevice,
+    BrowseColumn::FileInode,
+    BrowseColumn::FileSize,
 };
 
 const std::vector<MetadataColumn> Metadata2Table::tableColumnOrder = {
@@ -120,6 +126,33 @@ const std::vector<PlaystatusColumn> Playstatus2Table::tableColumnOrder = {
     PlaystatusColumn::BookMarkPosition,
 };
 
+std::string sqlForInsertRows(const std::string& tableName, const std::vector<InsertRow>& rows)
+{
+    // union of all columns in order of first appearance
+    std::vector<std::string> fields;
+    for (auto&& row : rows) {
+        for (auto&& [field, value] : row) {
+            if (std::find(fields.begin(), fields.end(), field) == fields.end())
+                fields.push_back(field);
+        }
+    }
+
+    std::vector<std::string> tuples;
+    tuples.reserve(rows.size());
+    for (auto&& row : rows) {
+        std::vector<std::string> values(fields.size(), SQL_NULL);
+        for (auto&& [field, value] : row) {
+            values[std::distance(fields.begin(), std::find(fields.begin(), fields.end(), field))] = value;
+        }
+        tuples.push_back(fmt::format("({})", fmt::join(values, ", ")));
+    }
+
+    return fmt::format("INSERT INTO {} ({}) VALUES {}",
+        tableName,
+        fmt::join(fields, ", "),
+        fmt::join(tuples, ", "));
+}
+
 /// @brief Generate INSERT statement from row data and object for object tables
 template <>
 std::string TableAdaptor<BrowseColumn, CdsObject>::sqlForInsert(
@@ -173,33 +206,45 @@ std::string TableAdaptor<MetadataColumn, CdsObject>::sqlForInsert(
         fmt::join(values, ", "));
 }
 
+InsertRow Metadata2Table::getInsertRow(
+    const std::shared_ptr<CdsObject>& obj) const
+{
+    InsertRow row;
+    row.reserve(rowData.size() + (obj ? 1 : 0));
+    if (obj) {
+        row.emplace_back(columnMapper->mapQuoted(MetadataColumn::ItemId, true), fmt::to_string(obj->getID()));
+    }
+    for (auto&& field : getTableColumnOrder()) {
+        if (rowData.find(field) != rowData.end()) {
+            row.emplace_back(columnMapper->mapQuoted(field, true), rowData.at(field));
+        }
+    }
+    return row;
+}
+
 std::string Resource2Table::sqlForInsert(
     const std::shared_ptr<CdsObject>& obj) const
 {
-    std::vector<std::string> fields;
-    std::vector<std::string> values;
-    fields.reserve(rowData.size() + resDict.size() + (obj ? 1 : 0));
-    values.reserve(rowData.size() + resDict.size() + (obj ? 1 : 0));
+    return sqlForInsertRows(columnMapper->getTableName(), { getInsertRow(obj) });
+}
 
+InsertRow Resource2Table::getInsertRow(
+    const std::shared_ptr<CdsObject>& obj) const
+{
+    InsertRow row;
+    row.reserve(rowData.size() + resDict.size() + (obj ? 1 : 0));
     if (obj) {
-        fields.push_back(columnMapper->mapQuoted(ResourceColumn::ItemId, true));
-        values.push_back(fmt::to_string(obj->getID()));
+        row.emplace_back(columnMapper->mapQuoted(ResourceColumn::ItemId, true), fmt::to_string(obj->getID()));
     }
     for (auto&& field : getTableColumnOrder()) {
         if (rowData.find(field) != rowData.end()) {
-            fields.push_back(columnMapper->mapQuoted(field, true));
-            values.push_back(rowData.at(field));
+            row.emplace_back(columnMapper->mapQuoted(field, true), rowData.at(field));
         }
     }
     for (auto&& [key, val] : resDict) {
-        fields.push_back(columnMapper->quote(EnumMapper::getAttributeName(key)));
-        values.push_back(val);
+        row.emplace_back(columnMapper->quote(EnumMapper::getAttributeName(key)), val);
     }
-
-    return fmt::format("INSERT INTO {} ({}) VALUES ({})",
-        columnMapper->getTableName(),
-        fmt::join(fields, ", "),
-        fmt::join(values, ", "));
+    return row;
 }
 
 std::string Resource2Table::sqlForUpdate(
@@ -36,6 +36,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 // forward declarations
@@ -105,6 +106,10 @@ enum class BrowseColumn {
     ServiceId,
     LastModified,
     LastUpdated,
+    AncestorPath,
+    FileDevice,
+    FileInode,
+    FileSize,
     RefUpnpClass,
     RefLocation,
     RefAuxdata,
@@ -168,6 +173,12 @@ enum class PlaystatusColumn {
     BookMarkPosition,
 };
 
+/// @brief quoted column names and values of a row to insert
+using InsertRow = std::vector<std::pair<std::string, std::string>>;
+
+/// @brief Generate one INSERT statement for rows of the same table, columns missing in a row are set to NULL
+std::string sqlForInsertRows(const std::string& tableName, const std::vector<InsertRow>& rows);
+
 /// @brief base helper class for insert, update and delete operations
 template <class Item>
 class AddUpdateTable {
@@ -201,6 +212,12 @@ public:
     virtual std::string sqlForMultiInsert(
         const std::shared_ptr<Item>& obj) const
         = 0;
+    /// @brief Get columns and values of the inserted row to combine rows of several objects
+    virtual InsertRow getInsertRow(
+        const std::shared_ptr<Item>& obj) const
+    {
+        throw DatabaseException(fmt::format("{} does not support combined inserts", tableName), LINE_MESSAGE);
+    }
     /// @brief Generate UPDATE statement from row data and object
     virtual std::string sqlForUpdate(
         const std::shared_ptr<Item>& obj) const
@@ -309,6 +326,8 @@ public:
         : TableAdaptor(METADATA_TABLE, std::move(dict), std::move(columnMapper))
     {
     }
+    InsertRow getInsertRow(
+        const std::shared_ptr<CdsObject>& obj) const override;
 
 protected:
     bool isValid() const override { return rowData.size() == 2 || (operation == Operation::Delete && rowData.empty()); }
@@ -339,6 +358,8 @@ public:
         const std::shared_ptr<CdsObject>& obj) const override;
     std::string sqlForUpdate(
         const std::shared_ptr<CdsObject>& obj) const override;
+    InsertRow getInsertRow(
+        const std::shared_ptr<CdsObject>& obj) const override;
 
 protected:
     const std::vector<ResourceColumn>& getTableColumnOrder() const override
@@ -0,0 +1,112 @@
+/*GRB*
+    Gerbera - https://gerbera.io/
+
+    sl_pool.cc - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file database/sqlite3/sl_pool.cc
+/// @brief Implementation of the Sqlite3ReadConnection and Sqlite3ReadPool classes.
+#define GRB_LOG_FAC GrbLogFacility::sqlite3
+
+#include "sl_pool.h" // API
+
+#include "exceptions.h"
+#include "sl_statement.h"
+#include "util/logger.h"
+
+#include <sqlite3.h>
+
+#define SQLITE3_READ_BUSY_TIMEOUT 1000 // wait for wal recovery of writer in ms
+
+/* Sqlite3ReadConnection */
+
+Sqlite3ReadConnection::Sqlite3ReadConnection(const fs::path& dbFilePath, std::size_t statementCacheSize)
+    : statementCache(std::make_shared<Sqlite3StatementCache>(statementCacheSize))
+{
+    int res = sqlite3_open_v2(dbFilePath.c_str(), &db, SQLITE_OPEN_READONLY, nullptr);
+    if (res != SQLITE_OK) {
+        auto msg = fmt::format("Sqlite3ReadConnection: could not open '{}' read only: {}", dbFilePath.c_str(), sqlite3_errstr(res));
+        sqlite3_close_v2(db);
+        db = nullptr;
+        throw DatabaseException("", msg);
+    }
+    sqlite3_busy_timeout(db, SQLITE3_READ_BUSY_TIMEOUT);
+    statementCache->attach(db);
+}
+
+Sqlite3ReadConnection::~Sqlite3ReadConnection()
+{
+    statementCache->clear();
+    if (db && sqlite3_close_v2(db) != SQLITE_OK) {
+        log_error("Closing read connection failed");
+    }
+    db = nullptr;
+}
+
+/* Sqlite3ReadPool */
+
+Sqlite3ReadPool::Sqlite3ReadPool(fs::path dbFilePath, std::size_t size, std::size_t statementCacheSize)
+    : dbFilePath(std::move(dbFilePath))
+    , size(size)
+    , statementCacheSize(statementCacheSize)
+{
+}
+
+Sqlite3ReadPool::~Sqlite3ReadPool()
+{
+    close();
+}
+
+void Sqlite3ReadPool::open()
+{
+    AutoLock lock(mutex);
+    idleConnections.reserve(size);
+    for (std::size_t count = 0; count < size; count++) {
+        idleConnections.push_back(std::make_shared<Sqlite3ReadConnection>(dbFilePath, statementCacheSize));
+    }
+    isOpen = true;
+    log_debug("Opened {} read connections", size);
+}
+
+void Sqlite3ReadPool::close()
+{
+    AutoLock lock(mutex);
+    isOpen = false;
+    idleConnections.clear();
+    cond.notify_all();
+}
+
+std::shared_ptr<Sqlite3ReadConnection> Sqlite3ReadPool::acquire()
+{
+    AutoLock lock(mutex);
+    cond.wait(lock, [this] { return !isOpen || !idleConnections.empty(); });
+    if (!isOpen)
+        return nullptr;
+
+    auto connection = std::move(idleConnections.back());
+    idleConnections.pop_back();
+    return connection;
+}
+
+void Sqlite3ReadPool::release(std::shared_ptr<Sqlite3ReadConnection> connection)
+{
+    AutoLock lock(mutex);
+    if (!isOpen)
+        return; // connection is closed when last reference is gone
+    idleConnections.push_back(std::move(connection));
+    cond.notify_one();
+}
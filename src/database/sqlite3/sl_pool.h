@@ -0,0 +1,89 @@
+/*GRB*
+    Gerbera - https://gerbera.io/
+
+    sl_pool.h - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file database/sqlite3/sl_pool.h
+/// @brief Definitions of the Sqlite3ReadConnection and Sqlite3ReadPool classes.
+
+#ifndef __SQLITE3_POOL_H__
+#define __SQLITE3_POOL_H__
+
+#include "util/grb_fs.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class Sqlite3StatementCache;
+
+extern "C" {
+struct sqlite3;
+}
+
+/// @brief Read-only connection to the sqlite3 database file
+class Sqlite3ReadConnection {
+public:
+    Sqlite3ReadConnection(const fs::path& dbFilePath, std::size_t statementCacheSize);
+    ~Sqlite3ReadConnection();
+
+    Sqlite3ReadConnection(const Sqlite3ReadConnection&) = delete;
+    Sqlite3ReadConnection& operator=(const Sqlite3ReadConnection&) = delete;
+
+    sqlite3* db { nullptr };
+    std::shared_ptr<Sqlite3StatementCache> statementCache;
+};
+
+/// @brief Pool of read-only connections, only usable with journal mode WAL
+///
+/// Selects of read only operations are executed on the calling thread
+/// so they do not wait for the writes queued for the sqlite3 thread.
+class Sqlite3ReadPool {
+public:
+    Sqlite3ReadPool(fs::path dbFilePath, std::size_t size, std::size_t statementCacheSize);
+    ~Sqlite3ReadPool();
+
+    Sqlite3ReadPool(const Sqlite3ReadPool&) = delete;
+    Sqlite3ReadPool& operator=(const Sqlite3ReadPool&) = delete;
+
+    /// @brief open all connections
+    void open();
+    /// @brief close idle connections, connections in use are closed on release
+    void close();
+
+    /// @brief get exclusive access to a connection, waits if all are in use
+    /// @return connection or nullptr if the pool is closed
+    std::shared_ptr<Sqlite3ReadConnection> acquire();
+    /// @brief return connection to the pool
+    void release(std::shared_ptr<Sqlite3ReadConnection> connection);
+
+private:
+    fs::path dbFilePath;
+    std::size_t size;
+    std::size_t statementCacheSize;
+    bool isOpen {};
+
+    std::vector<std::shared_ptr<Sqlite3ReadConnection>> idleConnections;
+
+    std::mutex mutex;
+    using AutoLock = std::unique_lock<std::mutex>;
+    std::condition_variable cond;
+};
+
+#endif // __SQLITE3_POOL_H__
@@ -59,3 +59,28 @@ std::unique_ptr<SQLRow> Sqlite3Result::nextRow()
     }
     return nullptr;
 }
+
+/* Sqlite3StatementRow */
+
+Sqlite3StatementRow::Sqlite3StatementRow(const char* data, const std::ptrdiff_t* offsets)
+    : data(data)
+    , offsets(offsets)
+{
+}
+
+char* Sqlite3StatementRow::col_c_str(int index) const
+{
+    if (offsets[index] < 0)
+        return nullptr;
+    return const_cast<char*>(data + offsets[index]);
+}
+
+/* Sqlite3StatementResult */
+
+std::unique_ptr<SQLRow> Sqlite3StatementResult::nextRow()
+{
+    if (currentRow >= rowCount)
+        return nullptr;
+
+    return std::make_unique<Sqlite3StatementRow>(data.data(), offsets.data() + columnCount * currentRow++);
+}
@@ -26,6 +26,9 @@
 
 #include "database/sql_result.h"
 
+#include <cstddef>
+#include <vector>
+
 /// @brief Represents a result of a sqlite3 select
 class Sqlite3Result : public SQLResult {
 public:
@@ -60,4 +63,41 @@ private:
     char** row;
 };
 
+/// @brief Represents a result of a prepared sqlite3 statement
+///
+/// All rows are copied while the task runs, so the statement goes back to the cache
+/// before the result is used and the rows do not change with later writes on the connection.
+class Sqlite3StatementResult : public SQLResult {
+public:
+    Sqlite3StatementResult() = default;
+
+    Sqlite3StatementResult(const Sqlite3StatementResult&) = delete;
+    Sqlite3StatementResult& operator=(const Sqlite3StatementResult&) = delete;
+
+private:
+    std::unique_ptr<SQLRow> nextRow() override;
+    [[nodiscard]] unsigned long long getNumRows() const override { return rowCount; }
+
+    /// @brief zero terminated column values of all rows
+    std::vector<char> data;
+    /// @brief start of each column value in data, -1 for NULL
+    std::vector<std::ptrdiff_t> offsets;
+    std::size_t columnCount {};
+    std::size_t rowCount {};
+    std::size_t currentRow {};
+
+    friend class SLPreparedSelectTask;
+};
+
+/// @brief Represents a row of a result of a prepared sqlite3 statement
+class Sqlite3StatementRow : public SQLRow {
+public:
+    Sqlite3StatementRow(const char* data, const std::ptrdiff_t* offsets);
+
+private:
+    char* col_c_str(int index) const override;
+    const char* data;
+    const std::ptrdiff_t* offsets;
+};
+
 #endif // __SQLITE3_RESULT_H__
\ No newline at end of file
@@ -0,0 +1,104 @@
+/*GRB*
+    Gerbera - https://gerbera.io/
+
+    sl_statement.cc - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file database/sqlite3/sl_statement.cc
+/// @brief Implementation of the Sqlite3StatementCache class.
+#define GRB_LOG_FAC GrbLogFacility::sqlite3
+
+#include "sl_statement.h" // API
+
+#include "util/logger.h"
+
+#include <sqlite3.h>
+
+Sqlite3StatementCache::Sqlite3StatementCache(std::size_t capacity)
+    : capacity(capacity)
+{
+}
+
+Sqlite3StatementCache::~Sqlite3StatementCache()
+{
+    clear();
+}
+
+void Sqlite3StatementCache::attach(sqlite3* db)
+{
+    clear();
+    AutoLock lock(mutex);
+    this->db = db;
+}
+
+void Sqlite3StatementCache::clear()
+{
+    AutoLock lock(mutex);
+    for (auto&& [query, stmt] : statements) {
+        sqlite3_finalize(stmt);
+    }
+    log_debug("Dropping {} statements, {} hits, {} misses", statements.size(), hits, misses);
+    statements.clear();
+    statementIndex.clear();
+    db = nullptr;
+}
+
+sqlite3_stmt* Sqlite3StatementCache::acquire(const std::string& query, int& errorCode)
+{
+    {
+        AutoLock lock(mutex);
+        auto entry = statementIndex.find(query);
+        if (entry != statementIndex.end()) {
+            auto stmt = entry->second->second;
+            statements.erase(entry->second);
+            statementIndex.erase(entry);
+            hits++;
+            return stmt;
+        }
+        misses++;
+    }
+
+    sqlite3_stmt* stmt = nullptr;
+    errorCode = sqlite3_prepare_v3(db, query.c_str(), -1, capacity > 0 ? SQLITE_PREPARE_PERSISTENT : 0, &stmt, nullptr);
+    if (errorCode != SQLITE_OK) {
+        sqlite3_finalize(stmt);
+        return nullptr;
+    }
+    return stmt;
+}
+
+void Sqlite3StatementCache::release(const std::string& query, sqlite3_stmt* stmt)
+{
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+
+    AutoLock lock(mutex);
+    // connection was closed or statement is already cached by a parallel result
+    if (!db || sqlite3_db_handle(stmt) != db || capacity == 0 || statementIndex.find(query) != statementIndex.end()) {
+        sqlite3_finalize(stmt);
+        return;
+    }
+
+    statements.emplace_front(query, stmt);
+    statementIndex[query] = statements.begin();
+    if (statements.size() > capacity) {
+        auto&& [oldQuery, oldStmt] = statements.back();
+        sqlite3_finalize(oldStmt);
+        statementIndex.erase(oldQuery);
+        statements.pop_back();
+    }
+}
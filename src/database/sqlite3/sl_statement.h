@@ -0,0 +1,81 @@
+/*GRB*
+    Gerbera - https://gerbera.io/
+
+    sl_statement.h - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file database/sqlite3/sl_statement.h
+/// @brief Definition of the Sqlite3StatementCache class.
+
+#ifndef __SQLITE3_STATEMENT_H__
+#define __SQLITE3_STATEMENT_H__
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+extern "C" {
+struct sqlite3;
+struct sqlite3_stmt;
+}
+
+/// @brief LRU cache of prepared statements of one sqlite3 connection
+///
+/// Statements are taken out of the cache while a task is stepping them
+/// and are returned after all rows are read, so a statement is never
+/// stepped by two tasks at the same time.
+class Sqlite3StatementCache {
+public:
+    explicit Sqlite3StatementCache(std::size_t capacity);
+    ~Sqlite3StatementCache();
+
+    Sqlite3StatementCache(const Sqlite3StatementCache&) = delete;
+    Sqlite3StatementCache& operator=(const Sqlite3StatementCache&) = delete;
+
+    /// @brief attach cache to an opened connection
+    void attach(sqlite3* db);
+    /// @brief finalize all cached statements, has to be called before connection is closed
+    void clear();
+
+    /// @brief take prepared statement for query from cache or prepare a new one
+    /// @param query statement text used as cache key
+    /// @param errorCode result of sqlite3_prepare if no statement is returned
+    /// @return statement or nullptr on error
+    sqlite3_stmt* acquire(const std::string& query, int& errorCode);
+    /// @brief reset statement and put it back into the cache
+    void release(const std::string& query, sqlite3_stmt* stmt);
+
+    std::size_t getHits() const { return hits; }
+    std::size_t getMisses() const { return misses; }
+
+private:
+    using StatementList = std::list<std::pair<std::string, sqlite3_stmt*>>;
+
+    std::size_t capacity;
+    sqlite3* db { nullptr };
+    /// @brief least recently used statement is at the end
+    StatementList statements;
+    std::unordered_map<std::string, StatementList::iterator> statementIndex;
+    std::size_t hits {};
+    std::size_t misses {};
+
+    mutable std::mutex mutex;
+    using AutoLock = std::scoped_lock<std::mutex>;
+};
+
+#endif // __SQLITE3_STATEMENT_H__
@@ -27,6 +27,7 @@
 #include "config/config_val.h"
 #include "exceptions.h"
 #include "sl_result.h"
+#include "sl_statement.h"
 #include "sqlite_database.h"
 #include "util/tools.h"
 
@@ -94,11 +95,13 @@ void SLScriptTask::run(sqlite3*& db, Sqlite3Database& sl, bool throwOnError)
     log_debug("Running: init");
     std::string dbFilePath = config->getOption(ConfigVal::SERVER_STORAGE_SQLITE_DATABASE_FILE);
 
+    sl.getStatementCache()->clear();
     sqlite3_close(db);
 
     int res = sqlite3_open(dbFilePath.c_str(), &db);
     if (res != SQLITE_OK)
         throw DatabaseException("", "SQLite: Failed to open database");
+    sl.getStatementCache()->attach(db);
 
     auto sqlFilePath = fs::path(config->getOption(scriptFile));
     log_debug("Loading SQL script from: {}", sqlFilePath.c_str());
@@ -163,6 +166,64 @@ void SLSelectTask::run(sqlite3*& db, Sqlite3Database& sl, bool throwOnError)
     pres->cur_row = 0;
 }
 
+/* SLPreparedSelectTask */
+SLPreparedSelectTask::SLPreparedSelectTask(const std::string& query, const std::vector<SQLParam>& params, std::shared_ptr<Sqlite3StatementCache> statementCache)
+    : query(query)
+    , params(params)
+    , statementCache(std::move(statementCache))
+{
+}
+
+void SLPreparedSelectTask::run(sqlite3*& db, Sqlite3Database& sl, bool throwOnError)
+{
+    log_debug("Running: {}", query);
+    int ret = SQLITE_OK;
+    auto stmt = statementCache->acquire(query, ret);
+    if (!stmt) {
+        throw DatabaseException("", sl.handleError(query, "prepare failed", db, ret));
+    }
+
+    auto result = std::make_shared<Sqlite3StatementResult>();
+    try {
+        int index = 0;
+        for (auto&& param : params) {
+            index++;
+            if (std::holds_alternative<long long>(param))
+                ret = sqlite3_bind_int64(stmt, index, std::get<long long>(param));
+            else
+                ret = sqlite3_bind_text(stmt, index, std::get<std::string>(param).c_str(), -1, SQLITE_TRANSIENT);
+            if (ret != SQLITE_OK) {
+                throw DatabaseException("", sl.handleError(query, fmt::format("binding parameter {} failed", index), db, ret));
+            }
+        }
+
+        // rows are copied on this connection, a result read later could see other writes or a rollback
+        int columnCount = sqlite3_column_count(stmt);
+        result->columnCount = columnCount;
+        while ((ret = sqlite3_step(stmt)) == SQLITE_ROW) {
+            for (int column = 0; column < columnCount; column++) {
+                auto value = reinterpret_cast<const char*>(sqlite3_column_text(stmt, column));
+                if (!value) {
+                    result->offsets.push_back(-1);
+                    continue;
+                }
+                result->offsets.push_back(result->data.size());
+                result->data.insert(result->data.end(), value, value + sqlite3_column_bytes(stmt, column));
+                result->data.push_back('\0');
+            }
+            result->rowCount++;
+        }
+        if (ret != SQLITE_DONE) {
+            throw DatabaseException("", sl.handleError(query, "step failed", db, ret));
+        }
+    } catch (const std::runtime_error&) {
+        statementCache->release(query, stmt);
+        throw;
+    }
+    statementCache->release(query, stmt);
+    pres = std::move(result);
+}
+
 /* SLExecTask */
 
 SLExecTask::SLExecTask(const std::string& query, std::string getLastInsertId, bool warnOnly)
@@ -230,6 +291,7 @@ void SLBackupTask::run(sqlite3*& db, Sqlite3Database& sl, bool throwOnError)
         }
     } else {
         log_info("trying to restore sqlite3 database from backup...");
+        sl.getStatementCache()->clear();
         sqlite3_close(db);
         try {
             fs::copy(
@@ -244,6 +306,7 @@ void SLBackupTask::run(sqlite3*& db, Sqlite3Database& sl, bool throwOnError)
         if (res != SQLITE_OK) {
             throw DatabaseException("", "error while restoring sqlite3 backup: could not reopen sqlite3 database after restore");
         }
+        sl.getStatementCache()->attach(db);
         log_info("sqlite3 database successfully restored from backup.");
     }
 }
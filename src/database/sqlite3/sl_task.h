@@ -24,15 +24,19 @@
 #ifndef __SQLITE3_TASK_H__
 #define __SQLITE3_TASK_H__
 
+#include "database/sql_format.h"
 #include "util/grb_fs.h"
 
 #include <condition_variable>
 #include <mutex>
+#include <vector>
 
 class Config;
 enum class ConfigVal;
 class Sqlite3Database;
 class Sqlite3Result;
+class Sqlite3StatementCache;
+class SQLResult;
 
 extern "C" {
 struct sqlite3;
@@ -137,6 +141,31 @@ protected:
     std::shared_ptr<Sqlite3Result> pres;
 };
 
+/// @brief A task for the sqlite3 thread to bind parameters to a cached prepared statement.
+class SLPreparedSelectTask : public SLTask {
+public:
+    /// @brief Constructor for the sqlite3 prepared select task
+    /// @param query The SQL query string with placeholders
+    /// @param params The values for the placeholders
+    /// @param statementCache The statement cache of the connection the task is run with
+    SLPreparedSelectTask(const std::string& query, const std::vector<SQLParam>& params, std::shared_ptr<Sqlite3StatementCache> statementCache);
+
+    void run(sqlite3*& db, Sqlite3Database& sl, bool throwOnError = true) override;
+    [[nodiscard]] std::shared_ptr<SQLResult> getResult() const { return pres; }
+
+    std::string_view taskType() const override { return "PreparedSelectTask"; }
+
+protected:
+    /// @brief The SQL query string
+    const std::string& query;
+    /// @brief The values for the placeholders
+    const std::vector<SQLParam>& params;
+    /// @brief The statement cache of the connection
+    std::shared_ptr<Sqlite3StatementCache> statementCache;
+    /// @brief The result stepping the statement
+    std::shared_ptr<SQLResult> pres;
+};
+
 /// @brief A task for the sqlite3 thread to do a SQL exec.
 class SLExecTask : public SLTask {
 public:
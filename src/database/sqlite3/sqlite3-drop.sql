@@ -1,3 +1,4 @@
+DROP TABLE IF EXISTS "grb_metadata_search";
 DROP TABLE IF EXISTS "grb_playstatus";
 DROP TABLE IF EXISTS "grb_cds_resource";
 DROP TABLE IF EXISTS "mt_metadata";
@@ -20,6 +20,12 @@ CREATE TABLE "mt_cds_object"(
     "service_id" varchar(255) default NULL,
     "last_modified" integer unsigned default NULL,
     "last_updated" integer unsigned default 0,
+    "container_count" integer NOT NULL default 0,
+    "item_count" integer NOT NULL default 0,
+    "ancestor_path" text default NULL,
+    "file_device" integer default NULL,
+    "file_inode" integer default NULL,
+    "file_size" integer default NULL,
     CONSTRAINT "cds_object_ibfk_1" FOREIGN KEY("ref_id") REFERENCES "mt_cds_object"("id")ON DELETE CASCADE ON UPDATE CASCADE,
     CONSTRAINT "cds_object_ibfk_2" FOREIGN KEY("parent_id") REFERENCES "mt_cds_object"("id")ON DELETE CASCADE ON UPDATE CASCADE);
 CREATE TABLE "mt_internal_setting"(
@@ -95,4 +101,6 @@ CREATE INDEX "mt_cds_object_service_id" ON mt_cds_object(service_id);
 CREATE INDEX "mt_metadata_item_id" ON mt_metadata(item_id);
 CREATE INDEX "mt_cds_object_title" ON mt_cds_object(dc_title);
 CREATE INDEX "mt_cds_object_sort_key" ON mt_cds_object(sort_key);
+CREATE INDEX "grb_cds_object_ancestor_path" ON mt_cds_object(ancestor_path);
+CREATE INDEX "grb_cds_object_file_id" ON mt_cds_object(file_inode,file_device);
 COMMIT;
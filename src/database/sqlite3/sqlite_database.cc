@@ -38,7 +38,9 @@
 #include "config/config.h"
 #include "config/config_val.h"
 #include "exceptions.h"
+#include "sl_pool.h"
 #include "sl_result.h"
+#include "sl_statement.h"
 #include "sl_task.h"
 
 #include <sqlite3.h>
@@ -53,18 +55,34 @@ static const auto sqlite3AddResourceAttr = std::map<ResourceDataType, std::strin
 #define DELETE_CACHE_MAX_TIME 60 // drop cache if last delete was more than 60 secs ago
 #define DELETE_CACHE_RED_SIZE 0.2 // reduce cache to 80% of max entries
 
+/// @brief read-only connection used by the current thread between beginRead and endRead
+struct Sqlite3ThreadReader {
+    std::shared_ptr<Sqlite3ReadConnection> connection;
+    int depth {};
+};
+static thread_local Sqlite3ThreadReader threadReader;
+
 Sqlite3Database::Sqlite3Database(const std::shared_ptr<Config>& config, const std::shared_ptr<Mime>& mime, const std::shared_ptr<ConverterManager>& converterManager, std::shared_ptr<Timer> timer)
     : SQLDatabase(config, mime, converterManager)
     , timer(std::move(timer))
+    , statementCache(std::make_shared<Sqlite3StatementCache>(this->config->getIntOption(ConfigVal::SERVER_STORAGE_SQLITE_STATEMENT_CACHE_SIZE)))
     , shutdownAttempts(this->config->getIntOption(ConfigVal::SERVER_STORAGE_SQLITE_SHUTDOWN_ATTEMPTS))
 {
     dbFilePath = config->getOption(ConfigVal::SERVER_STORAGE_SQLITE_DATABASE_FILE);
     table_quote_begin = '"';
     table_quote_end = '"';
 
+    auto readConnections = this->config->getIntOption(ConfigVal::SERVER_STORAGE_SQLITE_READ_CONNECTIONS);
+    if (readConnections > 0) {
+        if (this->config->getOption(ConfigVal::SERVER_STORAGE_SQLITE_JOURNALMODE) == "WAL")
+            readPool = std::make_shared<Sqlite3ReadPool>(dbFilePath, readConnections, this->config->getIntOption(ConfigVal::SERVER_STORAGE_SQLITE_STATEMENT_CACHE_SIZE));
+        else
+            log_warning("SQLite3 read connections require journal-mode WAL, ignoring {} read connections", readConnections);
+    }
+
     // if sqlite3.sql or sqlite3-upgrade.xml is changed hashies have to be updated
     hashies = {
-        { 0, 3342248374 }, // index 0 is used for create script sqlite3.sql = Version 1
+        { 0, 481557690 }, // index 0 is used for create script sqlite3.sql = Version 1
         { 1, 778996897 },
         { 2, 3362507034 },
         { 3, 853149842 },
@@ -93,13 +111,17 @@ Sqlite3Database::Sqlite3Database(const std::shared_ptr<Config>& config, const st
         { 26, 2252596209 },
         { 27, 890824096 },
         { 28, 1243527281 },
-        { -1, 459854332 }, // index -1 is used for drop script sqlite3-drop.sql
+        { 29, 449227441 },
+        { 30, 4015166889 },
+        { 31, 873907889 },
+        { -1, 2427477217 }, // index -1 is used for drop script sqlite3-drop.sql
     };
 }
 
 void Sqlite3Database::prepare()
 {
-    _exec("PRAGMA locking_mode = EXCLUSIVE");
+    // read connections cannot access the database file if the writer holds it exclusively
+    _exec(fmt::format("PRAGMA locking_mode = {}", readPool ? "NORMAL" : "EXCLUSIVE"));
     _exec("PRAGMA foreign_keys = ON");
     _exec(fmt::format("PRAGMA journal_mode = {}", config->getOption(ConfigVal::SERVER_STORAGE_SQLITE_JOURNALMODE)));
     exec(fmt::format("PRAGMA synchronous = {}", config->getIntOption(ConfigVal::SERVER_STORAGE_SQLITE_SYNCHRONOUS)));
@@ -168,7 +190,7 @@ void Sqlite3Database::dropTables()
 {
     auto file = config->getOption(ConfigVal::SERVER_STORAGE_SQLITE_DROP_FILE);
     log_info("Dropping tables with {}", file);
-    auto dtask = std::make_shared<SLScriptTask>(config, hashies.at(DBVERSION), stringLimit, ConfigVal::SERVER_STORAGE_SQLITE_DROP_FILE);
+    auto dtask = std::make_shared<SLScriptTask>(config, hashies.at(-1), stringLimit, ConfigVal::SERVER_STORAGE_SQLITE_DROP_FILE);
     addTask(dtask);
     try {
         dtask->waitForTask();
@@ -241,6 +263,7 @@ void Sqlite3Database::init()
 
     try {
         upgradeDatabase(std::stoul(dbVersion), hashies, ConfigVal::SERVER_STORAGE_SQLITE_UPGRADE_FILE, sqlite3UpdateVersion, sqlite3AddResourceAttr);
+        initSearchIndex();
         if (config->getBoolOption(ConfigVal::SERVER_STORAGE_SQLITE_BACKUP_ENABLED) && timer) {
             // do a backup now
             auto btask = std::make_shared<SLBackupTask>(config, false);
@@ -260,6 +283,8 @@ void Sqlite3Database::init()
             log_info("Saving string limit {}", stringLimit);
             storeInternalSetting("string_limit", fmt::to_string(stringLimit));
         }
+        if (readPool)
+            readPool->open();
         dbInitDone = true;
     } catch (const std::runtime_error& e) {
         log_error("Prematurely shutting down.");
@@ -281,6 +306,66 @@ std::shared_ptr<Database> Sqlite3Database::getSelf()
     return shared_from_this();
 }
 
+/// @brief statements to create external content index on mt_metadata and keep it in sync
+static const std::vector<std::string_view> searchIndexCreate {
+    R"(CREATE VIRTUAL TABLE "grb_metadata_search" USING fts5("property_value", content='mt_metadata', content_rowid='id', tokenize='trigram'))",
+    R"(CREATE TRIGGER "grb_metadata_search_insert" AFTER INSERT ON "mt_metadata" BEGIN INSERT INTO "grb_metadata_search"(rowid, "property_value") VALUES (new."id", new."property_value"); END)",
+    R"(CREATE TRIGGER "grb_metadata_search_delete" AFTER DELETE ON "mt_metadata" BEGIN INSERT INTO "grb_metadata_search"("grb_metadata_search", rowid, "property_value") VALUES ('delete', old."id", old."property_value"); END)",
+    R"(CREATE TRIGGER "grb_metadata_search_update" AFTER UPDATE ON "mt_metadata" BEGIN INSERT INTO "grb_metadata_search"("grb_metadata_search", rowid, "property_value") VALUES ('delete', old."id", old."property_value"); INSERT INTO "grb_metadata_search"(rowid, "property_value") VALUES (new."id", new."property_value"); END)",
+    R"(INSERT INTO "grb_metadata_search"("grb_metadata_search") VALUES ('rebuild'))",
+};
+static const std::vector<std::string_view> searchIndexDrop {
+    R"(DROP TRIGGER IF EXISTS "grb_metadata_search_insert")",
+    R"(DROP TRIGGER IF EXISTS "grb_metadata_search_delete")",
+    R"(DROP TRIGGER IF EXISTS "grb_metadata_search_update")",
+    R"(DROP TABLE IF EXISTS "grb_metadata_search")",
+};
+#define SQLITE3_TRIGRAM_VERSION 3034000 // first version with trigram tokenizer
+
+std::string Sqlite3SearchIndex::emitMatch(
+    const std::string& idColumn,
+    const std::string& property,
+    const std::string& value,
+    const std::string& pattern) const
+{
+    // LIKE on trigram index is case insensitive like LOWER() on both sides
+    return fmt::format(R"(({} IN (SELECT "item_id" FROM "mt_metadata" WHERE "property_name" = {} AND "id" IN (SELECT rowid FROM "grb_metadata_search" WHERE "property_value" LIKE {}))))",
+        idColumn, database.quote(property), database.quote(pattern));
+}
+
+std::shared_ptr<SearchIndex> Sqlite3Database::prepareSearchIndex(bool enabled)
+{
+    auto res = select(R"(SELECT "name" FROM "sqlite_master" WHERE "type" = 'table' AND "name" = 'grb_metadata_search')");
+    bool exists = res && res->nextRow();
+
+    if (!enabled) {
+        if (exists) {
+            log_info("Removing full text search index");
+            for (auto&& statement : searchIndexDrop)
+                exec(std::string(statement));
+        }
+        return nullptr;
+    }
+
+    if (sqlite3_libversion_number() < SQLITE3_TRIGRAM_VERSION)
+        throw_std_runtime_error("SQLite {} has no trigram tokenizer", sqlite3_libversion());
+
+    if (!exists) {
+        log_info("Creating full text search index");
+        beginTransaction("prepareSearchIndex");
+        try {
+            for (auto&& statement : searchIndexCreate)
+                exec(std::string(statement));
+        } catch (const std::runtime_error&) {
+            // e.g. SQLite built without FTS5, caller continues without index
+            rollback("prepareSearchIndex");
+            throw;
+        }
+        commit("prepareSearchIndex");
+    }
+    return std::make_shared<Sqlite3SearchIndex>(*this);
+}
+
 void Sqlite3Database::_exec(const std::string& query)
 {
     execOnly(query);
@@ -320,11 +405,59 @@ void Sqlite3Database::handleException(const std::exception& exc, const std::stri
     log_error("Already shutting down.\n{}\n{}", lineMessage, exc.what());
 }
 
+void Sqlite3Database::beginRead()
+{
+    if (!readPool)
+        return;
+    if (threadReader.depth++ == 0 && !ownsTransaction()) {
+        // writes of own transaction are not visible on other connections
+        threadReader.connection = readPool->acquire();
+    }
+}
+
+void Sqlite3Database::endRead()
+{
+    if (!readPool || threadReader.depth == 0)
+        return;
+    if (--threadReader.depth == 0 && threadReader.connection) {
+        readPool->release(std::move(threadReader.connection));
+        threadReader.connection = nullptr;
+    }
+}
+
+bool Sqlite3Database::isReading() const
+{
+    return readPool && threadReader.connection;
+}
+
 std::shared_ptr<SQLResult> Sqlite3Database::select(const std::string& query)
 {
     try {
-        log_debug("Adding select to Queue: {}", query);
         auto stask = std::make_shared<SLSelectTask>(query);
+        if (isReading()) {
+            stask->run(threadReader.connection->db, *this);
+            return stask->getResult();
+        }
+        log_debug("Adding select to Queue: {}", query);
+        addTask(stask);
+        stask->waitForTask();
+        return stask->getResult();
+    } catch (const std::runtime_error& e) {
+        handleException(e, LINE_MESSAGE);
+        return {};
+    }
+}
+
+std::shared_ptr<SQLResult> Sqlite3Database::preparedSelect(const std::string& query, const std::vector<SQLParam>& params)
+{
+    try {
+        if (isReading()) {
+            auto stask = std::make_shared<SLPreparedSelectTask>(query, params, threadReader.connection->statementCache);
+            stask->run(threadReader.connection->db, *this);
+            return stask->getResult();
+        }
+        log_debug("Adding prepared select to Queue: {}", query);
+        auto stask = std::make_shared<SLPreparedSelectTask>(query, params, statementCache);
         addTask(stask);
         stask->waitForTask();
         return stask->getResult();
@@ -407,6 +540,7 @@ void Sqlite3Database::threadProc()
             startupError = fmt::format("Sqlite3Database.threadProc: could not open '{}'", dbFilePath.c_str());
             return;
         }
+        statementCache->attach(db);
 
         StdThreadRunner::waitFor("Sqlite3Database", [this] { return threadRunner != nullptr; });
         auto lock = threadRunner->uniqueLockS("threadProc");
@@ -465,7 +599,8 @@ void Sqlite3Database::threadProc()
 
         if (db) {
             log_debug("closing database");
-            if (sqlite3_close(db) == SQLITE_OK) {
+            statementCache->clear();
+            if (sqlite3_close_v2(db) == SQLITE_OK) {
                 log_debug("Closed database");
             } else {
                 log_error("Closing database failed");
@@ -505,6 +640,8 @@ void Sqlite3Database::addTask(const std::shared_ptr<SLTask>& task, bool onlyIfDi
 void Sqlite3Database::shutdownDriver()
 {
     log_debug("start");
+    if (readPool)
+        readPool->close();
     auto lock = threadRunner->uniqueLockS("shutdown");
     if (!shutdownFlag) {
         shutdownFlag = true;
@@ -541,20 +678,21 @@ Sqlite3DatabaseWithTransactions::Sqlite3DatabaseWithTransactions(
 
 void Sqlite3DatabaseWithTransactions::beginTransaction(std::string_view tName)
 {
-    if (use_transaction) {
+    if (use_transaction && !isReading()) {
         log_debug("BEGIN TRANSACTION {} {}", tName, inTransaction);
         SqlAutoLock lock(sqlMutex);
         log_debug("BEGIN TRANSACTION LOCK {} {}", tName, inTransaction);
         StdThreadRunner::waitFor(
             fmt::format("SqliteDatabase.begin {}", tName), [this] { return !inTransaction; }, 100);
         inTransaction = true;
+        transactionThread = std::this_thread::get_id();
         _exec("BEGIN TRANSACTION");
     }
 }
 
 void Sqlite3DatabaseWithTransactions::rollback(std::string_view tName)
 {
-    if (use_transaction && inTransaction) {
+    if (use_transaction && inTransaction && !isReading()) {
         log_debug("ROLLBACK {} {}", tName, inTransaction);
         _exec("ROLLBACK");
         inTransaction = false;
@@ -563,7 +701,7 @@ void Sqlite3DatabaseWithTransactions::rollback(std::string_view tName)
 
 void Sqlite3DatabaseWithTransactions::commit(std::string_view tName)
 {
-    if (use_transaction && inTransaction) {
+    if (use_transaction && inTransaction && !isReading()) {
         log_debug("COMMIT {} {}", tName, inTransaction);
         _exec("COMMIT");
         inTransaction = false;
@@ -35,15 +35,19 @@
 #ifndef __SQLITE3_STORAGE_H__
 #define __SQLITE3_STORAGE_H__
 
+#include "database/search_handler.h"
 #include "database/sql_database.h"
 #include "util/thread_runner.h"
 #include "util/timer.h"
 
 #include <mutex>
 #include <queue>
+#include <thread>
 
 class Sqlite3Database;
+class Sqlite3ReadPool;
 class Sqlite3Result;
+class Sqlite3StatementCache;
 class SLTask;
 
 extern "C" {
@@ -52,6 +56,24 @@ struct sqlite3;
 
 #define DELETE_CACHE_MAX_SIZE 500 // remove entries, if cache has more than 500 (default)
 
+/// @brief Full text index of metadata values in FTS5 table with trigram tokenizer
+class Sqlite3SearchIndex : public SearchIndex {
+public:
+    explicit Sqlite3SearchIndex(const SQLDatabase& database)
+        : database(database)
+    {
+    }
+
+    std::string emitMatch(
+        const std::string& idColumn,
+        const std::string& property,
+        const std::string& value,
+        const std::string& pattern) const override;
+
+private:
+    const SQLDatabase& database;
+};
+
 /// @brief The Database class for using SQLite3
 class Sqlite3Database
     : public Timer::Subscriber,
@@ -68,10 +90,23 @@ public:
 
     void dropTables() override;
 
+    /// @brief prepared statements of the connection used by the sqlite3 thread
+    const std::shared_ptr<Sqlite3StatementCache>& getStatementCache() const { return statementCache; }
+
+    void beginRead() override;
+    void endRead() override;
+
 protected:
     void _exec(const std::string& query) override;
     std::string prepareDatabase(const fs::path& dbFilePath, GrbFile& dbFile);
 
+    /// @brief true if the calling thread currently uses a read-only connection
+    bool isReading() const;
+    /// @brief true if the calling thread has an open write transaction
+    virtual bool ownsTransaction() const { return false; }
+
+    std::shared_ptr<SearchIndex> prepareSearchIndex(bool enabled) override;
+
 private:
     void prepare();
     void run() override;
@@ -82,6 +117,7 @@ private:
     std::string quote(const std::string& value) const override;
 
     std::shared_ptr<SQLResult> select(const std::string& query) override;
+    std::shared_ptr<SQLResult> preparedSelect(const std::string& query, const std::vector<SQLParam>& params) override;
     void del(std::string_view tableName, const std::string& clause, const std::vector<int>& ids) override;
     void execOnTable(std::string_view tableName, const std::string& query, int objId) override;
     int exec(const std::string& query, const std::string& getLastInsertId = "") override;
@@ -100,6 +136,9 @@ private:
     void addTask(const std::shared_ptr<SLTask>& task, bool onlyIfDirty = false);
 
     std::shared_ptr<Timer> timer;
+    std::shared_ptr<Sqlite3StatementCache> statementCache;
+    /// @brief read-only connections for browse and search
+    std::shared_ptr<Sqlite3ReadPool> readPool;
 
     /// @brief increased by shutdown attempt if the sqlite3 thread should terminate
     int shutdownFlag { 0 };
@@ -138,6 +177,12 @@ public:
     void beginTransaction(std::string_view tName) override;
     void rollback(std::string_view tName) override;
     void commit(std::string_view tName) override;
+
+protected:
+    bool ownsTransaction() const override { return inTransaction && transactionThread == std::this_thread::get_id(); }
+
+private:
+    std::thread::id transactionThread;
 };
 
 #endif // __SQLITE3_STORAGE_H__
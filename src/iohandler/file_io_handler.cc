@@ -38,73 +38,183 @@
 #include "upnp/compat.h"
 #include "util/logger.h"
 
-FileIOHandler::FileIOHandler(const fs::path& filename, off_t offset)
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// @brief files changed more recently are probably still written and are not mapped
+static constexpr std::chrono::seconds MMAP_MIN_AGE { 60 };
+
+FileIOHandler::FileIOHandler(const fs::path& filename, off_t offset, std::size_t readAhead, off_t mmapSize)
     : file(filename)
     , offset(offset)
+    , readAhead(readAhead)
+    , mmapSize(mmapSize)
 {
     log_debug("path = {}", file.getPath().string());
 }
 
+FileIOHandler::~FileIOHandler()
+{
+    closeFile();
+}
+
 void FileIOHandler::open(enum UpnpOpenFileMode mode)
 {
     if (mode != UPNP_READ)
         throw_std_runtime_error("open: UpnpOpenFileMode mode not supported");
 
     std::lock_guard<std::mutex> lock(mutex);
-    f = file.open("rb");
-    if (offset > 0)
-        seek(offset, SEEK_SET);
-    log_debug("open {}", file.getPath().string());
+    fd = ::open(file.getPath().c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw_fmt_system_error("Failed to open {}", file.getPath().string());
+
+    struct stat statbuf { };
+    if (fstat(fd, &statbuf) != 0) {
+        closeFile();
+        throw_fmt_system_error("Failed to stat {}", file.getPath().string());
+    }
+    size = statbuf.st_size;
+    position = std::clamp<off_t>(offset, 0, size);
+    readAheadEnd = position;
+
+    // a mapped file that is truncated raises SIGBUS, so only files that are not written any more are mapped
+    auto modified = std::chrono::system_clock::from_time_t(statbuf.st_mtime);
+    if (mmapSize > 0 && size >= mmapSize && static_cast<std::uintmax_t>(size) <= std::numeric_limits<std::size_t>::max()
+        && std::chrono::system_clock::now() - modified > MMAP_MIN_AGE) {
+        mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            log_warning("Failed to map {}: {}", file.getPath().string(), std::strerror(errno));
+            mapped = nullptr;
+        } else {
+            madvise(mapped, size, MADV_SEQUENTIAL);
+        }
+    }
+#ifdef POSIX_FADV_SEQUENTIAL
+    if (!mapped)
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    log_debug("open {} size {}{}", file.getPath().string(), size, mapped ? " mapped" : "");
+}
+
+void FileIOHandler::adviseReadAhead()
+{
+    // request next window when half of the last one was consumed
+    if (readAhead == 0 || position + static_cast<off_t>(readAhead / 2) < readAheadEnd || position >= size)
+        return;
+
+    auto start = std::max(position, readAheadEnd);
+    auto end = std::min(position + static_cast<off_t>(readAhead), size);
+    if (start < end) {
+        if (mapped) {
+            // madvise needs page aligned addresses
+            static const auto pageSize = static_cast<off_t>(sysconf(_SC_PAGESIZE));
+            auto alignedStart = start - start % pageSize;
+            madvise(static_cast<char*>(mapped) + alignedStart, end - alignedStart, MADV_WILLNEED);
+        } else {
+#ifdef POSIX_FADV_WILLNEED
+            posix_fadvise(fd, start, end - start, POSIX_FADV_WILLNEED);
+#endif
+        }
+    }
+    readAheadEnd = end;
 }
 
 grb_read_t FileIOHandler::read(std::byte* buf, std::size_t length)
 {
     std::lock_guard<std::mutex> lock(mutex);
-
-    std::size_t ret = std::fread(buf, sizeof(std::byte), length, f);
+    if (fd < 0)
+        return GRB_READ_ERROR;
+
+    adviseReadAhead();
+    auto start = std::chrono::steady_clock::now();
+    ssize_t ret;
+    if (mapped && position < size) {
+        auto available = static_cast<std::size_t>(std::max<off_t>(size - position, 0));
+        ret = static_cast<ssize_t>(std::min(length, available));
+        if (ret > 0)
+            std::memcpy(buf, static_cast<const std::byte*>(mapped) + position, ret);
+    } else {
+        // data appended after the file was mapped is read from the descriptor
+        do {
+            ret = pread(fd, buf, length, position);
+        } while (ret < 0 && errno == EINTR);
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
 
     log_debug("read {} {}", file.getPath().string(), length);
-    if (ret == 0) {
-        if (std::feof(f))
-            return GRB_READ_END;
-        if (std::ferror(f))
-            return GRB_READ_ERROR;
+    if (ret < 0) {
+        log_error("Failed to read {}: {}", file.getPath().string(), std::strerror(errno));
+        return GRB_READ_ERROR;
     }
-
-    return ret;
+    if (ret == 0)
+        return GRB_READ_END;
+
+    position += ret;
+    bytesRead += ret;
+    readCount++;
+    readTime += duration;
+    maxReadTime = std::max(maxReadTime, duration);
+    return static_cast<grb_read_t>(ret);
 }
 
 std::size_t FileIOHandler::write(std::byte* buf, std::size_t length)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-
-    return std::fwrite(buf, sizeof(std::byte), length, f);
+    return 0;
 }
 
 void FileIOHandler::seek(off_t offset, int whence)
 {
     std::lock_guard<std::mutex> lock(mutex);
 
-    if (fseeko(f, offset, whence) != 0) {
+    off_t newPosition;
+    switch (whence) {
+    case SEEK_SET:
+        newPosition = offset;
+        break;
+    case SEEK_CUR:
+        newPosition = position + offset;
+        break;
+    case SEEK_END:
+        newPosition = size + offset;
+        break;
+    default:
         throw_std_runtime_error("fseek failed");
     }
+    if (newPosition < 0)
+        throw_std_runtime_error("fseek failed");
+
+    position = newPosition;
+    readAheadEnd = position;
 }
 
 off_t FileIOHandler::tell()
 {
     std::lock_guard<std::mutex> lock(mutex);
-    return ftello(f);
+    return position;
 }
 
 void FileIOHandler::close()
 {
     std::lock_guard<std::mutex> lock(mutex);
+    if (readCount > 0) {
+        log_debug("close {}: {} bytes in {} reads, {} ms reading, slowest read {} ms", file.getPath().string(), bytesRead, readCount, readTime.count() / 1000, maxReadTime.count() / 1000);
+    }
+    closeFile();
 }
 
-void ZipIOHandler::close()
+void FileIOHandler::closeFile()
 {
-    std::lock_guard<std::mutex> lock(mutex);
-    file.close();
-    file.remove();
-    log_debug("close {}", file.getPath().string());
+    if (mapped) {
+        munmap(mapped, size);
+        mapped = nullptr;
+    }
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
 }
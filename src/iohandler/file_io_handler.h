@@ -38,25 +38,62 @@
 #include "io_handler.h"
 #include "util/grb_fs.h"
 
+#include <chrono>
 #include <mutex>
 
 /// @brief Allows the web server to read from a file.
+///
+/// Reads go directly to the file descriptor at the tracked position, so there is no
+/// extra copy into a stdio buffer. The kernel is told about the sequential access and
+/// asked to read ahead of the stream.
 class FileIOHandler : public IOHandler {
 protected:
     /// @brief Name of the file.
     GrbFile file;
 
     /// @brief Handle of the file.
-    std::FILE* f {};
+    int fd { -1 };
 
     std::mutex mutex;
 
     /// @brief open file with offset
     off_t offset;
+    /// @brief size of the read ahead window, 0 leaves it to the kernel
+    std::size_t readAhead;
+    /// @brief minimum size of files that are mapped into memory, 0 disables mapping
+    off_t mmapSize;
+
+    /// @brief size of the file when it was opened
+    off_t size {};
+    /// @brief current stream position
+    off_t position {};
+    /// @brief end of the range that was last requested from the kernel
+    off_t readAheadEnd {};
+    /// @brief mapped file content
+    void* mapped {};
+
+    /// @brief bytes read from the file
+    std::size_t bytesRead {};
+    /// @brief number of reads
+    std::size_t readCount {};
+    /// @brief time spent reading
+    std::chrono::microseconds readTime {};
+    /// @brief time of slowest read
+    std::chrono::microseconds maxReadTime {};
+
+    /// @brief request next part of the file from the kernel before it is read
+    void adviseReadAhead();
+    /// @brief release file descriptor and mapping
+    void closeFile();
 
 public:
     /// @brief Sets the filename to work with.
-    explicit FileIOHandler(const fs::path& filename, off_t offset = 0);
+    /// @param filename file to read
+    /// @param offset start of the stream in the file
+    /// @param readAhead number of bytes to request from the kernel ahead of the stream position
+    /// @param mmapSize files of at least this size are mapped into memory instead of read
+    explicit FileIOHandler(const fs::path& filename, off_t offset = 0, std::size_t readAhead = 0, off_t mmapSize = 0);
+    ~FileIOHandler() override;
 
     /// @brief Opens file for reading (writing is not supported)
     void open(enum UpnpOpenFileMode mode) override;
@@ -66,7 +103,7 @@ public:
     /// @param length Number of bytes to be copied into the buffer.
     grb_read_t read(std::byte* buf, std::size_t length) override;
 
-    /// @brief Writes to a previously opened file.
+    /// @brief Writing is not supported.
     /// @param buf Data from the buffer will be written to the file.
     /// @param length Number of bytes to be written from the buffer.
     /// @return number of bytes written.
@@ -86,14 +123,12 @@ public:
 
     /// @brief Close a previously opened file.
     void close() override;
-};
-
-/// @brief Allows the web server to read from a temporary zip file.
-class ZipIOHandler : public FileIOHandler {
-    using FileIOHandler::FileIOHandler;
 
-    /// @brief Close a previously opened file and delete it.
-    void close() override;
+    std::size_t getBytesRead() const { return bytesRead; }
+    std::size_t getReadCount() const { return readCount; }
+    std::chrono::microseconds getReadTime() const { return readTime; }
+    std::chrono::microseconds getMaxReadTime() const { return maxReadTime; }
+    bool isMapped() const { return mapped != nullptr; }
 };
 
 #endif // __FILE_IO_HANDLER_H__
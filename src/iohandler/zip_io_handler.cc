@@ -0,0 +1,436 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    zip_io_handler.cc - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file iohandler/zip_io_handler.cc
+#define GRB_LOG_FAC GrbLogFacility::iohandler
+
+#include "zip_io_handler.h" // API
+
+#include "exceptions.h"
+#include "util/logger.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Record layout as described in PKWARE APPNOTE.TXT
+static constexpr std::uint32_t LOCAL_HEADER_SIGNATURE = 0x04034b50;
+static constexpr std::uint32_t DATA_DESCRIPTOR_SIGNATURE = 0x08074b50;
+static constexpr std::uint32_t CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+static constexpr std::uint32_t ZIP64_END_SIGNATURE = 0x06064b50;
+static constexpr std::uint32_t ZIP64_LOCATOR_SIGNATURE = 0x07064b50;
+static constexpr std::uint32_t END_SIGNATURE = 0x06054b50;
+
+static constexpr std::size_t LOCAL_HEADER_SIZE = 30;
+static constexpr std::size_t CENTRAL_HEADER_SIZE = 46;
+static constexpr std::size_t ZIP64_END_SIZE = 56;
+static constexpr std::size_t ZIP64_LOCATOR_SIZE = 20;
+static constexpr std::size_t END_SIZE = 22;
+static constexpr std::size_t ZIP64_SIZES_EXTRA_SIZE = 20;
+
+static constexpr std::uint16_t ZIP64_EXTRA_ID = 0x0001;
+static constexpr std::uint16_t VERSION_DEFAULT = 20;
+static constexpr std::uint16_t VERSION_ZIP64 = 45;
+static constexpr std::uint16_t VERSION_MADE_BY_UNIX = 3 << 8;
+/// @brief sizes are in data descriptor, names are utf-8
+static constexpr std::uint16_t FLAGS = 0x0008 | 0x0800;
+static constexpr std::uint16_t METHOD_STORE = 0;
+static constexpr std::uint32_t FILE_ATTRIBUTES = 0100644U << 16;
+
+static constexpr off_t MAX_32 = 0xFFFFFFFF;
+static constexpr std::size_t MAX_16 = 0xFFFF;
+
+static constexpr std::size_t CRC_BUFFER_SIZE = 64 * 1024;
+
+static constexpr auto crcTable = [] {
+    std::array<std::uint32_t, 256> table {};
+    for (std::uint32_t i = 0; i < table.size(); i++) {
+        std::uint32_t c = i;
+        for (int k = 0; k < 8; k++)
+            c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+        table[i] = c;
+    }
+    return table;
+}();
+
+static std::uint32_t updateCrc(std::uint32_t crc, const std::byte* data, std::size_t length)
+{
+    crc = ~crc;
+    for (std::size_t i = 0; i < length; i++)
+        crc = crcTable[(crc ^ std::to_integer<std::uint32_t>(data[i])) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+template <typename T>
+static void put(std::vector<std::byte>& buffer, T value)
+{
+    for (std::size_t i = 0; i < sizeof(T); i++)
+        buffer.push_back(static_cast<std::byte>((static_cast<std::uint64_t>(value) >> (8 * i)) & 0xFF));
+}
+
+static void putString(std::vector<std::byte>& buffer, const std::string& value)
+{
+    auto data = reinterpret_cast<const std::byte*>(value.data());
+    buffer.insert(buffer.end(), data, data + value.size());
+}
+
+static std::size_t copyBytes(const std::vector<std::byte>& source, off_t offset, std::byte* buf, std::size_t length)
+{
+    auto count = std::min(length, source.size() - static_cast<std::size_t>(offset));
+    std::memcpy(buf, source.data() + offset, count);
+    return count;
+}
+
+static std::size_t centralExtraSize(off_t headerOffset, bool zip64)
+{
+    std::size_t result = (zip64 ? 16 : 0) + (headerOffset >= MAX_32 ? 8 : 0);
+    return result > 0 ? result + 4 : 0;
+}
+
+ZipIOHandler::ZipIOHandler(const std::vector<ZipEntry>& content)
+{
+    off_t offset = 0;
+    for (auto&& entry : content) {
+        struct stat statbuf { };
+        if (stat(entry.path.c_str(), &statbuf) != 0 || !S_ISREG(statbuf.st_mode)) {
+            log_warning("Skipping {} in zip archive: not a readable file", entry.path.string());
+            continue;
+        }
+        // names must not leave the extraction directory
+        auto name = entry.name;
+        std::replace(name.begin(), name.end(), '/', '_');
+        std::replace(name.begin(), name.end(), '\\', '_');
+        if (name.empty() || name.size() > MAX_16) {
+            log_warning("Skipping {} in zip archive: invalid name", entry.path.string());
+            continue;
+        }
+
+        // dos date starts 1980
+        struct tm mtime { };
+        localtime_r(&statbuf.st_mtime, &mtime);
+        if (mtime.tm_year < 80) {
+            mtime = {};
+            mtime.tm_year = 80;
+            mtime.tm_mday = 1;
+        }
+
+        Member member {
+            name,
+            entry.path,
+            statbuf.st_size,
+            static_cast<std::uint16_t>((mtime.tm_hour << 11) | (mtime.tm_min << 5) | (mtime.tm_sec / 2)),
+            static_cast<std::uint16_t>(((mtime.tm_year - 80) << 9) | ((mtime.tm_mon + 1) << 5) | mtime.tm_mday),
+            offset,
+            0,
+            statbuf.st_size >= MAX_32,
+            0,
+            0,
+        };
+        member.dataOffset = offset + LOCAL_HEADER_SIZE + name.size() + (member.zip64 ? ZIP64_SIZES_EXTRA_SIZE : 0);
+        offset = member.dataOffset + member.size + (member.zip64 ? 24 : 16);
+        members.push_back(std::move(member));
+    }
+
+    centralOffset = offset;
+    for (auto&& member : members)
+        centralSize += CENTRAL_HEADER_SIZE + member.name.size() + centralExtraSize(member.headerOffset, member.zip64);
+    bool zip64End = members.size() >= MAX_16 || centralOffset >= MAX_32 || centralSize >= MAX_32;
+    size = centralOffset + centralSize + (zip64End ? ZIP64_END_SIZE + ZIP64_LOCATOR_SIZE : 0) + END_SIZE;
+    log_debug("zip archive with {} files, size {}", members.size(), size);
+}
+
+ZipIOHandler::~ZipIOHandler()
+{
+    closeFile();
+}
+
+void ZipIOHandler::open(enum UpnpOpenFileMode mode)
+{
+    if (mode != UPNP_READ)
+        throw_std_runtime_error("open: UpnpOpenFileMode mode not supported");
+}
+
+std::vector<std::byte> ZipIOHandler::localHeader(const Member& member)
+{
+    std::vector<std::byte> result;
+    result.reserve(member.dataOffset - member.headerOffset);
+    put<std::uint32_t>(result, LOCAL_HEADER_SIGNATURE);
+    put<std::uint16_t>(result, member.zip64 ? VERSION_ZIP64 : VERSION_DEFAULT);
+    put<std::uint16_t>(result, FLAGS);
+    put<std::uint16_t>(result, METHOD_STORE);
+    put<std::uint16_t>(result, member.dosTime);
+    put<std::uint16_t>(result, member.dosDate);
+    // checksum follows in data descriptor
+    put<std::uint32_t>(result, 0);
+    put<std::uint32_t>(result, member.zip64 ? MAX_32 : member.size);
+    put<std::uint32_t>(result, member.zip64 ? MAX_32 : member.size);
+    put<std::uint16_t>(result, member.name.size());
+    put<std::uint16_t>(result, member.zip64 ? ZIP64_SIZES_EXTRA_SIZE : 0);
+    putString(result, member.name);
+    if (member.zip64) {
+        put<std::uint16_t>(result, ZIP64_EXTRA_ID);
+        put<std::uint16_t>(result, 16);
+        put<std::uint64_t>(result, member.size);
+        put<std::uint64_t>(result, member.size);
+    }
+    return result;
+}
+
+std::vector<std::byte> ZipIOHandler::dataDescriptor(std::size_t index)
+{
+    completeCrc(index);
+    auto&& member = members.at(index);
+    std::vector<std::byte> result;
+    put<std::uint32_t>(result, DATA_DESCRIPTOR_SIGNATURE);
+    put<std::uint32_t>(result, member.crc);
+    if (member.zip64) {
+        put<std::uint64_t>(result, member.size);
+        put<std::uint64_t>(result, member.size);
+    } else {
+        put<std::uint32_t>(result, member.size);
+        put<std::uint32_t>(result, member.size);
+    }
+    return result;
+}
+
+std::vector<std::byte> ZipIOHandler::centralHeader(const Member& member)
+{
+    bool zip64Offset = member.headerOffset >= MAX_32;
+    std::vector<std::byte> result;
+    put<std::uint32_t>(result, CENTRAL_HEADER_SIGNATURE);
+    put<std::uint16_t>(result, VERSION_MADE_BY_UNIX | VERSION_ZIP64);
+    put<std::uint16_t>(result, (member.zip64 || zip64Offset) ? VERSION_ZIP64 : VERSION_DEFAULT);
+    put<std::uint16_t>(result, FLAGS);
+    put<std::uint16_t>(result, METHOD_STORE);
+    put<std::uint16_t>(result, member.dosTime);
+    put<std::uint16_t>(result, member.dosDate);
+    put<std::uint32_t>(result, member.crc);
+    put<std::uint32_t>(result, member.zip64 ? MAX_32 : member.size);
+    put<std::uint32_t>(result, member.zip64 ? MAX_32 : member.size);
+    put<std::uint16_t>(result, member.name.size());
+    put<std::uint16_t>(result, centralExtraSize(member.headerOffset, member.zip64));
+    put<std::uint16_t>(result, 0); // comment
+    put<std::uint16_t>(result, 0); // disk
+    put<std::uint16_t>(result, 0); // internal attributes
+    put<std::uint32_t>(result, FILE_ATTRIBUTES);
+    put<std::uint32_t>(result, zip64Offset ? MAX_32 : member.headerOffset);
+    putString(result, member.name);
+    auto extraSize = centralExtraSize(member.headerOffset, member.zip64);
+    if (extraSize > 0) {
+        put<std::uint16_t>(result, ZIP64_EXTRA_ID);
+        put<std::uint16_t>(result, extraSize - 4);
+        if (member.zip64) {
+            put<std::uint64_t>(result, member.size);
+            put<std::uint64_t>(result, member.size);
+        }
+        if (zip64Offset)
+            put<std::uint64_t>(result, member.headerOffset);
+    }
+    return result;
+}
+
+const std::vector<std::byte>& ZipIOHandler::getTail()
+{
+    if (!tail.empty())
+        return tail;
+
+    tail.reserve(size - centralOffset);
+    for (std::size_t index = 0; index < members.size(); index++) {
+        completeCrc(index);
+        auto header = centralHeader(members.at(index));
+        tail.insert(tail.end(), header.begin(), header.end());
+    }
+
+    bool zip64End = members.size() >= MAX_16 || centralOffset >= MAX_32 || centralSize >= MAX_32;
+    if (zip64End) {
+        auto zip64EndOffset = centralOffset + centralSize;
+        put<std::uint32_t>(tail, ZIP64_END_SIGNATURE);
+        put<std::uint64_t>(tail, ZIP64_END_SIZE - 12);
+        put<std::uint16_t>(tail, VERSION_MADE_BY_UNIX | VERSION_ZIP64);
+        put<std::uint16_t>(tail, VERSION_ZIP64);
+        put<std::uint32_t>(tail, 0); // disk
+        put<std::uint32_t>(tail, 0); // disk of central directory
+        put<std::uint64_t>(tail, members.size());
+        put<std::uint64_t>(tail, members.size());
+        put<std::uint64_t>(tail, centralSize);
+        put<std::uint64_t>(tail, centralOffset);
+
+        put<std::uint32_t>(tail, ZIP64_LOCATOR_SIGNATURE);
+        put<std::uint32_t>(tail, 0); // disk of zip64 end record
+        put<std::uint64_t>(tail, zip64EndOffset);
+        put<std::uint32_t>(tail, 1); // number of disks
+    }
+
+    put<std::uint32_t>(tail, END_SIGNATURE);
+    put<std::uint16_t>(tail, 0); // disk
+    put<std::uint16_t>(tail, 0); // disk of central directory
+    put<std::uint16_t>(tail, std::min(members.size(), MAX_16));
+    put<std::uint16_t>(tail, std::min(members.size(), MAX_16));
+    put<std::uint32_t>(tail, std::min(centralSize, MAX_32));
+    put<std::uint32_t>(tail, std::min(centralOffset, MAX_32));
+    put<std::uint16_t>(tail, 0); // comment
+    return tail;
+}
+
+grb_read_t ZipIOHandler::read(std::byte* buf, std::size_t length)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::size_t count = 0;
+    while (count < length && position < size) {
+        std::size_t chunk;
+        if (position >= centralOffset) {
+            chunk = copyBytes(getTail(), position - centralOffset, buf + count, length - count);
+        } else {
+            auto next = std::upper_bound(members.begin(), members.end(), position, [](off_t pos, const Member& member) { return pos < member.headerOffset; });
+            auto index = static_cast<std::size_t>(std::distance(members.begin(), next) - 1);
+            auto&& member = members.at(index);
+            auto dataEnd = member.dataOffset + member.size;
+            if (position < member.dataOffset) {
+                chunk = copyBytes(localHeader(member), position - member.headerOffset, buf + count, length - count);
+            } else if (position < dataEnd) {
+                chunk = readData(index, position - member.dataOffset, buf + count, std::min<std::size_t>(length - count, dataEnd - position));
+            } else {
+                chunk = copyBytes(dataDescriptor(index), position - dataEnd, buf + count, length - count);
+            }
+        }
+        count += chunk;
+        position += chunk;
+    }
+
+    if (count == 0)
+        return GRB_READ_END;
+    return static_cast<grb_read_t>(count);
+}
+
+std::size_t ZipIOHandler::readData(std::size_t index, off_t offset, std::byte* buf, std::size_t length)
+{
+    auto count = readFile(index, offset, buf, length);
+    auto&& member = members.at(index);
+    // checksum can only be continued with data in order
+    if (offset <= member.crcPosition && member.crcPosition < offset + static_cast<off_t>(count)) {
+        auto skip = member.crcPosition - offset;
+        member.crc = updateCrc(member.crc, buf + skip, count - skip);
+        member.crcPosition = offset + count;
+    }
+    return count;
+}
+
+void ZipIOHandler::completeCrc(std::size_t index)
+{
+    auto&& member = members.at(index);
+    if (member.crcPosition >= member.size)
+        return;
+
+    log_debug("Reading {} from {} for checksum", member.path.string(), member.crcPosition);
+    std::vector<std::byte> buffer(CRC_BUFFER_SIZE);
+    while (member.crcPosition < member.size) {
+        auto count = std::min<std::size_t>(buffer.size(), member.size - member.crcPosition);
+        readData(index, member.crcPosition, buffer.data(), count);
+    }
+}
+
+std::size_t ZipIOHandler::readFile(std::size_t index, off_t offset, std::byte* buf, std::size_t length)
+{
+    auto&& member = members.at(index);
+    if (openMember != index) {
+        closeFile();
+        fd = ::open(member.path.c_str(), O_RDONLY | O_CLOEXEC);
+        openMember = index;
+        if (fd < 0) {
+            log_warning("Failed to open {}: {}", member.path.string(), std::strerror(errno));
+        } else {
+#ifdef POSIX_FADV_SEQUENTIAL
+            posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+        }
+    }
+
+    std::size_t count = 0;
+    while (fd >= 0 && count < length) {
+        auto ret = pread(fd, buf + count, length - count, offset + count);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret < 0)
+            log_warning("Failed to read {}: {}", member.path.string(), std::strerror(errno));
+        if (ret <= 0)
+            break;
+        count += ret;
+    }
+    // size is already announced, so the archive must be filled up
+    if (count < length) {
+        if (!truncated)
+            log_warning("{} is shorter than expected, zip archive is filled with zeroes", member.path.string());
+        truncated = true;
+        std::memset(buf + count, 0, length - count);
+    }
+    return length;
+}
+
+void ZipIOHandler::seek(off_t offset, int whence)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    off_t newPosition;
+    switch (whence) {
+    case SEEK_SET:
+        newPosition = offset;
+        break;
+    case SEEK_CUR:
+        newPosition = position + offset;
+        break;
+    case SEEK_END:
+        newPosition = size + offset;
+        break;
+    default:
+        throw_std_runtime_error("fseek failed");
+    }
+    if (newPosition < 0)
+        throw_std_runtime_error("fseek failed");
+
+    position = newPosition;
+}
+
+off_t ZipIOHandler::tell()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return position;
+}
+
+void ZipIOHandler::close()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    log_debug("close zip archive at {} of {}", position, size);
+    closeFile();
+}
+
+void ZipIOHandler::closeFile()
+{
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    openMember = SIZE_MAX;
+}
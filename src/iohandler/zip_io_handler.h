@@ -0,0 +1,118 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    zip_io_handler.h - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file iohandler/zip_io_handler.h
+/// @brief Definition of the ZipIOHandler class.
+
+#ifndef __ZIP_IO_HANDLER_H__
+#define __ZIP_IO_HANDLER_H__
+
+#include "io_handler.h"
+#include "util/grb_fs.h"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// @brief Allows the web server to read a zip archive of several files without creating it on disk.
+///
+/// Files are stored without compression, so the layout and size of the archive are known
+/// from the file sizes before anything is read. Local headers, file data and the central
+/// directory are produced on the fly for the requested range. The checksum of each file is
+/// calculated while it is streamed and sent in a data descriptor behind the file data.
+class ZipIOHandler : public IOHandler {
+public:
+    /// @brief File to add to the archive
+    struct ZipEntry {
+        /// @brief name of the file in the archive
+        std::string name;
+        /// @brief file to read
+        fs::path path;
+    };
+
+    /// @brief Collect sizes of the files and calculate the archive layout.
+    /// @param content files of the archive, files that cannot be accessed are skipped
+    explicit ZipIOHandler(const std::vector<ZipEntry>& content);
+    ~ZipIOHandler() override;
+
+    /// @brief total size of the archive
+    off_t getSize() const { return size; }
+    /// @brief number of files in the archive
+    std::size_t getEntryCount() const { return members.size(); }
+
+    void open(enum UpnpOpenFileMode mode) override;
+    grb_read_t read(std::byte* buf, std::size_t length) override;
+    void seek(off_t offset, int whence) override;
+    off_t tell() override;
+    void close() override;
+
+private:
+    struct Member {
+        std::string name;
+        fs::path path;
+        off_t size;
+        std::uint16_t dosTime;
+        std::uint16_t dosDate;
+        /// @brief start of the local header in the archive
+        off_t headerOffset;
+        /// @brief start of the file data in the archive
+        off_t dataOffset;
+        /// @brief sizes need 64 bit fields
+        bool zip64;
+        /// @brief checksum of the first crcPosition bytes
+        std::uint32_t crc;
+        off_t crcPosition;
+    };
+
+    std::vector<Member> members;
+    /// @brief start of the central directory
+    off_t centralOffset {};
+    /// @brief size of the central directory
+    off_t centralSize {};
+    off_t size {};
+    off_t position {};
+    /// @brief central directory and end records, created when they are read for the first time
+    std::vector<std::byte> tail;
+
+    /// @brief member that belongs to fd
+    std::size_t openMember { SIZE_MAX };
+    int fd { -1 };
+    /// @brief member is shorter than when the archive was created
+    bool truncated {};
+
+    std::mutex mutex;
+
+    static std::vector<std::byte> localHeader(const Member& member);
+    static std::vector<std::byte> centralHeader(const Member& member);
+    std::vector<std::byte> dataDescriptor(std::size_t index);
+    const std::vector<std::byte>& getTail();
+
+    /// @brief copy file data and update the checksum if data is read in order
+    std::size_t readData(std::size_t index, off_t offset, std::byte* buf, std::size_t length);
+    /// @brief read rest of the member to complete its checksum
+    void completeCrc(std::size_t index);
+    /// @brief read from member, missing data is filled with zeroes
+    std::size_t readFile(std::size_t index, off_t offset, std::byte* buf, std::size_t length);
+    void closeFile();
+};
+
+#endif // __ZIP_IO_HANDLER_H__
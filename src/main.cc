@@ -222,6 +222,7 @@ int main(int argc, char** argv, char** envp)
         (GRB_OPTION_PRINTOPTIONS, "Print simple config options and exit") //
         (GRB_OPTION_OFFLINE, "Do not answer UPnP content requests", cxxopts::value<bool>()->default_value("false")) // good for initial scans
         (GRB_OPTION_DROPTABLES, "Drop all database tables and exit", cxxopts::value<bool>()->default_value("false")) //
+        (GRB_OPTION_CHECKDATABASE, "Check and repair child counts of containers in database and exit", cxxopts::value<bool>()->default_value("false")) //
 #ifdef HAVE_LASTFM
 #ifndef HAVE_LASTFMLIB
         (GRB_OPTION_INITLASTFM, "Get Last.FM session key", cxxopts::value<bool>()->default_value("false")) //
@@ -289,11 +290,12 @@ int main(int argc, char** argv, char** envp)
 
         try {
             auto dropDatabase = runtime.getDropDatabase();
+            auto checkDatabase = runtime.getCheckDatabase();
             auto initLastFM = runtime.getLastFM();
 
-            server->init(definition, runtime.getOffline(), dropDatabase, initLastFM);
+            server->init(definition, runtime.getOffline(), dropDatabase, checkDatabase, initLastFM);
 
-            if (!dropDatabase && !initLastFM)
+            if (!dropDatabase && !checkDatabase && !initLastFM)
                 server->run();
             else
                 runtime.exit(EXIT_SUCCESS);
@@ -43,11 +43,24 @@
 #include "util/tools.h"
 
 #include <exiv2/exiv2.hpp>
+#include <mutex>
 
 #if EXIV2_TEST_VERSION(0, 28, 0)
 #define AnyError Error
 #endif
 
+/// @brief serializes the xmp toolkit for parallel metadata workers
+static std::mutex xmpMutex;
+
+static void xmpLock(void* lockData, bool lockUnlock)
+{
+    auto mutex = static_cast<std::mutex*>(lockData);
+    if (lockUnlock)
+        mutex->lock();
+    else
+        mutex->unlock();
+}
+
 Exiv2Handler::Exiv2Handler(const std::shared_ptr<Context>& context)
     : MediaMetadataHandler(context,
           ConfigVal::IMPORT_LIBOPTS_EXIV2_ENABLED,
@@ -60,6 +73,8 @@ Exiv2Handler::Exiv2Handler(const std::shared_ptr<Context>& context)
 {
     // silence exiv2 messages without debug
     Exiv2::LogMsg::setHandler([](auto, auto s) { log_debug("Exiv2: {}", s); });
+    // xmp toolkit is not thread safe, exiv2 locks it with the function passed at first initialization
+    Exiv2::XmpParser::initialize(xmpLock, &xmpMutex);
 }
 
 /// @brief Wrapper class to interface with EXIV2
@@ -31,7 +31,17 @@ Gerbera - https://gerbera.io/
 #include "config/config_val.h"
 #include "iohandler/mem_io_handler.h"
 #include "resolution.h"
+#include "context.h"
+#include "thumbnail_cache.h"
+#include "upnp/client_manager.h"
+#include "util/generic_task.h"
 #include "util/tools.h"
+#include "util/worker_pool.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <thread>
 
 #include <libffmpegthumbnailer/filmstripfilter.h>
 #include <libffmpegthumbnailer/videothumbnailer.h>
@@ -128,6 +138,293 @@ public:
     }
 };
 
+/// @brief Parameters of a single thumbnail
+struct ThumbnailRequest {
+    fs::path location;
+    double rotation;
+    int thumbSize;
+    int imageQuality;
+    int seekPercentage;
+    bool stripOverlay;
+};
+
+/// @brief run thumbnailer of a worker, it is created on first use
+static void generateThumbnail(
+    std::unique_ptr<ffmpegthumbnailer::VideoThumbnailer>& th,
+    const ThumbnailRequest& request,
+    std::vector<uint8_t>& img)
+{
+    if (!th) {
+        th = std::make_unique<ffmpegthumbnailer::VideoThumbnailer>(request.thumbSize, false, true, request.imageQuality, false);
+        th->setLogCallback(ffmpegThLogger);
+    }
+    // settings of the handler requesting the thumbnail
+    th->setThumbnailSize(request.thumbSize);
+    th->setImageQuality(request.imageQuality);
+    th->setSeekPercentage(request.seekPercentage);
+    th->clearFilters();
+
+    std::unique_ptr<ffmpegthumbnailer::FilmStripFilter> filmStripFilter;
+    std::unique_ptr<RotationFilter> rotationFilter;
+    if (request.rotation != 0) {
+        rotationFilter = std::make_unique<RotationFilter>(request.rotation);
+        th->addFilter(rotationFilter.get());
+    }
+    if (request.stripOverlay) {
+        filmStripFilter = std::make_unique<ffmpegthumbnailer::FilmStripFilter>();
+        th->addFilter(filmStripFilter.get());
+    }
+
+    log_debug("Generating thumbnail for file: {}", request.location.c_str());
+    try {
+        th->generateThumbnail(request.location, Jpeg, img);
+    } catch (...) {
+        th->clearFilters();
+        throw;
+    }
+    th->clearFilters();
+}
+
+/// @brief write thumbnail to cache dir, readers never see a partial file
+static void writeCacheFile(const fs::path& path, const std::byte* data, std::size_t size)
+{
+    static std::atomic_uint tempCount;
+    auto tempPath = path;
+    tempPath += fmt::format(".{}.tmp", tempCount++);
+    try {
+        fs::create_directories(path.parent_path());
+        GrbFile(tempPath).writeBinaryFile(data, size);
+        fs::rename(tempPath, path);
+    } catch (const std::exception& e) {
+        log_error("Failed to write thumbnail cache: {}", e.what());
+        std::error_code ec;
+        fs::remove(tempPath, ec);
+    }
+}
+
+/// @brief key of a thumbnail in the memory cache
+static std::string getCacheKey(std::chrono::seconds mtime, double rotation, const fs::path& location)
+{
+    return fmt::format("{}|{}|{}", mtime.count(), rotation, location.string());
+}
+
+/// @brief Low priority threads writing thumbnails of imported items to the cache dir
+class ThumbnailPregenerator {
+public:
+    /// @param threadCount number of threads
+    /// @param cpuBudget percentage of time a thread may spend generating thumbnails
+    /// @param clients pause generation while streams are served
+    /// @param cache memory cache, requests for a thumbnail being pre-generated wait for it
+    ThumbnailPregenerator(std::size_t threadCount, unsigned int cpuBudget, std::shared_ptr<ClientManager> clients, ThumbnailCache& cache)
+        : cpuBudget(std::clamp(cpuBudget, 1U, 100U))
+        , clients(std::move(clients))
+        , cache(cache)
+    {
+        for (std::size_t worker = 0; worker < threadCount; worker++)
+            threads.emplace_back([this] { run(); });
+    }
+
+    ~ThumbnailPregenerator()
+    {
+        {
+            AutoLock lock(mutex);
+            shutdown = true;
+        }
+        cond.notify_all();
+        for (auto&& thread : threads)
+            thread.join();
+    }
+
+    ThumbnailPregenerator(const ThumbnailPregenerator&) = delete;
+    ThumbnailPregenerator& operator=(const ThumbnailPregenerator&) = delete;
+
+    /// @brief queue thumbnail to be written to cacheFile
+    void add(ThumbnailRequest request, fs::path cacheFile, std::string key)
+    {
+        {
+            AutoLock lock(mutex);
+            if (done == queued) {
+                // new batch for progress
+                queued = 0;
+                done = 0;
+                failed = 0;
+            }
+            jobs.push_back(Job { std::move(request), std::move(cacheFile), std::move(key) });
+            queued++;
+        }
+        cond.notify_one();
+    }
+
+    /// @brief get progress of current batch
+    /// @return false if nothing is queued
+    bool getProgress(std::size_t& doneCount, std::size_t& queuedCount, bool& paused) const
+    {
+        AutoLock lock(mutex);
+        doneCount = done;
+        queuedCount = queued;
+        paused = isPaused;
+        return done < queued;
+    }
+
+private:
+    struct Job {
+        ThumbnailRequest request;
+        fs::path cacheFile;
+        /// @brief key of the memory cache
+        std::string key;
+    };
+
+    void run()
+    {
+        std::unique_ptr<ffmpegthumbnailer::VideoThumbnailer> th;
+        AutoLockU lock(mutex);
+        while (true) {
+            cond.wait(lock, [this] { return shutdown || !jobs.empty(); });
+            // streaming has precedence
+            while (!shutdown && clients && clients->getActiveStreams() > 0) {
+                isPaused = true;
+                cond.wait_for(lock, std::chrono::seconds(1));
+            }
+            isPaused = false;
+            if (shutdown)
+                return;
+            if (jobs.empty())
+                continue;
+
+            auto job = std::move(jobs.front());
+            jobs.pop_front();
+            lock.unlock();
+
+            auto start = std::chrono::steady_clock::now();
+            bool success = true;
+            std::error_code ec;
+            if (!fs::exists(job.cacheFile, ec)) {
+                try {
+                    // a request for the same thumbnail shares this generation, the result is not kept in memory
+                    cache.get(
+                        job.key, [&th, &job]() -> std::optional<std::vector<std::byte>> {
+                            std::error_code ec;
+                            if (fs::exists(job.cacheFile, ec))
+                                return GrbFile(job.cacheFile).readBinaryFile();
+                            std::vector<uint8_t> img;
+                            generateThumbnail(th, job.request, img);
+                            writeCacheFile(job.cacheFile, reinterpret_cast<std::byte*>(img.data()), img.size());
+                            auto first = reinterpret_cast<const std::byte*>(img.data());
+                            return std::vector<std::byte>(first, first + img.size());
+                        },
+                        false);
+                } catch (const std::exception& e) {
+                    log_debug("Thumbnail pre-generation failed for file {}: {}", job.request.location.c_str(), e.what());
+                    success = false;
+                }
+            }
+            auto busy = std::chrono::steady_clock::now() - start;
+
+            lock.lock();
+            done++;
+            if (!success)
+                failed++;
+            if (done == queued)
+                log_info("Pre-generated {} thumbnails, {} failed", done, failed);
+            // stay idle long enough to keep within the budget
+            if (cpuBudget < 100)
+                cond.wait_for(lock, busy * (100 - cpuBudget) / cpuBudget, [this] { return shutdown; });
+        }
+    }
+
+    unsigned int cpuBudget;
+    std::shared_ptr<ClientManager> clients;
+    ThumbnailCache& cache;
+    std::vector<std::thread> threads;
+    std::deque<Job> jobs;
+    std::size_t queued {};
+    std::size_t done {};
+    std::size_t failed {};
+    bool isPaused {};
+    bool shutdown {};
+
+    mutable std::mutex mutex;
+    std::condition_variable cond;
+    using AutoLock = std::scoped_lock<std::mutex>;
+    using AutoLockU = std::unique_lock<std::mutex>;
+};
+
+/// @brief Task shown in the web ui while thumbnails are pre-generated
+class ThumbnailTask : public GenericTask {
+public:
+    ThumbnailTask()
+        : GenericTask(TaskOwner::ContentManagerTask)
+    {
+        taskType = TaskType::GenerateThumbnails;
+        cancellable = false;
+    }
+    void run() override { }
+};
+
+/// @brief Workers generating thumbnails with their own thumbnailer and the memory cache in front of them
+class ThumbnailerPool {
+public:
+    ThumbnailerPool(std::size_t threadCount, std::size_t memoryCacheSize)
+        : workers("thumbnailer", threadCount)
+        , thumbnailers(threadCount)
+        , cache(memoryCacheSize)
+    {
+    }
+
+    /// @brief get pool shared by all handlers, it is released when the last handler is gone
+    static std::shared_ptr<ThumbnailerPool> getInstance(std::size_t threadCount, std::size_t memoryCacheSize)
+    {
+        AutoLock lock(instanceMutex);
+        auto pool = instance.lock();
+        if (!pool) {
+            pool = std::make_shared<ThumbnailerPool>(std::max(threadCount, std::size_t(1)), memoryCacheSize);
+            instance = pool;
+            log_debug("Created thumbnailer pool with {} workers and {} bytes memory cache", pool->thumbnailers.size(), memoryCacheSize);
+        }
+        return pool;
+    }
+
+    /// @brief get current pool without creating it
+    static std::shared_ptr<ThumbnailerPool> getCurrent()
+    {
+        AutoLock lock(instanceMutex);
+        return instance.lock();
+    }
+
+    /// @brief get pre-generation threads, they are started on first use
+    std::shared_ptr<ThumbnailPregenerator> getPregenerator(std::size_t threadCount, unsigned int cpuBudget, const std::shared_ptr<ClientManager>& clients)
+    {
+        AutoLock lock(pregeneratorMutex);
+        if (!pregenerator) {
+            pregenerator = std::make_shared<ThumbnailPregenerator>(threadCount, cpuBudget, clients, cache);
+            log_debug("Started {} threads for thumbnail pre-generation with {}% cpu budget", threadCount, cpuBudget);
+        }
+        return pregenerator;
+    }
+
+    std::shared_ptr<ThumbnailPregenerator> getPregenerator() const
+    {
+        AutoLock lock(pregeneratorMutex);
+        return pregenerator;
+    }
+
+    WorkerPool workers;
+    /// @brief thumbnailer of each worker, only used by its worker
+    std::vector<std::unique_ptr<ffmpegthumbnailer::VideoThumbnailer>> thumbnailers;
+    ThumbnailCache cache;
+
+private:
+    std::shared_ptr<ThumbnailPregenerator> pregenerator;
+    mutable std::mutex pregeneratorMutex;
+
+    static std::mutex instanceMutex;
+    static std::weak_ptr<ThumbnailerPool> instance;
+    using AutoLock = std::scoped_lock<std::mutex>;
+};
+
+std::mutex ThumbnailerPool::instanceMutex;
+std::weak_ptr<ThumbnailerPool> ThumbnailerPool::instance;
+
 fs::path FfmpegThumbnailerHandler::getThumbnailCachePath(const fs::path& base, const fs::path& movie)
 {
     assert(movie.is_absolute());
@@ -148,13 +445,7 @@ void FfmpegThumbnailerHandler::writeThumbnailCacheFile(
     const std::byte* data,
     std::size_t size) const
 {
-    try {
-        auto path = getThumbnailCachePath(getThumbnailCacheBasePath(), movieFilename);
-        fs::create_directories(path.parent_path());
-        GrbFile(path).writeBinaryFile(data, size);
-    } catch (const std::runtime_error& e) {
-        log_error("Failed to write thumbnail cache: {}", e.what());
-    }
+    writeCacheFile(getThumbnailCachePath(getThumbnailCacheBasePath(), movieFilename), data, size);
 }
 
 std::unique_ptr<IOHandler> FfmpegThumbnailerHandler::serveContent(
@@ -173,60 +464,95 @@ std::unique_ptr<IOHandler> FfmpegThumbnailerHandler::serveContent(
         return nullptr;
     }
 
+    auto rotation = getRotation(resource);
+    try {
+        // requests for size and content of the same thumbnail share one generation
+        auto key = getCacheKey(item->getMTime(), rotation, itemLocation);
+        auto data = getPool()->cache.get(key, [this, &itemLocation, rotation] { return createThumbnail(itemLocation, rotation); });
+        if (!data)
+            return nullptr;
+        return std::make_unique<MemIOHandler>(data->data(), data->size());
+    } catch (const std::logic_error& e) {
+        log_warning("Thumbnail generation failed for file {}: {}", itemLocation.c_str(), e.what());
+        return nullptr;
+    }
+}
+
+double FfmpegThumbnailerHandler::getRotation(const std::shared_ptr<CdsResource>& resource) const
+{
+    if (!doRotate || !resource)
+        return 0;
+
+    // 1: Normal (0° rotation)
+    // 3: Upside-down (180° rotation)
+    // 6: Rotated 90° counterclockwise (270° clockwise)
+    // 8: Rotated 90° clockwise (270° counterclockwise)
+    int orientation = stoiString(resource->getAttribute(ResourceAttribute::ORIENTATION));
+    if (orientation == 6)
+        return 90;
+    if (orientation == 8)
+        return -90;
+    if (orientation == 3)
+        return 180;
+    return 0;
+}
+
+void FfmpegThumbnailerHandler::pregenerate(const std::shared_ptr<CdsItem>& item, const std::shared_ptr<CdsResource>& resource)
+{
+    auto itemLocation = item->getLocation();
+    auto rotation = getRotation(resource);
+    auto request = ThumbnailRequest { itemLocation, rotation, thumbSize, imageQuality, seekPercentage, stripOverlay };
+    auto cacheFile = getThumbnailCachePath(getThumbnailCacheBasePath(), itemLocation);
+    getPool()->getPregenerator(pregenerateThreads, pregenerateBudget, clients)->add(std::move(request), std::move(cacheFile), getCacheKey(item->getMTime(), rotation, itemLocation));
+}
+
+std::shared_ptr<GenericTask> FfmpegThumbnailerHandler::getPregenerationTask()
+{
+    auto thumbPool = ThumbnailerPool::getCurrent();
+    auto pregenerator = thumbPool ? thumbPool->getPregenerator() : nullptr;
+    std::size_t done = 0;
+    std::size_t queued = 0;
+    bool paused = false;
+    if (!pregenerator || !pregenerator->getProgress(done, queued, paused))
+        return nullptr;
+
+    auto task = std::make_shared<ThumbnailTask>();
+    task->setDescription(fmt::format("Generating thumbnails: {} of {}{}", done, queued, paused ? " (paused while streaming)" : ""));
+    return task;
+}
+
+std::shared_ptr<ThumbnailerPool> FfmpegThumbnailerHandler::getPool()
+{
+    std::scoped_lock lock(poolMutex);
+    if (!pool)
+        pool = ThumbnailerPool::getInstance(threadCount, memoryCacheSize);
+    return pool;
+}
+
+std::optional<std::vector<std::byte>> FfmpegThumbnailerHandler::createThumbnail(const fs::path& itemLocation, double rotation)
+{
     if (cacheEnabled) {
         auto data = readThumbnailCacheFile(itemLocation);
         if (data) {
             log_debug("Returning cached thumbnail for file: {}", itemLocation.c_str());
-            return std::make_unique<MemIOHandler>(data->data(), data->size());
+            return data;
         }
     }
 
-    std::unique_ptr<ffmpegthumbnailer::FilmStripFilter> filmStripFilter;
-    std::unique_ptr<RotationFilter> rotationFilter;
-    try {
-        auto thumbLock = std::scoped_lock<std::mutex>(thumb_mutex);
-
-        auto th = ffmpegthumbnailer::VideoThumbnailer(thumbSize, false, true, imageQuality, false);
-
-        th.setLogCallback(ffmpegThLogger);
-        th.setSeekPercentage(seekPercentage);
-        if (doRotate && resource) {
-            // 1: Normal (0° rotation)
-            // 3: Upside-down (180° rotation)
-            // 6: Rotated 90° counterclockwise (270° clockwise)
-            // 8: Rotated 90° clockwise (270° counterclockwise)
-            int orientation = stoiString(resource->getAttribute(ResourceAttribute::ORIENTATION));
-            double rotation = 0;
-            if (orientation == 6) {
-                rotation = 90;
-            } else if (orientation == 8) {
-                rotation = -90;
-            } else if (orientation == 3) {
-                rotation = 180;
-            }
-            if (rotation != 0) {
-                rotationFilter = std::make_unique<RotationFilter>(rotation);
-                th.addFilter(rotationFilter.get());
-            }
-        }
-        if (stripOverlay) {
-            filmStripFilter = std::make_unique<ffmpegthumbnailer::FilmStripFilter>();
-            th.addFilter(filmStripFilter.get());
-        }
+    auto thumbPool = getPool();
+    auto request = ThumbnailRequest { itemLocation, rotation, thumbSize, imageQuality, seekPercentage, stripOverlay };
+    std::vector<uint8_t> img;
+    auto job = thumbPool->workers.submit([&thumbPool, &request, &img](std::size_t worker) {
+        generateThumbnail(thumbPool->thumbnailers.at(worker), request, img);
+    });
+    // wait for worker, exceptions of the thumbnailer are passed on
+    job.get();
 
-        log_debug("Generating thumbnail for file: {}", itemLocation.c_str());
-
-        std::vector<uint8_t> img;
-        th.generateThumbnail(itemLocation, Jpeg, img);
-        if (cacheEnabled) {
-            writeThumbnailCacheFile(itemLocation, reinterpret_cast<std::byte*>(img.data()), img.size());
-        }
-
-        return std::make_unique<MemIOHandler>(img.data(), img.size());
-    } catch (const std::logic_error& e) {
-        log_warning("Thumbnail generation failed for file {}: {}", itemLocation.c_str(), e.what());
-        return nullptr;
+    if (cacheEnabled) {
+        writeThumbnailCacheFile(itemLocation, reinterpret_cast<std::byte*>(img.data()), img.size());
     }
+    auto first = reinterpret_cast<const std::byte*>(img.data());
+    return std::vector<std::byte>(first, first + img.size());
 }
 
 bool FfmpegThumbnailerHandler::fillMetadata(
@@ -260,6 +586,9 @@ bool FfmpegThumbnailerHandler::fillMetadata(
         thumbResource->addAttribute(ResourceAttribute::RESOLUTION, fmt::format("{}x{}", x, y));
         item->addResource(thumbResource);
         log_debug("Adding resource to {} for {} thumbnail", itemLocation.c_str(), EnumMapper::mapObjectType(mediaType));
+        // write thumbnail to cache dir before the item is browsed
+        if (cacheEnabled && pregenerateThreads > 0)
+            pregenerate(item, thumbResource);
         return true;
 
     } catch (const std::runtime_error& e) {
@@ -284,6 +613,11 @@ FfmpegThumbnailerHandler::FfmpegThumbnailerHandler(
         cacheEnabled = config->getBoolOption(ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_CACHE_DIR_ENABLED);
         stripOverlay = config->getBoolOption(ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_FILMSTRIP_OVERLAY);
         doRotate = config->getBoolOption(ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_ROTATE);
+        threadCount = config->getUIntOption(ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_THREADS);
+        memoryCacheSize = std::size_t(config->getUIntOption(ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_MEMORY_CACHE_SIZE)) * 1024;
+        pregenerateThreads = config->getUIntOption(ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_PREGENERATE_THREADS);
+        pregenerateBudget = config->getUIntOption(ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_PREGENERATE_CPU_BUDGET);
+        clients = context->getClients();
         auto configuredDir = config->getOption(ConfigVal::SERVER_EXTOPTS_FFMPEGTHUMBNAILER_CACHE_DIR);
         if (!configuredDir.empty()) {
             cachePath = configuredDir;
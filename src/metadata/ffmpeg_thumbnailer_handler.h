@@ -32,8 +32,12 @@ Gerbera - https://gerbera.io/
 #include <memory>
 #include <mutex>
 
+class CdsItem;
 class CdsObject;
+class ClientManager;
+class GenericTask;
 class IOHandler;
+class ThumbnailerPool;
 enum class ObjectType;
 
 /// @brief class to treat virtual resource for videos and images to generate thumbnails
@@ -57,15 +61,19 @@ public:
         const std::shared_ptr<CdsObject>& obj,
         const std::shared_ptr<CdsResource>& resource) override;
 
+    /// @brief get progress of thumbnail pre-generation
+    /// @return nullptr if no thumbnails are waiting
+    static std::shared_ptr<GenericTask> getPregenerationTask();
+
 protected:
     // Needed in tests
     const fs::path& getThumbnailCacheBasePath() const { return cachePath; }
     static fs::path getThumbnailCachePath(const fs::path& base, const fs::path& movie);
 
 private:
-    /// @brief The ffmpegthumbnailer code (ffmpeg?) is not threading safe.
-    /// Add a lock around the usage to avoid crashing randomly.
-    mutable std::mutex thumb_mutex;
+    /// @brief workers and memory cache shared by all thumbnailer handlers, created on first request
+    std::shared_ptr<ThumbnailerPool> pool;
+    mutable std::mutex poolMutex;
     /// @brief location of cached thumbnails
     fs::path cachePath;
     /// @brief distinguish video or image
@@ -86,6 +94,25 @@ private:
     bool stripOverlay;
     /// @brief rotate images automatically based on orientation
     bool doRotate;
+    /// @brief number of thumbnails generated at the same time
+    std::size_t threadCount;
+    /// @brief size of generated thumbnails kept in memory
+    std::size_t memoryCacheSize;
+    /// @brief number of threads writing thumbnails of imported items to the cache dir
+    std::size_t pregenerateThreads {};
+    /// @brief percentage of time pre-generation threads may be busy
+    unsigned int pregenerateBudget {};
+    /// @brief active streams pause pre-generation
+    std::shared_ptr<ClientManager> clients;
+
+    /// @brief get shared pool
+    std::shared_ptr<ThumbnailerPool> getPool();
+    /// @brief read thumbnail from cache dir or generate it in the pool
+    std::optional<std::vector<std::byte>> createThumbnail(const fs::path& itemLocation, double rotation);
+    /// @brief get rotation of thumbnail from orientation of resource
+    double getRotation(const std::shared_ptr<CdsResource>& resource) const;
+    /// @brief queue thumbnail for generation in the background
+    void pregenerate(const std::shared_ptr<CdsItem>& item, const std::shared_ptr<CdsResource>& resource);
 
     /// @brief cache generated thumb
     void writeThumbnailCacheFile(
@@ -41,6 +41,7 @@
 #include "context.h"
 #include "exceptions.h"
 #include "metadata_enums.h"
+#include "util/file_probe.h"
 #include "util/tools.h"
 
 #ifdef HAVE_EXIV2
@@ -151,7 +152,8 @@ MetadataService::MetadataService(const std::shared_ptr<Context>& context, const
 bool MetadataService::extractMetaData(
     const std::shared_ptr<CdsItem>& item,
     const fs::directory_entry& dirEnt,
-    std::vector<int>& newIds)
+    std::vector<int>& newIds,
+    const std::shared_ptr<FileProbe>& probe)
 {
     std::error_code ec;
     if (!isRegularFile(dirEnt, ec))
@@ -169,7 +171,7 @@ bool MetadataService::extractMetaData(
 
     std::string contentType = getValueOrDefault(mappings, mimetype);
     bool isOggTheora = false;
-    if ((contentType == CONTENT_TYPE_OGG) && (isTheora(item->getLocation()))) {
+    if ((contentType == CONTENT_TYPE_OGG) && (probe ? isTheora(*probe) : isTheora(item->getLocation()))) {
         item->setFlag(ObjectFlag::OggTheora);
         isOggTheora = true;
     }
@@ -212,7 +214,7 @@ bool MetadataService::extractMetaData(
 
 #ifndef HAVE_FFMPEG
     if (contentType == CONTENT_TYPE_AVI) {
-        std::string fourcc = getAVIFourCC(dirEnt.path());
+        std::string fourcc = probe ? getAVIFourCC(*probe) : getAVIFourCC(dirEnt.path());
         if (!fourcc.empty()) {
             resource->addOption(RESOURCE_OPTION_FOURCC, fourcc);
             result = true;
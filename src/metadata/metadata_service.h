@@ -81,10 +81,12 @@ public:
     explicit MetadataService(const std::shared_ptr<Context>& context, const std::shared_ptr<Content>& content);
 
     /// @brief read metadata from directly from media file
+    /// @param probe header of the file if it was already read
     bool extractMetaData(
         const std::shared_ptr<CdsItem>& item,
         const fs::directory_entry& dirEnt,
-        std::vector<int>& newIds);
+        std::vector<int>& newIds,
+        const std::shared_ptr<FileProbe>& probe = {});
     /// @brief add external information to metadata
     bool attachResourceFiles(
         const std::shared_ptr<CdsItem>& item,
@@ -0,0 +1,82 @@
+/*GRB*
+    Gerbera - https://gerbera.io/
+
+    thumbnail_cache.cc - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file metadata/thumbnail_cache.cc
+/// @brief Implementation of the ThumbnailCache class.
+
+#include "thumbnail_cache.h" // API
+
+ThumbnailCache::ThumbnailCache(std::size_t capacity)
+    : cache(capacity, [](const Data& data) { return data->size(); })
+{
+}
+
+ThumbnailCache::Data ThumbnailCache::get(const std::string& key, const Generator& generate, bool keep)
+{
+    std::promise<Data> promise;
+    {
+        AutoLockU lock(mutex);
+        auto cached = cache.get(key);
+        if (cached) {
+            hits++;
+            return *cached;
+        }
+        auto running = inFlight.find(key);
+        if (running != inFlight.end()) {
+            // wait for the running generation without blocking other keys
+            auto result = running->second;
+            hits++;
+            lock.unlock();
+            return result.get();
+        }
+        misses++;
+        inFlight.emplace(key, promise.get_future().share());
+    }
+
+    Data data;
+    try {
+        auto result = generate();
+        if (result)
+            data = std::make_shared<const std::vector<std::byte>>(std::move(*result));
+    } catch (...) {
+        {
+            AutoLock lock(mutex);
+            inFlight.erase(key);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    {
+        AutoLock lock(mutex);
+        inFlight.erase(key);
+        // too large thumbnails are not kept
+        if (keep && data)
+            cache.put(key, data);
+    }
+    promise.set_value(data);
+    return data;
+}
+
+std::size_t ThumbnailCache::getBytes() const
+{
+    AutoLock lock(mutex);
+    return cache.getTotalWeight();
+}
@@ -0,0 +1,77 @@
+/*GRB*
+    Gerbera - https://gerbera.io/
+
+    thumbnail_cache.h - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file metadata/thumbnail_cache.h
+/// @brief Definition of the ThumbnailCache class.
+
+#ifndef __THUMBNAIL_CACHE_H__
+#define __THUMBNAIL_CACHE_H__
+
+#include "util/lru_cache.h"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// @brief Memory cache of generated thumbnails limited by the size of the images
+///
+/// Each thumbnail is generated only once: concurrent requests for a key that
+/// is being generated wait for the running generation instead of starting another one.
+class ThumbnailCache {
+public:
+    using Data = std::shared_ptr<const std::vector<std::byte>>;
+    using Generator = std::function<std::optional<std::vector<std::byte>>()>;
+
+    explicit ThumbnailCache(std::size_t capacity);
+
+    ThumbnailCache(const ThumbnailCache&) = delete;
+    ThumbnailCache& operator=(const ThumbnailCache&) = delete;
+
+    /// @brief get cached thumbnail or run generator
+    /// @param keep add generated thumbnail to the cache, waiting callers get it in any case
+    /// @return thumbnail or nullptr if generator failed, exceptions of generator are passed to all waiting callers
+    Data get(const std::string& key, const Generator& generate, bool keep = true);
+
+    std::size_t getHits() const { return hits; }
+    std::size_t getMisses() const { return misses; }
+    /// @brief get number of bytes of all cached thumbnails
+    std::size_t getBytes() const;
+
+private:
+    /// @brief thumbnails weighted by their size in bytes
+    LruCache<std::string, Data> cache;
+    /// @brief results of running generations
+    std::unordered_map<std::string, std::shared_future<Data>> inFlight;
+    std::atomic_size_t hits {};
+    std::atomic_size_t misses {};
+
+    mutable std::mutex mutex;
+    using AutoLock = std::scoped_lock<std::mutex>;
+    using AutoLockU = std::unique_lock<std::mutex>;
+};
+
+#endif // __THUMBNAIL_CACHE_H__
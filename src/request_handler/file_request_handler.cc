@@ -38,7 +38,6 @@
 #include "config/config.h"
 #include "config/config_val.h"
 #include "config/result/transcoding.h"
-#include "config/setup/config_setup_path.h"
 #include "content/content.h"
 #include "database/database.h"
 #include "database/db_param.h"
@@ -57,13 +56,6 @@
 #include "util/url_utils.h"
 #include "web/session_manager.h"
 
-#ifdef HAVE_ZIP
-#include <condition_variable>
-#include <libzippp/libzippp.h>
-#include <mutex>
-#include <thread>
-#endif
-
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -83,8 +75,9 @@ bool FileRequestHandler::getInfo(
 {
     log_debug("Start: {}", filename);
 
-    auto params = URLUtils::parseParameters(filename, LINK_FILE_REQUEST_HANDLER);
-    auto obj = loadObject(params);
+    parseRequest(filename);
+    auto& params = requestParams;
+    auto obj = requestObject;
 
     auto resourceId = parseResourceInfo(params);
     std::string zipRequest = getValueOrDefault(params, URL_PARAM_ZIP_REQUEST);
@@ -164,8 +157,9 @@ std::string FileRequestHandler::getZipInfo(
 {
     std::string mimeType = "application/zip";
 #ifdef HAVE_ZIP
+    zipHandler = createZip(obj);
     UpnpFileInfo_set_IsReadable(info, true);
-    UpnpFileInfo_set_FileLength(info, UPNP_USING_CHUNKED);
+    UpnpFileInfo_set_FileLength(info, zipHandler->getSize());
 #else
     UpnpFileInfo_set_IsReadable(info, false);
 #endif
@@ -256,6 +250,7 @@ std::string FileRequestHandler::getResourceInfo(
                 off_t size = ioHandler->tell();
                 ioHandler->close();
                 log_debug("info {}={}", obj->getID(), size);
+                // generated thumbnails are kept in the memory cache for the following content request
                 UpnpFileInfo_set_FileLength(info, size);
             } else {
                 UpnpFileInfo_set_FileLength(info, 0);
@@ -289,7 +284,7 @@ std::shared_ptr<MetadataHandler> FileRequestHandler::getResourceMetadataHandler(
         auto objID = stoiString(resource->getAttribute(ResourceAttribute::FANART_OBJ_ID));
         auto resID = stoiString(resource->getAttribute(ResourceAttribute::FANART_RES_ID));
         try {
-            auto resObj = (objID > CDS_ID_ROOT && objID != obj->getID()) ? database->loadObject(objID) : nullptr;
+            auto resObj = (objID > CDS_ID_ROOT && objID != obj->getID()) ? database->loadCachedObject(objID, UNUSED_CLIENT_GROUP) : nullptr;
             if (resObj) {
                 auto resRes = resObj->getResource(resID);
                 if (resRes) {
@@ -307,67 +302,6 @@ std::shared_ptr<MetadataHandler> FileRequestHandler::getResourceMetadataHandler(
     return metadataService->getHandler(resHandler);
 }
 
-#ifdef HAVE_ZIP
-class ContainerProgressListener : public libzippp::ZipProgressListener {
-private:
-    bool done { false };
-    std::condition_variable cond;
-
-public:
-    ContainerProgressListener() { }
-    virtual ~ContainerProgressListener() { }
-
-    void wait(std::unique_lock<std::mutex>& lock)
-    {
-        if (!done)
-            cond.wait(lock); // waiting for the task to complete
-    }
-
-    int cancel() override
-    {
-        return 0;
-    }
-
-    void progression(double p) override
-    {
-        log_debug("-- Progress {}: ", p);
-        if (p == 1) {
-            log_debug("-- Done {}: ", p);
-            done = true;
-            cond.notify_one();
-        }
-    }
-};
-
-static int archive(
-    const fs::path& path,
-    const std::map<std::string, fs::path>& content)
-{
-    log_debug("start: {}", path.string());
-    libzippp::ZipArchive zipFile(path);
-    zipFile.open(libzippp::ZipArchive::Write);
-    // register the listener
-    ContainerProgressListener cpl;
-    std::mutex mutex;
-    std::unique_lock<decltype(mutex)> lock(mutex);
-    zipFile.addProgressListener(&cpl);
-
-    if (!content.empty())
-        zipFile.setProgressPrecision(1.0 / content.size());
-
-    for (auto&& [name, path] : content) {
-        log_debug("Add {} : {}", name, path.c_str());
-        zipFile.addFile(fmt::format("{}{}", name, path.extension().c_str()).c_str(), path.c_str());
-    }
-    zipFile.close();
-
-    log_debug("wait: {}", path.string());
-    cpl.wait(lock);
-    log_debug("end: {}", path.string());
-    return 0;
-}
-#endif
-
 std::unique_ptr<IOHandler> FileRequestHandler::openResource(
     std::shared_ptr<CdsObject>& obj,
     std::size_t resourceId)
@@ -395,11 +329,9 @@ std::unique_ptr<IOHandler> FileRequestHandler::openTranscoding(
     return transcodeDispatcher->serveContent(transcodingProfile, path, obj, group, range);
 }
 
-std::unique_ptr<IOHandler> FileRequestHandler::openZip(
+std::unique_ptr<ZipIOHandler> FileRequestHandler::createZip(
     const std::shared_ptr<CdsObject>& obj)
 {
-#ifdef HAVE_ZIP
-    auto path = ConfigPathSetup::Home / fmt::format("Download-{}.zip", obj->getID());
     auto browseParam = BrowseParam(obj, BROWSE_DIRECT_CHILDREN | BROWSE_ITEMS);
     auto result = database->browse(browseParam);
     std::map<std::string, fs::path> folderContent;
@@ -407,13 +339,22 @@ std::unique_ptr<IOHandler> FileRequestHandler::openZip(
     for (auto&& cdsObj : result) {
         folderContent[cdsObj->getSortKey()] = cdsObj->getLocation();
     }
-    try {
-        archive(path, folderContent);
-        return std::make_unique<ZipIOHandler>(path);
-    } catch (std::runtime_error& ex) {
-        log_debug(ex.what());
-        return nullptr;
+    std::vector<ZipIOHandler::ZipEntry> content;
+    content.reserve(folderContent.size());
+    for (auto&& [name, path] : folderContent) {
+        content.push_back({ fmt::format("{}{}", name, path.extension().string()), path });
     }
+    return std::make_unique<ZipIOHandler>(content);
+}
+
+std::unique_ptr<IOHandler> FileRequestHandler::openZip(
+    const std::shared_ptr<CdsObject>& obj)
+{
+#ifdef HAVE_ZIP
+    // layout was announced by getInfo, so the same archive must be streamed
+    if (zipHandler)
+        return std::move(zipHandler);
+    return createZip(obj);
 #else
     return nullptr;
 #endif
@@ -431,8 +372,10 @@ std::unique_ptr<IOHandler> FileRequestHandler::open(
         throw_std_runtime_error("UPNP_WRITE unsupported");
     }
 
-    auto params = URLUtils::parseParameters(filename, LINK_FILE_REQUEST_HANDLER);
-    auto obj = loadObject(params);
+    // handler is reused from getInfo of the same request
+    parseRequest(filename);
+    auto& params = requestParams;
+    auto obj = requestObject;
     auto resourceId = parseResourceInfo(params);
     auto res = obj->getResource(resourceId);
 
@@ -471,7 +414,19 @@ std::unique_ptr<IOHandler> FileRequestHandler::open(
     }
 
     // Boring old file
-    return std::make_unique<FileIOHandler>(path, offset);
+    auto readAhead = std::size_t(config->getUIntOption(ConfigVal::SERVER_STREAMING_READ_AHEAD)) * 1024;
+    auto mmapSize = off_t(config->getUIntOption(ConfigVal::SERVER_STREAMING_MMAP_SIZE)) * 1024 * 1024;
+    return std::make_unique<FileIOHandler>(path, offset, readAhead, mmapSize);
+}
+
+void FileRequestHandler::parseRequest(const char* filename)
+{
+    if (requestObject && requestFilename == filename)
+        return;
+
+    requestParams = URLUtils::parseParameters(filename, LINK_FILE_REQUEST_HANDLER);
+    requestObject = loadObject(requestParams, true);
+    requestFilename = filename;
 }
 
 std::size_t FileRequestHandler::parseResourceInfo(
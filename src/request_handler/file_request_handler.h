@@ -36,6 +36,8 @@
 
 #include "request_handler.h"
 
+#include "iohandler/zip_io_handler.h"
+
 #include <memory>
 
 #include "upnp/xml_builder.h"
@@ -70,6 +72,17 @@ public:
         enum UpnpOpenFileMode mode) override;
 
 private:
+    /// @brief url parsed by getInfo
+    std::string requestFilename;
+    /// @brief parameters of requestFilename
+    std::map<std::string, std::string> requestParams;
+    /// @brief object loaded for requestFilename, it may be shared via the object cache
+    std::shared_ptr<CdsObject> requestObject;
+    /// @brief archive prepared by getInfo and streamed by open
+    std::unique_ptr<ZipIOHandler> zipHandler;
+
+    /// @brief parse url and load object unless it was done for the same url before
+    void parseRequest(const char* filename);
     static std::size_t parseResourceInfo(
         const std::map<std::string, std::string>& params);
     std::shared_ptr<MetadataHandler> getResourceMetadataHandler(
@@ -112,6 +125,9 @@ private:
         const std::string& trProfile,
         const std::string& group,
         const std::map<std::string, std::string>& params);
+    /// @brief collect items of the container for the zip archive
+    std::unique_ptr<ZipIOHandler> createZip(
+        const std::shared_ptr<CdsObject>& obj);
     /// @brief open zip archive stream
     std::unique_ptr<IOHandler> openZip(
         const std::shared_ptr<CdsObject>& obj);
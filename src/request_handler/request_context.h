@@ -0,0 +1,69 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    request_context.h - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file request_handler/request_context.h
+/// @brief Definition of the RequestContext class.
+
+#ifndef __REQUEST_CONTEXT_H__
+#define __REQUEST_CONTEXT_H__
+
+#include "request_handler.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+/// @brief contexts of requests that were not opened are dropped after this time
+static constexpr auto REQUEST_CONTEXT_TIMEOUT = std::chrono::seconds(60);
+
+/// @brief State of a single web server request
+///
+/// It is created when the web server asks for information on the requested file and passed
+/// as request cookie to open, read, seek and close of the same request, so the url is
+/// parsed and the object is loaded only once.
+class RequestContext {
+public:
+    RequestContext(std::string filename, std::string link, bool isUi)
+        : filename(std::move(filename))
+        , link(std::move(link))
+        , isUi(isUi)
+    {
+    }
+
+    /// @brief url as received from the web server
+    std::string filename;
+    /// @brief unescaped url
+    std::string link;
+    /// @brief request is for the web ui
+    bool isUi;
+    /// @brief client details for the request
+    std::shared_ptr<Quirks> quirks;
+    /// @brief handler that answered the information request, it keeps the parsed request
+    std::unique_ptr<RequestHandler> handler;
+    /// @brief handler can be reused for open
+    bool reuseHandler {};
+    /// @brief file was opened, context is removed on close
+    bool opened {};
+    /// @brief contexts of requests that were never opened are removed after a while
+    std::chrono::steady_clock::time_point created { std::chrono::steady_clock::now() };
+};
+
+#endif // __REQUEST_CONTEXT_H__
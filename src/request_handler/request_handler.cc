@@ -57,7 +57,7 @@ RequestHandler::RequestHandler(std::shared_ptr<Content> content, std::shared_ptr
 
 RequestHandler::~RequestHandler() = default;
 
-std::shared_ptr<CdsObject> RequestHandler::loadObject(const std::map<std::string, std::string>& params) const
+std::shared_ptr<CdsObject> RequestHandler::loadObject(const std::map<std::string, std::string>& params, bool cached) const
 {
     auto it = params.find("object_id");
     if (it == params.end()) {
@@ -70,5 +70,5 @@ std::shared_ptr<CdsObject> RequestHandler::loadObject(const std::map<std::string
         group = it->second;
     }
 
-    return database->loadObject(objectID, group);
+    return cached ? database->loadCachedObject(objectID, group) : database->loadObject(objectID, group);
 }
@@ -85,7 +85,10 @@ public:
     /// @return the appropriate IOHandler for the request.
     virtual std::unique_ptr<IOHandler> open(const char* filename, const std::shared_ptr<Quirks>& quirks, enum UpnpOpenFileMode mode) = 0;
 
-    std::shared_ptr<CdsObject> loadObject(const std::map<std::string, std::string>& params) const;
+    /// @brief load object requested by url parameters
+    /// @param params parsed url parameters
+    /// @param cached object is only read and may be shared with other requests via the object cache
+    std::shared_ptr<CdsObject> loadObject(const std::map<std::string, std::string>& params, bool cached = false) const;
 
 protected:
     std::shared_ptr<Content> content;
@@ -47,6 +47,7 @@
 #include "metadata/metadata_service.h"
 #include "request_handler/device_description_handler.h"
 #include "request_handler/file_request_handler.h"
+#include "request_handler/request_context.h"
 #include "request_handler/request_handler.h"
 #include "request_handler/ui_handler.h"
 #include "request_handler/upnp_desc_handler.h"
@@ -104,6 +105,7 @@ void Server::init(
     const std::shared_ptr<ConfigDefinition>& definition,
     bool offln,
     bool dropDatabase,
+    bool checkDatabase,
     bool initLastFM)
 {
     offline = offln;
@@ -129,6 +131,12 @@ void Server::init(
 
     database->init();
 
+    if (checkDatabase) {
+        auto wrongCount = database->checkChildCounts(true);
+        log_info("Repaired child counts of {} containers", wrongCount);
+        return;
+    }
+
     config->updateConfigFromDatabase(database);
 
     serverUDN = config->getOption(ConfigVal::SERVER_UDN);
@@ -137,7 +145,7 @@ void Server::init(
     }
     aliveAdvertisementInterval = config->getIntOption(ConfigVal::SERVER_ALIVE_INTERVAL);
 
-    clientManager = std::make_shared<ClientManager>(config, database, self);
+    clientManager = std::make_shared<ClientManager>(config, database, self, timer);
     sessionManager = std::make_shared<Web::SessionManager>(config, timer);
     context = std::make_shared<Context>(definition, config, clientManager, mime, database, sessionManager, converterManager);
 
@@ -493,6 +501,9 @@ void Server::shutdown()
 
     sessionManager.reset();
 
+    if (clientManager)
+        clientManager->shutdown();
+
     if (database->threadCleanupRequired()) {
         try {
             database->threadCleanup();
@@ -733,6 +744,36 @@ int Server::HostValidateCallback(const char* host, void* cookie)
     return UPNP_E_BAD_HTTPMSG;
 }
 
+void Server::addRequestContext(const std::shared_ptr<RequestContext>& requestContext) const
+{
+    auto now = std::chrono::steady_clock::now();
+    std::scoped_lock lock(requestMutex);
+    // requests answered by information only (e.g. HEAD) are never opened or closed
+    for (auto it = requestContexts.begin(); it != requestContexts.end();) {
+        if (!it->second->opened && now - it->second->created > REQUEST_CONTEXT_TIMEOUT)
+            it = requestContexts.erase(it);
+        else
+            ++it;
+    }
+    requestContexts.emplace(requestContext.get(), requestContext);
+}
+
+std::shared_ptr<RequestContext> Server::openRequestContext(const void* requestCookie) const
+{
+    std::scoped_lock lock(requestMutex);
+    auto it = requestContexts.find(requestCookie);
+    if (it == requestContexts.end())
+        return nullptr;
+    it->second->opened = true;
+    return it->second;
+}
+
+void Server::removeRequestContext(const void* requestCookie) const
+{
+    std::scoped_lock lock(requestMutex);
+    requestContexts.erase(requestCookie);
+}
+
 int Server::GetInfoCallback(
     const char* filename,
     UpnpFileInfo* info,
@@ -742,17 +783,22 @@ int Server::GetInfoCallback(
     try {
         log_debug("getInfo({})", filename);
         auto server = static_cast<const Server*>(cookie);
-        auto quirks = server->getQuirks(info, startswith(filename, fmt::format("/{}", CONTENT_UI_HANDLER)));
+        std::string link = URLUtils::urlUnescape(filename);
+        auto requestContext = std::make_shared<RequestContext>(filename, link, startswith(link, fmt::format("/{}", CONTENT_UI_HANDLER)));
+        auto quirks = server->getQuirks(info, requestContext->isUi);
         auto client = quirks->getClient();
         if (quirks && !quirks->isAllowed()) {
             auto clientIp = client && client->addr ? client->addr->getHostName() : "unknown";
             log_debug("Client blocked {}", clientIp);
             return -1;
         }
-        auto reqHandler = server->createRequestHandler(filename, quirks);
-        std::string link = URLUtils::urlUnescape(filename);
-        reqHandler->getInfo(startswith(link, fmt::format("/{}", CONTENT_UI_HANDLER)) ? filename : link.c_str(), info);
-        *requestCookie = client;
+        requestContext->quirks = quirks;
+        requestContext->handler = server->createRequestHandler(filename, quirks);
+        requestContext->handler->getInfo(requestContext->isUi ? filename : link.c_str(), info);
+        // file requests keep the parsed url and the object for open
+        requestContext->reuseHandler = startswith(link, fmt::format("/{}", CONTENT_MEDIA_HANDLER));
+        server->addRequestContext(requestContext);
+        *requestCookie = requestContext.get();
         return 0;
     } catch (const ServerShutdownException&) {
         return -1;
@@ -771,23 +817,45 @@ UpnpWebFileHandle Server::OpenCallback(
     const void* cookie,
     const void* requestCookie)
 {
+    auto server = static_cast<const Server*>(cookie);
+    // libupnp only calls close for opened files, so the context of a failed open is dropped here
+    struct ContextGuard {
+        const Server* server;
+        const void* requestCookie;
+        ~ContextGuard()
+        {
+            if (requestCookie)
+                server->removeRequestContext(requestCookie);
+        }
+    } contextGuard { server, requestCookie };
+
     try {
         log_debug("open({})", filename);
-        auto server = static_cast<const Server*>(cookie);
         if (server->getShutdownStatus())
             return nullptr;
-        auto client = requestCookie ? static_cast<const ClientObservation*>(requestCookie) : nullptr;
-        auto quirks = client ? std::make_shared<Quirks>(client) : nullptr;
-        if (quirks && !quirks->isAllowed()) {
-            auto clientIp = client && client->addr ? client->addr->getHostName() : "unknown";
-            log_debug("Client blocked {}", clientIp);
-            return nullptr;
+        std::shared_ptr<RequestContext> requestContext;
+        if (requestCookie) {
+            requestContext = server->openRequestContext(requestCookie);
+            if (!requestContext) {
+                // read and seek rely on the context
+                log_warning("Request context for {} expired", filename);
+                return nullptr;
+            }
         }
-        auto reqHandler = server->createRequestHandler(filename, quirks);
-        std::string link = URLUtils::urlUnescape(filename);
-        auto ioHandler = reqHandler->open(startswith(link, fmt::format("/{}", CONTENT_UI_HANDLER)) ? filename : link.c_str(), quirks, mode);
+        std::string link = requestContext ? requestContext->link : URLUtils::urlUnescape(filename);
+        bool isUi = requestContext ? requestContext->isUi : startswith(link, fmt::format("/{}", CONTENT_UI_HANDLER));
+        auto quirks = requestContext ? requestContext->quirks : nullptr;
+        std::unique_ptr<RequestHandler> reqHandler;
+        if (requestContext && requestContext->reuseHandler && requestContext->filename == filename)
+            reqHandler = std::move(requestContext->handler);
+        else
+            reqHandler = server->createRequestHandler(filename, quirks);
+        auto ioHandler = reqHandler->open(isUi ? filename : link.c_str(), quirks, mode);
         if (ioHandler) {
             ioHandler->open(mode);
+            if (!isUi && server->clientManager)
+                server->clientManager->addStream(ioHandler.get());
+            contextGuard.requestCookie = nullptr;
             return ioHandler.release();
         }
         log_warning("No Handler for {}", link);
@@ -813,9 +881,10 @@ int Server::ReadCallback(
     log_debug("{} read({})", fileHandle, length);
     if (static_cast<const Server*>(cookie)->getShutdownStatus())
         return GRB_READ_ERROR;
-    auto client = requestCookie ? static_cast<const ClientObservation*>(requestCookie) : nullptr;
-    auto quirks = client ? std::make_shared<Quirks>(client) : nullptr;
-    if (quirks && !quirks->isAllowed()) {
+    // context is valid until close
+    auto requestContext = static_cast<const RequestContext*>(requestCookie);
+    if (requestContext && requestContext->quirks && !requestContext->quirks->isAllowed()) {
+        auto client = requestContext->quirks->getClient();
         auto clientIp = client && client->addr ? client->addr->getHostName() : "unknown";
         log_debug("Client blocked {}", clientIp);
         return GRB_READ_ERROR;
@@ -845,9 +914,9 @@ int Server::SeekCallback(
 {
     log_debug("{} seek({}, {})", fileHandle, offset, whence);
     try {
-        auto client = requestCookie ? static_cast<const ClientObservation*>(requestCookie) : nullptr;
-        auto quirks = client ? std::make_shared<Quirks>(client) : nullptr;
-        if (quirks && !quirks->isAllowed()) {
+        auto requestContext = static_cast<const RequestContext*>(requestCookie);
+        if (requestContext && requestContext->quirks && !requestContext->quirks->isAllowed()) {
+            auto client = requestContext->quirks->getClient();
             auto clientIp = client && client->addr ? client->addr->getHostName() : "unknown";
             log_debug("Client blocked {}", clientIp);
             return -1;
@@ -868,6 +937,11 @@ int Server::CloseCallback(
     const void* requestCookie)
 {
     log_debug("{} close()", fileHandle);
+    auto server = static_cast<const Server*>(cookie);
+    if (server->clientManager)
+        server->clientManager->removeStream(fileHandle);
+    if (requestCookie)
+        server->removeRequestContext(requestCookie);
     int retClose = 0;
     auto ioHandler = std::unique_ptr<IOHandler>(static_cast<IOHandler*>(fileHandle));
     if (ioHandler) {
@@ -35,8 +35,10 @@
 #define __SERVER_H__
 
 #include <memory>
+#include <mutex>
 #include <netinet/in.h>
 #include <string>
+#include <unordered_map>
 #include <upnp.h>
 #include <vector>
 
@@ -52,6 +54,7 @@ class Database;
 class MetadataService;
 class Mime;
 class Quirks;
+class RequestContext;
 class RequestHandler;
 class SubscriptionRequest;
 class Timer;
@@ -73,11 +76,13 @@ public:
     /// @param definition reference to configuration definitions
     /// @param offln start server in offline (without UPnP) mode to import
     /// @param dropDatabase start server to drop database (without any content operation)
+    /// @param checkDatabase start server to check and repair database (without any content operation)
     /// @param initLastFM get Last.FM session key
     void init(
         const std::shared_ptr<ConfigDefinition>& definition,
         bool offln,
         bool dropDatabase,
+        bool checkDatabase,
         bool initLastFM);
 
     /// @brief Cleanup routine to shutdown the server.
@@ -158,6 +163,17 @@ protected:
     std::shared_ptr<UpnpXMLBuilder> webXmlBuilder;
     std::vector<std::unique_ptr<UpnpService>> serviceList;
 
+    /// @brief contexts of running web server requests by request cookie
+    mutable std::unordered_map<const void*, std::shared_ptr<RequestContext>> requestContexts;
+    mutable std::mutex requestMutex;
+
+    /// @brief store context of new request and drop contexts of requests that were never opened
+    void addRequestContext(const std::shared_ptr<RequestContext>& requestContext) const;
+    /// @brief get context of request and mark it as opened
+    std::shared_ptr<RequestContext> openRequestContext(const void* requestCookie) const;
+    /// @brief drop context of finished request
+    void removeRequestContext(const void* requestCookie) const;
+
     /// @brief get active port
     in_port_t getPort() const;
 
@@ -45,10 +45,12 @@
 ClientManager::ClientManager(
     std::shared_ptr<Config> config,
     std::shared_ptr<Database> database,
-    std::shared_ptr<Server> server)
+    std::shared_ptr<Server> server,
+    std::shared_ptr<Timer> timer)
     : database(std::move(database))
     , config(std::move(config))
     , server(std::move(server))
+    , timer(std::move(timer))
     , cacheThreshold(this->config->getLongOption(ConfigVal::CLIENTS_CACHE_THRESHOLD))
 {
     refresh();
@@ -64,9 +66,63 @@ ClientManager::ClientManager(
                 info = &(clientProfile.at(0));
             }
             entry.pInfo = info;
-            cache.push_back(std::move(entry));
+            auto key = entry.addr->getAddressKey();
+            cache.emplace(std::move(key), std::move(entry));
         }
     }
+    if (this->timer)
+        this->timer->addTimerSubscriber(this, CLIENT_FLUSH_INTERVAL, nullptr);
+}
+
+void ClientManager::shutdown()
+{
+    if (timer) {
+        timer->removeTimerSubscriber(this, nullptr, true);
+        timer.reset();
+    }
+    flush();
+}
+
+void ClientManager::timerNotify(const std::shared_ptr<Timer::Parameter>& parameter)
+{
+    flush();
+}
+
+void ClientManager::flush()
+{
+    AutoLock flushLock(flushMutex);
+    std::vector<ClientObservation> clients;
+    {
+        AutoLock lock(mutex);
+        // house cleaning, remove old entries
+        auto now = currentTime();
+        for (auto it = cache.begin(); it != cache.end();) {
+            if (it->second.last + cacheThreshold < now) {
+                it = cache.erase(it);
+                dirty = true;
+            } else {
+                ++it;
+            }
+        }
+        if (!dirty || !database || (server && !server->isRunning()))
+            return;
+        dirty = false;
+        clients.reserve(cache.size());
+        for (auto&& [key, client] : cache)
+            clients.push_back(client);
+    }
+    log_debug("Saving {} clients", clients.size());
+    database->saveClients(clients);
+}
+
+std::vector<ClientObservation> ClientManager::getClientList() const
+{
+    AutoLock lock(mutex);
+    std::vector<ClientObservation> result;
+    result.reserve(cache.size());
+    for (auto&& [key, client] : cache)
+        result.push_back(client);
+    return result;
 }
 
 void ClientManager::refresh()
@@ -390,12 +446,10 @@ const ClientObservation* ClientManager::getInfoByCache(const std::shared_ptr<Grb
 {
     AutoLock lock(mutex);
 
-    auto it = std::find_if(cache.begin(), cache.end(), [=](auto&& entry) //
-        { return entry.addr->equals(addr); });
-
+    auto it = cache.find(addr->getAddressKey());
     if (it != cache.end()) {
-        log_debug("found client by cache (hostname='{}')", it->addr ? it->addr->getHostName() : "");
-        return &(*it);
+        log_debug("found client by cache (hostname='{}')", it->second.addr ? it->second.addr->getHostName() : "");
+        return &(it->second);
     }
 
     return nullptr;
@@ -403,12 +457,36 @@ const ClientObservation* ClientManager::getInfoByCache(const std::shared_ptr<Grb
 
 void ClientManager::removeClient(const std::string& clientIp)
 {
-    AutoLock lock(mutex);
-    cache.erase(std::remove_if(cache.begin(), cache.end(),
-                    [clientIp](auto&& entry) { return entry.addr && entry.addr->equals(clientIp); }),
-        cache.end());
-    if (this->database && (!this->server || this->server->isRunning()))
-        this->database->saveClients(cache);
+    {
+        AutoLock lock(mutex);
+        for (auto it = cache.begin(); it != cache.end();) {
+            if (it->second.addr && it->second.addr->equals(clientIp)) {
+                it = cache.erase(it);
+                dirty = true;
+            } else {
+                ++it;
+            }
+        }
+    }
+    flush();
+}
+
+void ClientManager::addStream(const void* handle)
+{
+    AutoLock lock(streamMutex);
+    streams.insert(handle);
+}
+
+void ClientManager::removeStream(const void* handle)
+{
+    AutoLock lock(streamMutex);
+    streams.erase(handle);
+}
+
+std::size_t ClientManager::getActiveStreams() const
+{
+    AutoLock lock(streamMutex);
+    return streams.size();
 }
 
 const ClientObservation* ClientManager::updateCache(
@@ -419,36 +497,28 @@ const ClientObservation* ClientManager::updateCache(
 {
     AutoLock lock(mutex);
 
-    log_debug("Start {}", this->database && (!this->server || this->server->isRunning()));
-    // house cleaning, remove old entries
     auto now = currentTime();
-    cache.erase(std::remove_if(cache.begin(), cache.end(),
-                    [this, now](auto&& entry) { return entry.last + cacheThreshold < now; }),
-        cache.end());
-
-    auto it = std::find_if(cache.begin(), cache.end(), [=](auto&& entry) //
-        { return entry.addr->equals(addr); });
-
+    auto key = addr->getAddressKey();
+    auto it = cache.find(key);
     if (it != cache.end()) {
-        it->last = now;
-        if (it->pInfo != pInfo) {
+        auto&& client = it->second;
+        client.last = now;
+        if (client.pInfo != pInfo) {
             // client info changed, update all
-            it->age = now;
-            it->userAgent = userAgent;
+            client.age = now;
+            client.userAgent = userAgent;
             if (headers)
-                it->headers = headers;
-            it->pInfo = pInfo;
+                client.headers = headers;
+            client.pInfo = pInfo;
         }
     } else {
         // add new client
-        cache.emplace_back(addr, userAgent, now, now, headers, pInfo);
-        it = std::find_if(cache.begin(), cache.end(), [=](auto&& entry) //
-            { return entry.addr->equals(addr); });
+        it = cache.emplace(std::move(key), ClientObservation(addr, userAgent, now, now, headers, pInfo)).first;
     }
-    if (this->database && (!this->server || this->server->isRunning()))
-        this->database->saveClients(cache);
+    // last seen time is saved by next flush as well
+    dirty = true;
     log_debug("client info: {} '{}' -> '{}' as {} with {}", addr ? addr->getNameInfo() : "", userAgent, pInfo ? pInfo->name : "", ClientConfig::mapClientType(pInfo->type), pInfo ? ClientConfig::mapFlags(pInfo->flags) : "");
-    return &(*it);
+    return &(it->second);
 }
 
 std::unique_ptr<pugi::xml_document> ClientManager::downloadDescription(const std::string& location)
@@ -28,10 +28,14 @@
 #ifndef __UPNP_CLIENT_MANAGER_H__
 #define __UPNP_CLIENT_MANAGER_H__
 
+#include "util/timer.h"
+
 #include <chrono>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 // forward declarations
@@ -48,17 +52,28 @@ namespace pugi {
 class xml_document;
 } // namespace pugi
 
+static constexpr auto CLIENT_FLUSH_INTERVAL = std::chrono::seconds(30);
+
 /// @brief class to manage all known clients and profile information
-class ClientManager {
+///
+/// Client observations are kept in memory and written to the database by the timer
+/// when they have changed.
+class ClientManager : public Timer::Subscriber {
 public:
     explicit ClientManager(
         std::shared_ptr<Config> config,
         std::shared_ptr<Database> database,
-        std::shared_ptr<Server> server);
+        std::shared_ptr<Server> server,
+        std::shared_ptr<Timer> timer);
 
     /// @brief reload predefined profiles and configuration values
     void refresh();
 
+    /// @brief write pending changes and stop timer
+    void shutdown();
+
+    void timerNotify([[maybe_unused]] const std::shared_ptr<Timer::Parameter>& parameter) override;
+
     /// @brief get stored client information for client with addr and userAgent
     /// @return always return something, 'Unknown' if we do not know better
     const ClientObservation* getInfo(
@@ -72,12 +87,19 @@ public:
         const std::string& userAgent,
         const std::string& descLocation);
 
-    /// @brief get current cache content
-    const std::vector<ClientObservation>& getClientList() const { return cache; }
+    /// @brief get copy of current cache content
+    std::vector<ClientObservation> getClientList() const;
 
     /// @brief Remove single client from cache and database
     void removeClient(const std::string& clientIp);
 
+    /// @brief register stream handle opened by the web server
+    void addStream(const void* handle);
+    /// @brief unregister stream handle, handles not registered are ignored
+    void removeStream(const void* handle);
+    /// @brief get number of streams currently served to clients
+    std::size_t getActiveStreams() const;
+
 private:
     const ClientProfile* getInfoByAddr(const std::shared_ptr<GrbNet>& addr) const;
     const ClientProfile* getInfoByType(const std::string& match, ClientMatchType type) const;
@@ -91,14 +113,26 @@ private:
 
     static std::unique_ptr<pugi::xml_document> downloadDescription(const std::string& location);
 
+    /// @brief remove expired clients and save cache to database if it was changed
+    void flush();
+
     mutable std::mutex mutex;
     using AutoLock = std::scoped_lock<std::mutex>;
-    mutable std::vector<ClientObservation> cache;
+    /// @brief client observations by GrbNet::getAddressKey
+    mutable std::unordered_map<std::string, ClientObservation> cache;
+    /// @brief cache was changed since last flush
+    mutable bool dirty {};
+    /// @brief serialize writes of timer and shutdown
+    std::mutex flushMutex;
+    /// @brief handles of open content streams
+    std::unordered_set<const void*> streams;
+    mutable std::mutex streamMutex;
 
     std::vector<ClientProfile> clientProfile;
     std::shared_ptr<Database> database;
     std::shared_ptr<Config> config;
     std::shared_ptr<Server> server;
+    std::shared_ptr<Timer> timer;
     std::chrono::hours cacheThreshold;
 };
 
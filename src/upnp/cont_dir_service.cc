@@ -119,7 +119,7 @@ void ContentDirectoryService::doBrowse(ActionRequest& request)
     else if (browseFlag != "BrowseMetadata")
         throw UpnpException(UPNP_SOAP_E_INVALID_ARGS, "Invalid browse flag: " + browseFlag);
 
-    auto parent = database->loadObject(objectID, quirks->getGroup());
+    auto parent = database->loadCachedObject(objectID, quirks->getGroup());
     auto upnpClass = parent->getClass();
     log_debug("browse {}", upnpClass);
     if (sortCriteria.empty() && (startswith(upnpClass, UPNP_CLASS_MUSIC_ALBUM) || startswith(upnpClass, UPNP_CLASS_PLAYLIST_CONTAINER)))
@@ -0,0 +1,106 @@
+/*GRB*
+    Gerbera - https://gerbera.io/
+
+    file_probe.cc - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file util/file_probe.cc
+/// @brief Implementation of the FileProbe class.
+#define GRB_LOG_FAC GrbLogFacility::util
+
+#include "file_probe.h" // API
+
+#include "util/logger.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <utility>
+
+FileProbe::FileProbe(fs::path path, std::size_t headerSize)
+    : path(std::move(path))
+    , headerSize(headerSize)
+{
+}
+
+FileProbe::~FileProbe()
+{
+    if (fd >= 0)
+        ::close(fd);
+}
+
+bool FileProbe::open()
+{
+    if (opened)
+        return fd >= 0;
+    opened = true;
+
+    fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        log_debug("Could not open {}: {}", path.c_str(), std::strerror(errno));
+        return false;
+    }
+
+    header.resize(headerSize);
+    std::size_t length = 0;
+    while (length < headerSize) {
+        auto count = ::pread(fd, header.data() + length, headerSize - length, static_cast<off_t>(length));
+        if (count < 0 && errno == EINTR)
+            continue;
+        if (count <= 0) {
+            if (count < 0)
+                log_debug("Could not read {}: {}", path.c_str(), std::strerror(errno));
+            break;
+        }
+        length += count;
+    }
+    header.resize(length);
+    bytesRead += length;
+    return true;
+}
+
+const std::vector<char>& FileProbe::getHeader()
+{
+    open();
+    return header;
+}
+
+std::size_t FileProbe::read(off_t offset, void* buffer, std::size_t length)
+{
+    if (!open() || offset < 0)
+        return 0;
+
+    auto start = static_cast<std::size_t>(offset);
+    if (start + length <= header.size() || header.size() < headerSize) {
+        // file is shorter than the header size if header is not full
+        if (start >= header.size())
+            return 0;
+        length = std::min(length, header.size() - start);
+        std::memcpy(buffer, header.data() + start, length);
+        return length;
+    }
+
+    auto count = ::pread(fd, buffer, length, offset);
+    if (count < 0) {
+        log_debug("Could not read {}: {}", path.c_str(), std::strerror(errno));
+        return 0;
+    }
+    bytesRead += count;
+    return count;
+}
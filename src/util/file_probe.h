@@ -0,0 +1,72 @@
+/*GRB*
+    Gerbera - https://gerbera.io/
+
+    file_probe.h - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file util/file_probe.h
+/// @brief Definition of the FileProbe class.
+
+#ifndef __FILE_PROBE_H__
+#define __FILE_PROBE_H__
+
+#include "util/grb_fs.h"
+
+#include <sys/types.h>
+#include <vector>
+
+#define FILE_PROBE_HEADER_SIZE (64 * 1024)
+
+/// @brief Header of a file that is read once for all checks of the file type
+///
+/// The file is opened on first access and stays open until the probe is destroyed,
+/// reads behind the header go to the open file. A probe may be handed over
+/// to another thread but must not be used by two threads at the same time.
+class FileProbe {
+public:
+    explicit FileProbe(fs::path path, std::size_t headerSize = FILE_PROBE_HEADER_SIZE);
+    ~FileProbe();
+
+    FileProbe(const FileProbe&) = delete;
+    FileProbe& operator=(const FileProbe&) = delete;
+
+    const fs::path& getPath() const { return path; }
+
+    /// @brief get start of the file, shorter than the header size for small files
+    /// @return empty buffer if the file can't be read
+    const std::vector<char>& getHeader();
+
+    /// @brief read bytes at offset, served from the header if possible
+    /// @return number of bytes read
+    std::size_t read(off_t offset, void* buffer, std::size_t length);
+
+    /// @brief get number of bytes read from the file
+    std::size_t getBytesRead() const { return bytesRead; }
+
+private:
+    /// @brief open file and read header if not done yet
+    bool open();
+
+    fs::path path;
+    std::size_t headerSize;
+    int fd { -1 };
+    bool opened {};
+    std::vector<char> header;
+    std::size_t bytesRead {};
+};
+
+#endif // __FILE_PROBE_H__
@@ -42,7 +42,8 @@ enum class TaskType {
     AddFile,
     RemoveObject,
     RescanDirectory,
-    FetchOnlineContent
+    FetchOnlineContent,
+    GenerateThumbnails
 };
 
 /// @brief Type of task owners
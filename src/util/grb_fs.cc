@@ -23,6 +23,7 @@ Gerbera - https://gerbera.io/
 #include "grb_fs.h" // API
 
 #include "exceptions.h"
+#include "util/file_probe.h"
 #include "util/logger.h"
 #include "util/tools.h"
 
@@ -113,6 +114,14 @@ std::uintmax_t getFileSize(const fs::directory_entry& dirEnt)
 #endif
 }
 
+FileId getFileId(const fs::path& path) noexcept
+{
+    struct stat statbuf;
+    if (stat(path.c_str(), &statbuf) != 0)
+        return {};
+    return { static_cast<std::uint64_t>(statbuf.st_dev), static_cast<std::uint64_t>(statbuf.st_ino) };
+}
+
 bool GrbFile::isExecutable(int& err) const
 {
     int ret = access(path.c_str(), R_OK | X_OK);
@@ -290,24 +299,23 @@ bool GrbFile::isReadable(bool warn) const
 
 bool isTheora(const fs::path& oggFilename)
 {
-    char buffer[7];
-    GrbFile file(oggFilename);
-    auto f = file.open("rb");
+    FileProbe probe(oggFilename, 28 + 7);
+    return isTheora(probe);
+}
 
-    if (std::fread(buffer, 1, 4, f) != 4) {
-        throw_std_runtime_error("Error reading {}", oggFilename.c_str());
+bool isTheora(FileProbe& probe)
+{
+    char buffer[7];
+    if (probe.read(0, buffer, 4) != 4) {
+        throw_std_runtime_error("Error reading {}", probe.getPath().c_str());
     }
 
     if (std::memcmp(buffer, "OggS", 4) != 0) {
         return false;
     }
 
-    if (fseeko(f, 28, SEEK_SET) != 0) {
-        throw_std_runtime_error("Incomplete file {}", oggFilename.c_str());
-    }
-
-    if (std::fread(buffer, 1, 7, f) != 7) {
-        throw_std_runtime_error("Error reading {}", oggFilename.c_str());
+    if (probe.read(28, buffer, 7) != 7) {
+        throw_std_runtime_error("Incomplete file {}", probe.getPath().c_str());
     }
 
     return std::memcmp(buffer, "\x80theora", 7) == 0;
@@ -319,17 +327,20 @@ fs::path getLastPath(const fs::path& path)
 }
 
 #ifndef HAVE_FFMPEG
+#define FCC_OFFSET 0xbc
 std::string getAVIFourCC(const fs::path& aviFilename)
 {
-#define FCC_OFFSET 0xbc
-    GrbFile file(aviFilename);
-    auto f = file.open("rb");
+    FileProbe probe(aviFilename, FCC_OFFSET + 4);
+    return getAVIFourCC(probe);
+}
 
+std::string getAVIFourCC(FileProbe& probe)
+{
     char buffer[FCC_OFFSET + 6];
 
-    std::size_t rb = std::fread(buffer, 1, FCC_OFFSET + 4, f);
+    std::size_t rb = probe.read(0, buffer, FCC_OFFSET + 4);
     if (rb != FCC_OFFSET + 4) {
-        throw_std_runtime_error("Could not read header of {}", aviFilename.c_str());
+        throw_std_runtime_error("Could not read header of {}", probe.getPath().c_str());
     }
 
     buffer[FCC_OFFSET + 5] = '\0';
@@ -24,12 +24,15 @@ Gerbera - https://gerbera.io/
 #ifndef __GRB_FS_H__
 #define __GRB_FS_H__
 
+#include <cstdint>
 #include <filesystem>
 #include <optional>
 #include <vector>
 
 namespace fs = std::filesystem;
 
+class FileProbe;
+
 /// @brief Encapsulation of file on disk
 class GrbFile {
 private:
@@ -92,8 +95,22 @@ bool isRegularFile(const fs::directory_entry& dirEnt, std::error_code& ec) noexc
 /// @brief Returns file size of give file, if it does not exist it will throw an exception
 std::uintmax_t getFileSize(const fs::directory_entry& dirEnt);
 
+/// @brief Identity of a file system entry that is kept when the entry is renamed or moved on the same device
+struct FileId {
+    std::uint64_t device {};
+    std::uint64_t inode {};
+
+    bool isValid() const { return inode != 0; }
+    bool operator==(const FileId& other) const { return device == other.device && inode == other.inode; }
+    bool operator!=(const FileId& other) const { return !(*this == other); }
+};
+
+/// @brief Returns device and inode of the given path, invalid id if it does not exist
+FileId getFileId(const fs::path& path) noexcept;
+
 /// @brief Determines if the particular ogg file contains a video (theora)
 bool isTheora(const fs::path& oggFilename);
+bool isTheora(FileProbe& probe);
 
 #ifndef HAVE_FFMPEG
 /// @brief Fallback code to retrieve the used fourcc from an AVI file.
@@ -101,6 +118,7 @@ bool isTheora(const fs::path& oggFilename);
 /// This code is based on offsets, so we will use it only if ffmpeg is not
 /// available.
 std::string getAVIFourCC(const fs::path& aviFilename);
+std::string getAVIFourCC(FileProbe& probe);
 #endif
 
 /// @brief Gets an absolute filename as a parameter and returns the last parent
@@ -172,6 +172,17 @@ bool GrbNet::equals(const std::shared_ptr<GrbNet>& other) const
     return sockAddrCmpAddr(SOCK_ADDR_PTR(&other->sockAddr), SOCK_ADDR_PTR(&sockAddr)) == 0;
 }
 
+std::string GrbNet::getAddressKey() const
+{
+    auto addr = SOCK_ADDR_PTR(&sockAddr);
+    std::string key(1, static_cast<char>(addr->sa_family));
+    if (addr->sa_family == AF_INET6)
+        key.append(reinterpret_cast<const char*>(&SOCK_ADDR_IN6_PTR(addr)->sin6_addr), sizeof(struct in6_addr));
+    else if (addr->sa_family == AF_INET)
+        key.append(reinterpret_cast<const char*>(&SOCK_ADDR_IN_PTR(addr)->sin_addr), sizeof(struct in_addr));
+    return key;
+}
+
 std::string GrbNet::getHostName()
 {
     if (!hostName.empty())
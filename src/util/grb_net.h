@@ -45,6 +45,8 @@ public:
     void setHostName(const std::string& hn) { hostName = hn; };
     bool equals(const std::string& match) const;
     bool equals(const std::shared_ptr<GrbNet>& other) const;
+    /// @brief Binary key of address family and address, equal for all addresses matched by equals(other)
+    std::string getAddressKey() const;
     std::string getNameInfo(bool withPort = true) const;
 
     /// @brief Finds the Interface with the specified IP address.
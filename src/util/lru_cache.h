@@ -0,0 +1,188 @@
+/*GRB*
+    Gerbera - https://gerbera.io/
+
+    lru_cache.h - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file util/lru_cache.h
+/// @brief Definition of the LruCache template class.
+
+#ifndef __LRU_CACHE_H__
+#define __LRU_CACHE_H__
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <map>
+#include <utility>
+
+/// @brief Ordered map that evicts least recently used entries when the total weight exceeds its capacity
+///
+/// The cache is not synchronized, owners lock it together with their own data.
+/// Every invalidation starts a new generation, so values that were loaded while
+/// their source changed can be rejected when they are put.
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class LruCache {
+public:
+    using Entry = std::pair<Key, Value>;
+    /// @brief weight of a value counted against the capacity, each entry weighs 1 without it
+    using Weigher = std::function<std::size_t(const Value&)>;
+    /// @brief called for each entry removed by eviction or erase, not for clear
+    using RemoveHandler = std::function<void(const Key&, const Value&)>;
+
+    explicit LruCache(std::size_t capacity, Weigher weigh = {}, RemoveHandler onRemove = {})
+        : capacity(capacity)
+        , weigh(std::move(weigh))
+        , onRemove(std::move(onRemove))
+    {
+    }
+
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+
+    /// @brief find value and mark it as recently used
+    /// @return value or nullptr
+    Value* get(const Key& key)
+    {
+        auto entry = index.find(key);
+        if (entry == index.end())
+            return nullptr;
+
+        entries.splice(entries.begin(), entries, entry->second);
+        return &entry->second->second;
+    }
+
+    /// @brief find value without changing the order of eviction
+    /// @return value or nullptr
+    Value* peek(const Key& key)
+    {
+        auto entry = index.find(key);
+        return entry != index.end() ? &entry->second->second : nullptr;
+    }
+
+    /// @brief find entry with the greatest key not after key without changing the order of eviction
+    /// @return entry or nullptr
+    const Entry* floor(const Key& key) const
+    {
+        auto entry = index.upper_bound(key);
+        if (entry == index.begin())
+            return nullptr;
+        return &*std::prev(entry)->second;
+    }
+
+    /// @brief add or replace value and evict least recently used entries to stay within capacity
+    /// @return false if the value is heavier than the capacity
+    bool put(const Key& key, Value value)
+    {
+        auto weight = weightOf(value);
+        if (weight > capacity) {
+            erase(key);
+            return false;
+        }
+
+        auto entry = index.find(key);
+        if (entry != index.end()) {
+            totalWeight -= weightOf(entry->second->second);
+            entry->second->second = std::move(value);
+            entries.splice(entries.begin(), entries, entry->second);
+        } else {
+            entries.emplace_front(key, std::move(value));
+            index.emplace(key, entries.begin());
+        }
+        totalWeight += weight;
+
+        // new entry is at the front and fits
+        while (totalWeight > capacity)
+            removeEntry(index.find(entries.back().first));
+        return true;
+    }
+
+    /// @brief add or replace value unless the cache was invalidated since generation was retrieved
+    /// @return false if the value is stale or heavier than the capacity
+    bool put(const Key& key, Value value, std::size_t generation)
+    {
+        if (generation != this->generation)
+            return false;
+        return put(key, std::move(value));
+    }
+
+    /// @brief remove entry of key
+    /// @return true if there was an entry
+    bool erase(const Key& key)
+    {
+        auto entry = index.find(key);
+        if (entry == index.end())
+            return false;
+
+        removeEntry(entry);
+        return true;
+    }
+
+    /// @brief remove consecutive entries in key order, starting at the first key not before first, while matches returns true
+    /// @return number of removed entries
+    template <typename Predicate>
+    std::size_t eraseWhile(const Key& first, Predicate matches)
+    {
+        std::size_t count = 0;
+        for (auto entry = index.lower_bound(first); entry != index.end() && matches(entry->first); count++)
+            entry = removeEntry(entry);
+        return count;
+    }
+
+    /// @brief get generation, has to be retrieved before loading a value
+    std::size_t getGeneration() const { return generation; }
+    /// @brief start a new generation so values loaded before are rejected
+    void invalidate() { generation++; }
+    /// @brief remove all entries and start a new generation
+    void clear()
+    {
+        generation++;
+        entries.clear();
+        index.clear();
+        totalWeight = 0;
+    }
+
+    std::size_t getSize() const { return entries.size(); }
+    std::size_t getTotalWeight() const { return totalWeight; }
+
+private:
+    using EntryList = std::list<Entry>;
+    using Index = std::map<Key, typename EntryList::iterator, Compare>;
+
+    std::size_t weightOf(const Value& value) const { return weigh ? weigh(value) : 1; }
+
+    typename Index::iterator removeEntry(typename Index::iterator entry)
+    {
+        if (onRemove)
+            onRemove(entry->second->first, entry->second->second);
+        totalWeight -= weightOf(entry->second->second);
+        entries.erase(entry->second);
+        return index.erase(entry);
+    }
+
+    std::size_t capacity;
+    Weigher weigh;
+    RemoveHandler onRemove;
+    std::size_t totalWeight {};
+    std::size_t generation {};
+    /// @brief least recently used entry is at the end
+    EntryList entries;
+    Index index;
+};
+
+#endif // __LRU_CACHE_H__
@@ -28,9 +28,13 @@
 #include "config/config.h"
 #include "config/config_val.h"
 #include "exceptions.h"
+#include "util/file_probe.h"
 #include "util/logger.h"
 #include "util/tools.h"
 
+#include <algorithm>
+#include <thread>
+
 Mime::Mime(const std::shared_ptr<Config>& config)
     : extension_map_case_sensitive(config->getBoolOption(ConfigVal::IMPORT_MAPPINGS_EXTENSION_TO_MIMETYPE_CASE_SENSITIVE))
     , ignore_unknown_extensions(config->getBoolOption(ConfigVal::IMPORT_MAPPINGS_IGNORE_UNKNOWN_EXTENSIONS))
@@ -45,40 +49,85 @@ Mime::Mime(const std::shared_ptr<Config>& config)
 
 #ifdef HAVE_MAGIC
     // init filemagic
-    int magicFlags = config->getBoolOption(ConfigVal::IMPORT_FOLLOW_SYMLINKS) ? MAGIC_MIME_TYPE | MAGIC_SYMLINK : MAGIC_MIME_TYPE;
-    magicCookie = magic_open(magicFlags);
-    if (!magicCookie) {
+    magicFlags = config->getBoolOption(ConfigVal::IMPORT_FOLLOW_SYMLINKS) ? MAGIC_MIME_TYPE | MAGIC_SYMLINK : MAGIC_MIME_TYPE;
+    magicFile = config->getOption(ConfigVal::IMPORT_MAGIC_FILE);
+    log_debug("magic '{}'", magicFile);
+    auto hwThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    auto scanThreads = config->getUIntOption(ConfigVal::IMPORT_SCAN_THREADS);
+    auto metadataThreads = config->getUIntOption(ConfigVal::IMPORT_METADATA_THREADS);
+    maxCookies = std::max<std::size_t>(scanThreads > 0 ? scanThreads : hwThreads, metadataThreads > 0 ? metadataThreads : hwThreads);
+    // load first cookie immediately to report broken magic file on startup
+    idleCookies.push_back(openCookie());
+    cookieCount = 1;
+#endif // HAVE_MAGIC
+}
+
+#ifdef HAVE_MAGIC
+Mime::~Mime()
+{
+    for (auto&& cookie : idleCookies)
+        magic_close(cookie);
+    log_debug("Mime closed {} magic cookies", idleCookies.size());
+    idleCookies.clear();
+}
+
+magic_t Mime::openCookie() const
+{
+    magic_t cookie = magic_open(magicFlags);
+    if (!cookie) {
         throw_std_runtime_error("magic_open failed");
     }
 
-    std::string optMagicFile = config->getOption(ConfigVal::IMPORT_MAGIC_FILE);
-    log_debug("magic '{}'", optMagicFile);
-    const char* magicFile = !optMagicFile.empty() ? optMagicFile.c_str() : nullptr;
-    if (magic_load(magicCookie, magicFile) == -1) {
-        auto errMsg = magic_error(magicCookie);
-        magic_close(magicCookie);
-        magicCookie = nullptr;
+    if (magic_load(cookie, !magicFile.empty() ? magicFile.c_str() : nullptr) == -1) {
+        std::string errMsg = magic_error(cookie);
+        magic_close(cookie);
         throw_std_runtime_error("magic_load failed: {}", errMsg);
     }
-#endif // HAVE_MAGIC
+    return cookie;
 }
 
-#ifdef HAVE_MAGIC
-Mime::~Mime()
+magic_t Mime::acquireCookie()
 {
-    if (magicCookie) {
-        magic_close(magicCookie);
-        magicCookie = nullptr;
+    {
+        auto lock = std::unique_lock(cookieMutex);
+        cookieReleased.wait(lock, [this] { return !idleCookies.empty() || cookieCount < maxCookies; });
+        if (!idleCookies.empty()) {
+            auto cookie = idleCookies.back();
+            idleCookies.pop_back();
+            return cookie;
+        }
+        cookieCount++;
+    }
+    // loading the database takes a while, do not block other threads
+    log_debug("Loading additional magic cookie");
+    try {
+        return openCookie();
+    } catch (const std::runtime_error&) {
+        {
+            auto lock = std::scoped_lock(cookieMutex);
+            cookieCount--;
+        }
+        cookieReleased.notify_one();
+        throw;
     }
 }
-#endif
 
-#ifdef HAVE_MAGIC
+void Mime::releaseCookie(magic_t cookie)
+{
+    {
+        auto lock = std::scoped_lock(cookieMutex);
+        idleCookies.push_back(cookie);
+    }
+    cookieReleased.notify_one();
+}
+
 std::string Mime::fileToMimeType(const fs::path& path, const std::string& defval)
 {
-    auto lock = std::scoped_lock(mime_mutex);
-    const char* mimeType = magic_file(magicCookie, path.c_str());
-    if (!mimeType || mimeType[0] == '\0') {
+    auto cookie = acquireCookie();
+    const char* magicMime = magic_file(cookie, path.c_str());
+    std::string mimeType = magicMime ? magicMime : "";
+    releaseCookie(cookie);
+    if (mimeType.empty()) {
         return defval;
     }
 
@@ -87,11 +136,25 @@ std::string Mime::fileToMimeType(const fs::path& path, const std::string& defval
 
 std::string Mime::bufferToMimeType(const void* buffer, std::size_t length)
 {
-    return magic_buffer(magicCookie, buffer, length);
+    auto cookie = acquireCookie();
+    const char* magicMime = magic_buffer(cookie, buffer, length);
+    std::string mimeType = magicMime ? magicMime : "";
+    releaseCookie(cookie);
+    return mimeType;
 }
 #endif
 
-std::pair<bool, std::string> Mime::getMimeType(const fs::path& path, const std::string& defval)
+std::pair<bool, std::string> Mime::getMimeType(const fs::path& path, const std::string& defval, MimeLookups* lookups)
+{
+    return getMimeType(path, defval, nullptr, lookups);
+}
+
+std::pair<bool, std::string> Mime::getMimeType(FileProbe& probe, const std::string& defval, MimeLookups* lookups)
+{
+    return getMimeType(probe.getPath(), defval, &probe, lookups);
+}
+
+std::pair<bool, std::string> Mime::getMimeType(const fs::path& path, const std::string& defval, FileProbe* probe, MimeLookups* lookups)
 {
     auto extension = path.extension().string();
     if (!extension.empty() && extension.at(0) == '.')
@@ -106,9 +169,21 @@ std::pair<bool, std::string> Mime::getMimeType(const fs::path& path, const std::
         return { true, "" };
     }
     std::string mimeType = getValueOrDefault(extension_mimetype_map, extension, "");
-    if (mimeType.empty() && !ignore_unknown_extensions) {
+    if (!mimeType.empty()) {
+        if (lookups)
+            lookups->extension++;
+    } else if (!ignore_unknown_extensions) {
 #ifdef HAVE_MAGIC
-        auto fileMime = fileToMimeType(path, defval);
+        if (lookups)
+            lookups->magic++;
+        std::string fileMime;
+        if (probe && !probe->getHeader().empty()) {
+            fileMime = bufferToMimeType(probe->getHeader().data(), probe->getHeader().size());
+            if (fileMime.empty())
+                fileMime = defval;
+        } else {
+            fileMime = fileToMimeType(path, defval);
+        }
         mimeType = fileMime.empty() ? extension : fileMime;
 #else
         mimeType = defval.empty() ? extension : defval;
@@ -26,12 +26,15 @@
 #ifndef __MIME_H__
 #define __MIME_H__
 
+#include <atomic>
 #include <map>
 
 #include "util/grb_fs.h"
 
 #ifdef HAVE_MAGIC
+#include <condition_variable>
 #include <mutex>
+#include <vector>
 // for older versions of filemagic
 extern "C" {
 #include <magic.h>
@@ -40,6 +43,15 @@ extern "C" {
 
 // forward declaration
 class Config;
+class FileProbe;
+
+/// @brief counters of mimetype detection, e.g. of one scan
+struct MimeLookups {
+    /// @brief number of files with mimetype from extension mapping
+    std::atomic_size_t extension {};
+    /// @brief number of files that were checked with filemagic
+    std::atomic_size_t magic {};
+};
 
 class Mime {
 public:
@@ -52,12 +64,16 @@ public:
 
     /// @brief Extracts mimetype from a buffer using filemagic
     std::string bufferToMimeType(const void* buffer, std::size_t length);
-    std::mutex mime_mutex;
 #endif // HAVE_MAGIC
 
-    std::pair<bool, std::string> getMimeType(const fs::path& path, const std::string& defval = "");
+    /// @param lookups counters to add the detection method to
+    std::pair<bool, std::string> getMimeType(const fs::path& path, const std::string& defval = "", MimeLookups* lookups = nullptr);
+    /// @brief Get mimetype of probed file, filemagic uses the header of the probe
+    std::pair<bool, std::string> getMimeType(FileProbe& probe, const std::string& defval = "", MimeLookups* lookups = nullptr);
 
 private:
+    std::pair<bool, std::string> getMimeType(const fs::path& path, const std::string& defval, FileProbe* probe, MimeLookups* lookups);
+
     bool extension_map_case_sensitive;
     bool ignore_unknown_extensions;
 
@@ -65,7 +81,23 @@ private:
     std::vector<std::string> ignoredExtensions;
 
 #ifdef HAVE_MAGIC
-    magic_t magicCookie;
+    int magicFlags;
+    std::string magicFile;
+
+    /// @brief loaded cookies that are not in use, a cookie must not be used by two threads at the same time
+    std::vector<magic_t> idleCookies;
+    /// @brief number of loaded cookies, idle or in use
+    std::size_t cookieCount {};
+    /// @brief maximum number of loaded cookies, one for each import worker
+    std::size_t maxCookies { 1 };
+    std::mutex cookieMutex;
+    std::condition_variable cookieReleased;
+
+    /// @brief open and load a new cookie
+    magic_t openCookie() const;
+    /// @brief get idle cookie, load an additional one if all are in use or wait for one if the limit is reached
+    magic_t acquireCookie();
+    void releaseCookie(magic_t cookie);
 
     /// @brief Extracts mimetype from a file using filemagic
     std::string fileToMimeType(const fs::path& path, const std::string& defval = "");
@@ -44,6 +44,7 @@
 #include <queue>
 #include <regex>
 #include <sstream>
+#include <sys/resource.h>
 
 #ifdef __HAIKU__
 #define _DEFAULT_SOURCE
@@ -482,6 +483,18 @@ std::string limitString(std::size_t stringLimit, const std::string& s)
     return fmt::format("{}{}", s.substr(0, cutPosition), ellipse);
 }
 
+std::size_t getPeakMemoryUsage()
+{
+    struct rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss; // bytes
+#else
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024; // kilobytes
+#endif
+}
+
 std::string transliterate(const std::string& input)
 {
 #ifdef HAVE_ICU
@@ -214,6 +214,10 @@ ssize_t getValidUTF8CutPosition(std::string_view str, ssize_t cutpos);
 /// @brief reduce size of string at length
 std::string limitString(std::size_t stringLimit, const std::string& s);
 
+/// @brief get highest memory usage of the process
+/// @return resident set size in bytes
+std::size_t getPeakMemoryUsage();
+
 /// @brief transliterate a string to ascii for display on restricted devices
 /// @return transliterated string
 std::string transliterate(const std::string& input);
@@ -0,0 +1,77 @@
+/*GRB*
+    Gerbera - https://gerbera.io/
+
+    worker_pool.cc - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file util/worker_pool.cc
+/// @brief Implementation of the WorkerPool class.
+#define GRB_LOG_FAC GrbLogFacility::thread
+
+#include "worker_pool.h" // API
+
+#include "util/logger.h"
+
+WorkerPool::WorkerPool(std::string name, std::size_t size)
+    : name(std::move(name))
+{
+    workers.reserve(size);
+    for (std::size_t worker = 0; worker < size; worker++)
+        workers.emplace_back([this, worker] { threadProc(worker); });
+    log_debug("Started {} workers for {}", size, this->name);
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        AutoLock lock(mutex);
+        shutdown = true;
+    }
+    cond.notify_all();
+    for (auto&& worker : workers)
+        worker.join();
+    log_debug("Stopped workers for {}", name);
+}
+
+std::future<void> WorkerPool::submit(Job job)
+{
+    std::packaged_task<void(std::size_t)> task(std::move(job));
+    auto result = task.get_future();
+    {
+        AutoLock lock(mutex);
+        jobs.push_back(std::move(task));
+    }
+    cond.notify_one();
+    return result;
+}
+
+void WorkerPool::threadProc(std::size_t worker)
+{
+    while (true) {
+        std::packaged_task<void(std::size_t)> task;
+        {
+            AutoLockU lock(mutex);
+            cond.wait(lock, [this] { return shutdown || !jobs.empty(); });
+            // queued jobs are finished before stopping so no future is left waiting
+            if (jobs.empty())
+                return;
+            task = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        task(worker);
+    }
+}
@@ -0,0 +1,69 @@
+/*GRB*
+    Gerbera - https://gerbera.io/
+
+    worker_pool.h - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file util/worker_pool.h
+/// @brief Definition of the WorkerPool class.
+
+#ifndef __WORKER_POOL_H__
+#define __WORKER_POOL_H__
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @brief Fixed number of threads running submitted jobs in submission order
+///
+/// Each job receives the index of the worker running it, so callers can keep
+/// per thread instances of objects that must not be shared between threads.
+class WorkerPool {
+public:
+    using Job = std::function<void(std::size_t worker)>;
+
+    WorkerPool(std::string name, std::size_t size);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /// @brief queue job for the next idle worker
+    /// @return future to wait for the job, exceptions of the job are rethrown by get()
+    std::future<void> submit(Job job);
+    std::size_t getSize() const { return workers.size(); }
+
+private:
+    void threadProc(std::size_t worker);
+
+    std::string name;
+    std::vector<std::thread> workers;
+    std::deque<std::packaged_task<void(std::size_t)>> jobs;
+    bool shutdown {};
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    using AutoLock = std::scoped_lock<std::mutex>;
+    using AutoLockU = std::unique_lock<std::mutex>;
+};
+
+#endif // __WORKER_POOL_H__
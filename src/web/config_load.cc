@@ -240,6 +240,10 @@ void Web::ConfigLoad::writeDatabaseStatus(Json::Value& values)
         addValue(values, "/status/attribute::imageVirtual", ConfigVal::MAX, ConfigVal::MAX, database->getFileStats(stats));
     }
 
+    for (auto&& [key, value] : database->getObjectCacheStats()) {
+        addValue(values, fmt::format("/status/attribute::{}", key), ConfigVal::MAX, ConfigVal::MAX, value);
+    }
+
     StatsParam statc(StatsParam::StatsMode::Count, "", "", false);
     auto cnt = database->getGroupStats(statc);
     StatsParam stats(StatsParam::StatsMode::Size, "", "", false);
@@ -285,10 +285,21 @@ enum class TestCol {
 
 std::string OTN = MetaEnumMapper::getMetaFieldName(MetadataFields::M_TRACKNUMBER);
 
+class TestSearchIndex : public SearchIndex {
+public:
+    std::string emitMatch(const std::string& idColumn, const std::string& property, const std::string& value, const std::string& pattern) const override
+    {
+        if (value.empty())
+            return {};
+        return fmt::format("({} IN index('{}', '{}'))", idColumn, property, pattern);
+    }
+};
+
 class ParserTest : public ::testing::Test {
 public:
     std::string otn;
     std::shared_ptr<Database> database;
+    std::shared_ptr<SearchIndex> searchIndex;
     std::vector<std::pair<std::string, TestCol>> testSortMap;
     std::map<TestCol, SearchProperty> testColMap;
     std::shared_ptr<EnumColumnMapper<TestCol>> columnMapper;
@@ -336,7 +347,7 @@ public:
         const std::string& expectedOutput, const std::string& expectedRe = "")
     {
         try {
-            DefaultSQLEmitter emitter(database, columnMapper, columnMapper, columnMapper, columnMapper);
+            DefaultSQLEmitter emitter(database, columnMapper, columnMapper, columnMapper, columnMapper, searchIndex);
             columnMapper->resetCnt();
             auto parser = SearchParser(emitter, input);
             auto rootNode = parser.parse();
@@ -477,6 +488,25 @@ TEST_F(ParserTest, SearchCriteriaUsingStartsWithOperator)
         "(_meta_query1_._property_name_='upnp:album' AND LOWER(_meta_query1_._property_value_) LIKE LOWER('Midnight%')) OR (_meta_query0_._property_name_='upnp:artist' AND LOWER(_meta_query0_._property_value_) LIKE LOWER('HEAVE%'))"));
 }
 
+TEST_F(ParserTest, SearchCriteriaUsingSearchIndex)
+{
+    searchIndex = std::make_shared<TestSearchIndex>();
+
+    EXPECT_TRUE(executeSearchParserTest("upnp:album contains \"Midnight\"",
+        "(_t_._item_id_ IN index('upnp:album', '%Midnight%'))"));
+
+    EXPECT_TRUE(executeSearchParserTest("upnp:album startswith \"Midnight\" or upnp:artist contains \"HEAVE\"",
+        "(_t_._item_id_ IN index('upnp:album', 'Midnight%')) OR (_t_._item_id_ IN index('upnp:artist', '%HEAVE%'))"));
+
+    // not supported by index
+    EXPECT_TRUE(executeSearchParserTest("upnp:album doesnotcontain \"Midnight\"",
+        "(_meta_query0_._property_name_='upnp:album' AND LOWER(_meta_query0_._property_value_) NOT LIKE LOWER('%Midnight%'))"));
+
+    // rejected by index
+    EXPECT_TRUE(executeSearchParserTest("upnp:album contains \"\"",
+        "(_meta_query0_._property_name_='upnp:album' AND LOWER(_meta_query0_._property_value_) LIKE LOWER('%%'))"));
+}
+
 TEST_F(ParserTest, SearchCriteriaUsingExistsOperator)
 {
     // (containsOpExpr)
@@ -0,0 +1,122 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    test_thumbnail_cache.cc - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+#include "metadata/thumbnail_cache.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+class ThumbnailCacheTest : public ::testing::Test {
+
+public:
+    ThumbnailCacheTest() = default;
+    ~ThumbnailCacheTest() override = default;
+
+    static ThumbnailCache::Generator generator(std::size_t size, std::atomic_int& calls)
+    {
+        return [size, &calls]() -> std::optional<std::vector<std::byte>> {
+            calls++;
+            return std::vector<std::byte>(size, std::byte { 1 });
+        };
+    }
+};
+
+TEST_F(ThumbnailCacheTest, GeneratesEachThumbnailOnce)
+{
+    ThumbnailCache cache(1024);
+    std::atomic_int calls = 0;
+    std::atomic_bool release = false;
+    auto slow = [&]() -> std::optional<std::vector<std::byte>> {
+        calls++;
+        while (!release)
+            std::this_thread::yield();
+        return std::vector<std::byte>(10);
+    };
+
+    std::vector<std::thread> threads;
+    std::vector<ThumbnailCache::Data> results(4);
+    for (std::size_t i = 0; i < results.size(); i++)
+        threads.emplace_back([&, i] { results[i] = cache.get("video", slow); });
+    while (cache.getHits() + cache.getMisses() < results.size())
+        std::this_thread::yield();
+    release = true;
+    for (auto&& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(cache.getMisses(), 1);
+    for (auto&& result : results) {
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(result, results[0]);
+    }
+}
+
+TEST_F(ThumbnailCacheTest, DoesNotCacheFailures)
+{
+    ThumbnailCache cache(1024);
+    int calls = 0;
+    auto failing = [&calls]() -> std::optional<std::vector<std::byte>> {
+        calls++;
+        return std::nullopt;
+    };
+    EXPECT_EQ(cache.get("video", failing), nullptr);
+    EXPECT_EQ(cache.get("video", failing), nullptr);
+    EXPECT_EQ(calls, 2);
+
+    auto throwing = []() -> std::optional<std::vector<std::byte>> { throw std::logic_error("broken"); };
+    EXPECT_THROW(cache.get("broken", throwing), std::logic_error);
+    std::atomic_int generated = 0;
+    EXPECT_NE(cache.get("broken", generator(10, generated)), nullptr);
+    EXPECT_EQ(generated, 1);
+}
+
+TEST_F(ThumbnailCacheTest, SharesGenerationWithoutKeeping)
+{
+    ThumbnailCache cache(1024);
+    std::atomic_int calls = 0;
+    std::atomic_bool release = false;
+    auto slow = [&]() -> std::optional<std::vector<std::byte>> {
+        calls++;
+        while (!release)
+            std::this_thread::yield();
+        return std::vector<std::byte>(10);
+    };
+
+    // background generation is not kept, a request at the same time waits for it
+    ThumbnailCache::Data background;
+    std::thread thread([&] { background = cache.get("video", slow, false); });
+    while (cache.getMisses() < 1)
+        std::this_thread::yield();
+    ThumbnailCache::Data request;
+    std::thread requestThread([&] { request = cache.get("video", generator(10, calls)); });
+    while (cache.getHits() < 1)
+        std::this_thread::yield();
+    release = true;
+    thread.join();
+    requestThread.join();
+
+    EXPECT_EQ(calls, 1);
+    ASSERT_NE(request, nullptr);
+    EXPECT_EQ(request, background);
+    EXPECT_EQ(cache.getBytes(), 0);
+}
@@ -0,0 +1,68 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    test_keyset_cursor.cc - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file test_keyset_cursor.cc
+#include "database/keyset_cursor.h"
+
+#include <gtest/gtest.h>
+
+TEST(KeysetCursorTest, FindClosestCursor)
+{
+    KeysetCursorCache cache(16);
+    cache.store("query", { 20, { std::string("b"), 7LL } }, cache.getGeneration());
+    cache.store("query", { 40, { std::string("d"), 3LL } }, cache.getGeneration());
+    cache.store("other", { 30, { std::nullopt, 5LL } }, cache.getGeneration());
+
+    EXPECT_FALSE(cache.find("query", 10));
+    EXPECT_FALSE(cache.find("unknown", 40));
+
+    auto cursor = cache.find("query", 20);
+    ASSERT_TRUE(cursor);
+    EXPECT_EQ(cursor->index, 20);
+    EXPECT_EQ(std::get<std::string>(*cursor->values.at(0)), "b");
+
+    cursor = cache.find("query", 39);
+    ASSERT_TRUE(cursor);
+    EXPECT_EQ(cursor->index, 20);
+
+    cursor = cache.find("query", 100);
+    ASSERT_TRUE(cursor);
+    EXPECT_EQ(cursor->index, 40);
+
+    cursor = cache.find("other", 30);
+    ASSERT_TRUE(cursor);
+    EXPECT_FALSE(cursor->values.at(0));
+}
+
+TEST(KeysetCursorTest, ClearDropsStaleCursors)
+{
+    KeysetCursorCache cache(16);
+    auto generation = cache.getGeneration();
+    cache.store("query", { 20, { 1LL } }, generation);
+    cache.clear();
+    EXPECT_FALSE(cache.find("query", 20));
+
+    // page was read before the content changed
+    cache.store("query", { 20, { 1LL } }, generation);
+    EXPECT_FALSE(cache.find("query", 20));
+}
@@ -0,0 +1,105 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    test_object_cache.cc - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file test_object_cache.cc
+#include "cds/cds_item.h"
+#include "database/object_cache.h"
+#include "upnp/clients.h"
+
+#include <gtest/gtest.h>
+
+static std::shared_ptr<CdsObject> createItem(int id, int refId = INVALID_OBJECT_ID)
+{
+    auto item = std::make_shared<CdsItem>(CdsEntryType::File);
+    item->setID(id);
+    item->setRefID(refId);
+    return item;
+}
+
+TEST(ObjectCacheTest, GetPutByGroup)
+{
+    CdsObjectCache cache(64);
+    auto item = createItem(42);
+
+    EXPECT_EQ(cache.get(42, "default"), nullptr);
+    cache.put(item, "default", cache.getGeneration(42));
+    EXPECT_EQ(cache.get(42, "default"), item);
+    EXPECT_EQ(cache.get(42, "other"), nullptr);
+
+    EXPECT_EQ(cache.getHits(), 1);
+    EXPECT_EQ(cache.getMisses(), 2);
+    EXPECT_EQ(cache.getSize(), 1);
+}
+
+TEST(ObjectCacheTest, InvalidateDropsAllGroupsAndReferences)
+{
+    CdsObjectCache cache(64);
+    cache.put(createItem(42), "default", cache.getGeneration(42));
+    cache.put(createItem(42), "other", cache.getGeneration(42));
+    cache.put(createItem(43, 42), "default", cache.getGeneration(43));
+    cache.put(createItem(44), "default", cache.getGeneration(44));
+    EXPECT_EQ(cache.getSize(), 4);
+
+    cache.invalidate({ 42 });
+    EXPECT_EQ(cache.get(42, "default"), nullptr);
+    EXPECT_EQ(cache.get(42, "other"), nullptr);
+    EXPECT_EQ(cache.get(43, "default"), nullptr);
+    EXPECT_NE(cache.get(44, "default"), nullptr);
+    EXPECT_EQ(cache.getSize(), 1);
+}
+
+TEST(ObjectCacheTest, InvalidateRootKeepsPlainItems)
+{
+    CdsObjectCache cache(64);
+    // ref_id NULL is loaded as 0
+    cache.put(createItem(42, 0), "default", cache.getGeneration(42));
+    cache.put(createItem(43), "default", cache.getGeneration(43));
+
+    cache.invalidate({ CDS_ID_ROOT });
+    EXPECT_NE(cache.get(42, "default"), nullptr);
+    EXPECT_NE(cache.get(43, "default"), nullptr);
+    EXPECT_EQ(cache.getSize(), 2);
+}
+
+TEST(ObjectCacheTest, PlayStatusKeepsEntries)
+{
+    CdsObjectCache cache(64);
+    auto item = createItem(42);
+    cache.put(item, "default", cache.getGeneration(42));
+    cache.put(createItem(42), "other", cache.getGeneration(42));
+    auto generation = cache.getGeneration(42);
+
+    cache.updatePlayStatus(std::make_shared<ClientStatusDetail>("default", 42, 3, 0, 0, 0));
+    auto cached = std::static_pointer_cast<CdsItem>(cache.get(42, "default"));
+    ASSERT_NE(cached, nullptr);
+    EXPECT_NE(cached, item);
+    EXPECT_EQ(std::static_pointer_cast<CdsItem>(item)->getPlayStatus(), nullptr);
+    ASSERT_NE(cached->getPlayStatus(), nullptr);
+    EXPECT_EQ(cached->getPlayStatus()->getPlayCount(), 3);
+    EXPECT_EQ(std::static_pointer_cast<CdsItem>(cache.get(42, "other"))->getPlayStatus(), nullptr);
+    EXPECT_EQ(cache.getSize(), 2);
+
+    // object loaded before the update must not replace the new status
+    cache.put(createItem(42), "third", generation);
+    EXPECT_EQ(cache.get(42, "third"), nullptr);
+}
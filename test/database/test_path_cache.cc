@@ -0,0 +1,50 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    test_path_cache.cc - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file test_path_cache.cc
+#include "database/path_cache.h"
+
+#include "common.h"
+
+#include <gtest/gtest.h>
+
+TEST(PathIdCacheTest, InvalidateDropsSubtree)
+{
+    PathIdCache cache(16);
+    cache.put("/media/dir", "2", 5);
+    cache.put("/media/dir/a.mp3", "1", 10);
+    cache.put("/media/dir/sub/b.mp3", "1", 11);
+    cache.put("/media/dir b/c.mp3", "1", 12);
+    cache.put("/media/directory", "2", 13);
+
+    cache.invalidate("/media/dir");
+    EXPECT_EQ(cache.get("/media/dir", "2"), INVALID_OBJECT_ID);
+    EXPECT_EQ(cache.get("/media/dir/a.mp3", "1"), INVALID_OBJECT_ID);
+    EXPECT_EQ(cache.get("/media/dir/sub/b.mp3", "1"), INVALID_OBJECT_ID);
+    EXPECT_EQ(cache.get("/media/dir b/c.mp3", "1"), 12);
+    EXPECT_EQ(cache.get("/media/directory", "2"), 13);
+    EXPECT_EQ(cache.getSize(), 2);
+
+    cache.clear();
+    EXPECT_EQ(cache.getSize(), 0);
+}
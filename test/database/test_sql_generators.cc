@@ -23,6 +23,9 @@
 
 /// \file test_sql_generators.cc
 #include "database/sql_database.h"
+#include "database/sql_result.h"
+#include "database/sql_table.h"
+#include "exceptions.h"
 
 #include "sqlite_config_fake.h"
 
@@ -31,7 +34,10 @@
 
 class TestDatabase : public SQLDatabase {
 public:
+    using SQLDatabase::containerFirstExpression;
+    using SQLDatabase::getKeysetValues;
     using SQLDatabase::identifier;
+    using SQLDatabase::keysetCondition;
 
     TestDatabase(const std::shared_ptr<Config>& config, const std::shared_ptr<Mime>& mime, const std::shared_ptr<ConverterManager>& converterManager)
         : SQLDatabase(config, mime, converterManager)
@@ -146,3 +152,77 @@ TEST_F(DatabaseTest, DeleteTest)
     database->deleteRows("Table", "id", { 1, 2, 3 });
     EXPECT_EQ(database->lastStatement, "DELETE FROM [Table] WHERE [id] IN (1,2,3)");
 }
+
+TEST_F(DatabaseTest, PreparedSelectTest)
+{
+    database->preparedSelect("SELECT [a?] FROM [Table] WHERE [id] = ? AND [name] = ? AND [text] = 'why?'", { 12, "Text" });
+    EXPECT_EQ(database->lastStatement, "SELECT [a?] FROM [Table] WHERE [id] = 12 AND [name] = \"Text\" AND [text] = 'why?'");
+
+    database->preparedSelect("SELECT [a] FROM [Table] WHERE [id] IN (?,?,?)", { 1, 2, 3 });
+    EXPECT_EQ(database->lastStatement, "SELECT [a] FROM [Table] WHERE [id] IN (1,2,3)");
+
+    EXPECT_THROW(database->preparedSelect("SELECT [a] FROM [Table] WHERE [id] = ?", {}), DatabaseException);
+    EXPECT_THROW(database->preparedSelect("SELECT [a] FROM [Table]", { 1 }), DatabaseException);
+}
+
+TEST_F(DatabaseTest, InsertRowsTest)
+{
+    auto qb = sqlForInsertRows("[Table]", {
+                                              { { "[a]", "1" }, { "[b]", "\"x\"" } },
+                                              { { "[a]", "2" }, { "[c]", "3" } },
+                                          });
+    EXPECT_EQ(qb, "INSERT INTO [Table] ([a], [b], [c]) VALUES (1, \"x\", NULL), (2, NULL, 3)");
+}
+
+class PostgresDialectDatabase : public TestDatabase {
+public:
+    PostgresDialectDatabase(const std::shared_ptr<Config>& config, const std::shared_ptr<Mime>& mime, const std::shared_ptr<ConverterManager>& converterManager)
+        : TestDatabase(config, mime, converterManager)
+    {
+        table_quote_begin = '"';
+        table_quote_end = '"';
+        nullsSortLast = true;
+    }
+};
+
+class KeysetRow : public SQLRow {
+public:
+    explicit KeysetRow(std::vector<std::string> values)
+        : values(std::move(values))
+    {
+    }
+
+    char* col_c_str(int index) const override { return const_cast<char*>(values.at(index).c_str()); }
+
+private:
+    std::vector<std::string> values;
+};
+
+TEST_F(DatabaseTest, PostgresMixedBrowsePageTest)
+{
+    auto pgDatabase = std::make_shared<PostgresDialectDatabase>(config, mime, converterManager);
+    pgDatabase->init();
+
+    // keyset of a browse with containers and items sorted by title
+    auto containerFirst = pgDatabase->containerFirstExpression();
+    EXPECT_EQ(containerFirst, "(CASE WHEN \"f\".\"object_type\" = 1 THEN 1 ELSE 0 END)");
+    std::vector<KeysetColumn> keyset {
+        { containerFirst, true, true },
+        { "\"f\".\"upnp_class\"" },
+        { "\"f\".\"dc_title\"" },
+        { "\"f\".\"id\"", false, true },
+    };
+
+    // PostgreSQL returns the integer expression of the last container on the first page
+    std::unique_ptr<SQLRow> row = std::make_unique<KeysetRow>(std::vector<std::string> { "1", "object.container", "Album", "42" });
+    auto values = TestDatabase::getKeysetValues(keyset, row, 0);
+    EXPECT_EQ(std::get<long long>(*values.at(0)), 1);
+
+    std::vector<SQLParam> params;
+    auto condition = pgDatabase->keysetCondition(keyset, values, params);
+    EXPECT_EQ(condition.rfind(fmt::format("(({} < ?) OR ", containerFirst), 0), 0);
+    ASSERT_EQ(params.size(), 10);
+    EXPECT_EQ(std::get<long long>(params.at(0)), 1);
+    EXPECT_EQ(std::get<long long>(params.at(1)), 1);
+    EXPECT_EQ(std::get<std::string>(params.at(2)), "object.container");
+}
@@ -43,6 +43,7 @@ public:
     void dropTables() override { }
 
     void addObject(const std::shared_ptr<CdsObject>& object, int* changedContainer) override { }
+    std::vector<int> addObjects(const std::vector<std::shared_ptr<CdsObject>>& objects) override { return {}; }
     bool addContainer(int parentContainerId, std::string virtualPath, const std::shared_ptr<CdsContainer>& cont, int* containerID) override { return true; }
     fs::path buildContainerPath(int parentID, const std::string& title) override { return {}; }
 
@@ -62,6 +63,12 @@ public:
         const fs::path& path,
         const std::string& group,
         DbFileType fileType = DbFileType::Auto) override { return {}; }
+    int findObjectIdByPath(
+        const fs::path& path,
+        DbFileType fileType = DbFileType::Auto) override { return INVALID_OBJECT_ID; }
+    std::vector<std::shared_ptr<CdsObject>> findObjectsByFileId(
+        const FileId& fileId,
+        DbFileType fileType) override { return {}; }
     std::string incrementUpdateIDs(const std::unordered_set<int>& ids) override { return {}; }
 
     std::shared_ptr<CdsObject> loadObject(int objectID, const std::string& group) override { return nullptr; }
@@ -75,6 +82,7 @@ public:
             return {};
         return { { contId.front(), 0 } };
     }
+    std::size_t checkChildCounts(bool repair) override { return 0; }
 
     std::unique_ptr<ChangedContainers> removeObject(int objectID, const fs::path& path, bool all) override { return {}; }
     std::size_t getObjects(
@@ -31,3 +31,29 @@ TEST_F(RuntimeTest, CheckTestCodeLinksAgainstDependencies)
     auto ctx = runtime->createContext("testCtx");
     EXPECT_NE(ctx, nullptr);
 }
+
+TEST_F(RuntimeTest, CreatesContextsInSeparateHeaps)
+{
+    auto runtime = std::make_unique<ScriptingRuntime>(2);
+    // parsers get a heap besides the layout heaps
+    EXPECT_EQ(runtime->getHeapCount(), 3);
+    EXPECT_EQ(runtime->getFirstLayoutHeap(), 1);
+    EXPECT_EQ(runtime->getLayoutHeapCount(), 2);
+    EXPECT_NE(&runtime->getMutex(0), &runtime->getMutex(1));
+
+    auto ctx0 = runtime->createContext("testCtx", 0);
+    auto ctx1 = runtime->createContext("testCtx", 1);
+    EXPECT_NE(ctx0, nullptr);
+    EXPECT_NE(ctx1, nullptr);
+    EXPECT_NE(ctx0, ctx1);
+    runtime->destroyContext("testCtx", 0);
+    runtime->destroyContext("testCtx", 1);
+}
+
+TEST_F(RuntimeTest, SharesHeapWithSingleLayoutHeap)
+{
+    auto runtime = std::make_unique<ScriptingRuntime>(1);
+    EXPECT_EQ(runtime->getHeapCount(), 1);
+    EXPECT_EQ(runtime->getFirstLayoutHeap(), 0);
+    EXPECT_EQ(runtime->getLayoutHeapCount(), 1);
+}
@@ -0,0 +1,137 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    test_file_io_handler.cc - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+#include "iohandler/file_io_handler.h"
+
+#include <fmt/core.h>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+static constexpr auto testFile = "testdata/Gerberas-Dmitry-Makeev-CC-BY-SA-4.0.jpg";
+
+static std::vector<std::byte> readAll(FileIOHandler& handler, std::size_t chunkSize)
+{
+    std::vector<std::byte> result;
+    std::vector<std::byte> buffer(chunkSize);
+    grb_read_t ret;
+    while ((ret = handler.read(buffer.data(), buffer.size())) > 0)
+        result.insert(result.end(), buffer.begin(), buffer.begin() + ret);
+    EXPECT_EQ(ret, GRB_READ_END);
+    return result;
+}
+
+/// @brief copy of the test file that is old enough to be mapped
+static fs::path oldCopy(const std::string& name)
+{
+    auto copy = fs::temp_directory_path() / fmt::format("grb-{}-{}", name, getpid());
+    fs::copy_file(testFile, copy, fs::copy_options::overwrite_existing);
+    fs::last_write_time(copy, fs::file_time_type::clock::now() - std::chrono::hours(1));
+    return copy;
+}
+
+TEST(FileIOHandlerTest, ReadsSameContentWithReadAheadAndMapping)
+{
+    auto plain = FileIOHandler(testFile);
+    plain.open(UPNP_READ);
+    auto expected = readAll(plain, 1000);
+    plain.close();
+    ASSERT_EQ(expected.size(), fs::file_size(testFile));
+    EXPECT_EQ(plain.getBytesRead(), expected.size());
+    EXPECT_FALSE(plain.isMapped());
+
+    auto readAhead = FileIOHandler(testFile, 0, 4096);
+    readAhead.open(UPNP_READ);
+    EXPECT_EQ(readAll(readAhead, 777), expected);
+    readAhead.close();
+
+    auto copy = oldCopy("mapped");
+    auto mapped = FileIOHandler(copy, 0, 4096, 1);
+    mapped.open(UPNP_READ);
+    EXPECT_TRUE(mapped.isMapped());
+    EXPECT_EQ(readAll(mapped, 333), expected);
+    EXPECT_EQ(mapped.getReadCount(), (expected.size() + 332) / 333);
+    mapped.close();
+    fs::remove(copy);
+}
+
+TEST(FileIOHandlerTest, DoesNotMapRecentlyModifiedFiles)
+{
+    auto copy = oldCopy("recent");
+    fs::last_write_time(copy, fs::file_time_type::clock::now());
+    auto handler = FileIOHandler(copy, 0, 0, 1);
+    handler.open(UPNP_READ);
+    EXPECT_FALSE(handler.isMapped());
+    EXPECT_EQ(readAll(handler, 1000).size(), fs::file_size(testFile));
+    handler.close();
+    fs::remove(copy);
+}
+
+TEST(FileIOHandlerTest, ReadsDataAppendedToMappedFile)
+{
+    auto copy = oldCopy("append");
+    auto size = fs::file_size(copy);
+    auto handler = FileIOHandler(copy, 0, 0, 1);
+    handler.open(UPNP_READ);
+    ASSERT_TRUE(handler.isMapped());
+    EXPECT_EQ(readAll(handler, 1000).size(), size);
+
+    std::ofstream(copy, std::ios::app) << "appended";
+    auto tail = readAll(handler, 4);
+    EXPECT_EQ(tail.size(), 8);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(tail.data()), tail.size()), "appended");
+    handler.close();
+    fs::remove(copy);
+}
+
+TEST(FileIOHandlerTest, SeeksFromOffset)
+{
+    auto plain = FileIOHandler(testFile);
+    plain.open(UPNP_READ);
+    auto expected = readAll(plain, 1000);
+    plain.close();
+
+    auto copy = oldCopy("seek");
+    for (off_t mmapSize : { 0, 1 }) {
+        auto handler = FileIOHandler(copy, 100, 0, mmapSize);
+        handler.open(UPNP_READ);
+        EXPECT_EQ(handler.tell(), 100);
+
+        std::byte value;
+        ASSERT_EQ(handler.read(&value, 1), 1);
+        EXPECT_EQ(value, expected.at(100));
+
+        handler.seek(-10, SEEK_END);
+        EXPECT_EQ(handler.tell(), static_cast<off_t>(expected.size() - 10));
+        auto tail = readAll(handler, 4);
+        EXPECT_EQ(tail, std::vector<std::byte>(expected.end() - 10, expected.end()));
+
+        handler.seek(0, SEEK_SET);
+        handler.seek(20, SEEK_CUR);
+        ASSERT_EQ(handler.read(&value, 1), 1);
+        EXPECT_EQ(value, expected.at(20));
+        EXPECT_THROW(handler.seek(-100, SEEK_SET), std::runtime_error);
+        handler.close();
+    }
+    fs::remove(copy);
+}
@@ -0,0 +1,126 @@
+/*GRB*
+    Gerbera - https://gerbera.io/
+
+    test_lru_cache.cc - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+#include "util/lru_cache.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+TEST(LruCacheTest, GetPutErase)
+{
+    LruCache<std::string, int> cache(16);
+    EXPECT_EQ(cache.get("a"), nullptr);
+    EXPECT_TRUE(cache.put("a", 1));
+    EXPECT_TRUE(cache.put("b", 2));
+    ASSERT_NE(cache.get("a"), nullptr);
+    EXPECT_EQ(*cache.get("a"), 1);
+
+    EXPECT_TRUE(cache.put("a", 3));
+    EXPECT_EQ(*cache.peek("a"), 3);
+    EXPECT_EQ(cache.getSize(), 2);
+
+    EXPECT_TRUE(cache.erase("a"));
+    EXPECT_FALSE(cache.erase("a"));
+    EXPECT_EQ(cache.get("a"), nullptr);
+    EXPECT_EQ(cache.getSize(), 1);
+}
+
+TEST(LruCacheTest, EvictLeastRecentlyUsed)
+{
+    std::vector<std::string> removed;
+    LruCache<std::string, int> cache(2, {}, [&removed](const std::string& key, int) { removed.push_back(key); });
+    cache.put("a", 1);
+    cache.put("b", 2);
+    cache.get("a");
+    // peek does not protect b
+    cache.peek("b");
+    cache.put("c", 3);
+
+    EXPECT_EQ(cache.getSize(), 2);
+    EXPECT_NE(cache.get("a"), nullptr);
+    EXPECT_EQ(cache.get("b"), nullptr);
+    EXPECT_NE(cache.get("c"), nullptr);
+    EXPECT_EQ(removed, std::vector<std::string> { "b" });
+
+    LruCache<std::string, int> disabled(0);
+    EXPECT_FALSE(disabled.put("a", 1));
+    EXPECT_EQ(disabled.getSize(), 0);
+}
+
+TEST(LruCacheTest, EvictByWeight)
+{
+    LruCache<std::string, std::string> cache(10, [](const std::string& value) { return value.size(); });
+    cache.put("a", "xxxx");
+    cache.put("b", "xxxx");
+    EXPECT_EQ(cache.getTotalWeight(), 8);
+
+    cache.put("c", "xxxx");
+    EXPECT_EQ(cache.getTotalWeight(), 8);
+    EXPECT_EQ(cache.get("a"), nullptr);
+
+    // replacing counts the new weight only
+    cache.put("b", "xx");
+    EXPECT_EQ(cache.getTotalWeight(), 6);
+
+    // too heavy values are not added and drop the previous value
+    EXPECT_FALSE(cache.put("c", "xxxxxxxxxxx"));
+    EXPECT_EQ(cache.get("c"), nullptr);
+    EXPECT_EQ(cache.getTotalWeight(), 2);
+}
+
+TEST(LruCacheTest, StalePutIsRejected)
+{
+    LruCache<int, int> cache(16);
+    auto generation = cache.getGeneration();
+    EXPECT_TRUE(cache.put(1, 1, generation));
+
+    cache.invalidate();
+    EXPECT_FALSE(cache.put(2, 2, generation));
+    EXPECT_EQ(cache.get(2), nullptr);
+    EXPECT_NE(cache.get(1), nullptr);
+
+    generation = cache.getGeneration();
+    cache.clear();
+    EXPECT_FALSE(cache.put(2, 2, generation));
+    EXPECT_EQ(cache.getSize(), 0);
+}
+
+TEST(LruCacheTest, OrderedAccess)
+{
+    std::vector<int> removed;
+    LruCache<std::pair<int, int>, int> cache(16, {}, [&removed](const std::pair<int, int>&, int value) { removed.push_back(value); });
+    cache.put({ 1, 10 }, 1);
+    cache.put({ 2, 10 }, 2);
+    cache.put({ 2, 20 }, 3);
+    cache.put({ 3, 10 }, 4);
+
+    auto entry = cache.floor({ 2, 15 });
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->first, std::make_pair(2, 10));
+    EXPECT_EQ(cache.floor({ 1, 5 }), nullptr);
+
+    EXPECT_EQ(cache.eraseWhile({ 2, 0 }, [](auto&& key) { return key.first == 2; }), 2);
+    EXPECT_EQ(removed, (std::vector<int> { 2, 3 }));
+    EXPECT_EQ(cache.getSize(), 2);
+    EXPECT_NE(cache.get({ 3, 10 }), nullptr);
+}
@@ -22,6 +22,7 @@
 
 #include "cds/cds_resource.h"
 #include "transcoding/transcode_ext_handler.h"
+#include "util/file_probe.h"
 #include "util/grb_fs.h"
 #include "util/grb_net.h"
 #include "util/grb_time.h"
@@ -30,7 +31,9 @@
 
 #include <fmt/chrono.h>
 #include <fmt/core.h>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <unistd.h>
 
 TEST(ToolsTest, simpleDate)
 {
@@ -168,6 +171,47 @@ TEST(ToolsTest, subdirSlashTest)
     EXPECT_EQ(isSubDir(test2, test), true);
 }
 
+TEST(ToolsTest, fileIdRenameTest)
+{
+    auto dir = fs::temp_directory_path() / fmt::format("grb-file-id-{}", getpid());
+    fs::create_directories(dir);
+    auto file = dir / "before";
+    std::ofstream(file) << "content";
+
+    auto fileId = getFileId(file);
+    EXPECT_TRUE(fileId.isValid());
+    fs::rename(file, dir / "after");
+    EXPECT_EQ(getFileId(dir / "after"), fileId);
+    EXPECT_FALSE(getFileId(file).isValid());
+    EXPECT_NE(getFileId(dir), fileId);
+
+    fs::remove_all(dir);
+}
+
+TEST(ToolsTest, fileProbeTest)
+{
+    auto file = fs::temp_directory_path() / fmt::format("grb-file-probe-{}", getpid());
+    std::ofstream(file) << "0123456789abcdef";
+
+    FileProbe probe(file, 10);
+    EXPECT_EQ(std::string(probe.getHeader().begin(), probe.getHeader().end()), "0123456789");
+    EXPECT_EQ(probe.getBytesRead(), 10);
+
+    char buffer[8] {};
+    EXPECT_EQ(probe.read(2, buffer, 4), 4);
+    EXPECT_EQ(std::string(buffer, 4), "2345");
+    EXPECT_EQ(probe.getBytesRead(), 10);
+    EXPECT_EQ(probe.read(8, buffer, 8), 8);
+    EXPECT_EQ(std::string(buffer, 8), "89abcdef");
+    EXPECT_EQ(probe.read(14, buffer, 8), 2);
+
+    FileProbe missing(file.string() + ".missing");
+    EXPECT_TRUE(missing.getHeader().empty());
+    EXPECT_EQ(missing.read(0, buffer, 8), 0);
+
+    fs::remove(file);
+}
+
 TEST(ToolsTest, splitStringTest)
 {
     auto parts = splitString("", ',');
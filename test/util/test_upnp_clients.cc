@@ -54,7 +54,7 @@ public:
             std::map<ClientMatchType, std::string>(), 1, -1, false, true);
         EDIT_CAST(EditHelperClientConfig, config->list)->add(rangeConfig, 1);
 
-        subject = new ClientManager(config, nullptr, nullptr);
+        subject = new ClientManager(config, nullptr, nullptr, nullptr);
     }
 
     void TearDown() override
@@ -266,3 +266,20 @@ TEST_F(UpnpClientsTest, netmask6)
     EXPECT_EQ(addr.equals("fe80:0:0:0:523e:aaff:abcd:c277"), false);
     EXPECT_EQ(addr.equals("fe80:0:0:1:522e:aaff:abcd:c276/64"), false);
 }
+
+TEST_F(UpnpClientsTest, cacheByAddress)
+{
+    auto pClient = subject->getInfo(std::make_shared<GrbNet>("192.168.1.42"), "Android/8.0.0 UPnP/1.0 BubbleUPnP/3.4.4", nullptr);
+    EXPECT_EQ(pClient->pInfo->type, ClientType::BubbleUPnP);
+
+    // same address on a new connection finds the cached client
+    auto pCached = subject->getInfo(std::make_shared<GrbNet>("192.168.1.42"), "unknown/1.0", nullptr);
+    EXPECT_EQ(pCached, pClient);
+    EXPECT_EQ(pCached->pInfo->type, ClientType::BubbleUPnP);
+
+    subject->getInfo(std::make_shared<GrbNet>("192.168.1.43"), "unknown/1.0", nullptr);
+    EXPECT_EQ(subject->getClientList().size(), 2);
+
+    subject->removeClient("192.168.1.43");
+    EXPECT_EQ(subject->getClientList().size(), 1);
+}
@@ -0,0 +1,64 @@
+/*GRB*
+    Gerbera - https://gerbera.io/
+
+    test_worker_pool.cc - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+#include "util/worker_pool.h"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+TEST(WorkerPoolTest, RunAllJobs)
+{
+    std::vector<std::size_t> results(100);
+    std::vector<std::future<void>> pending;
+    {
+        WorkerPool pool("test", 4);
+        for (std::size_t job = 0; job < results.size(); job++) {
+            pending.push_back(pool.submit([&results, job](std::size_t worker) {
+                EXPECT_LT(worker, 4);
+                results[job] = job * 2;
+            }));
+        }
+        for (auto&& result : pending)
+            result.get();
+    }
+    for (std::size_t job = 0; job < results.size(); job++)
+        EXPECT_EQ(results[job], job * 2);
+}
+
+TEST(WorkerPoolTest, ForwardException)
+{
+    WorkerPool pool("test", 2);
+    auto result = pool.submit([](std::size_t) { throw std::runtime_error("failed"); });
+    EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+TEST(WorkerPoolTest, FinishQueuedJobsOnDestruction)
+{
+    std::atomic_int count = 0;
+    {
+        WorkerPool pool("test", 1);
+        for (int job = 0; job < 10; job++)
+            pool.submit([&count](std::size_t) { count++; });
+    }
+    EXPECT_EQ(count, 10);
+}
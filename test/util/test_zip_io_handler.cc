@@ -0,0 +1,129 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    test_zip_io_handler.cc - this file is part of Gerbera.
+
+    Copyright (C) 2026 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+#include "iohandler/zip_io_handler.h"
+
+#include <fmt/core.h>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+static constexpr auto testFile = "testdata/Gerberas-Dmitry-Makeev-CC-BY-SA-4.0.jpg";
+
+static std::vector<std::byte> readAll(ZipIOHandler& handler, std::size_t chunkSize)
+{
+    std::vector<std::byte> result;
+    std::vector<std::byte> buffer(chunkSize);
+    grb_read_t ret;
+    while ((ret = handler.read(buffer.data(), buffer.size())) > 0)
+        result.insert(result.end(), buffer.begin(), buffer.begin() + ret);
+    EXPECT_EQ(ret, GRB_READ_END);
+    return result;
+}
+
+static std::uint32_t get32(const std::vector<std::byte>& data, std::size_t offset)
+{
+    std::uint32_t result = 0;
+    for (std::size_t i = 0; i < 4; i++)
+        result |= std::to_integer<std::uint32_t>(data.at(offset + i)) << (8 * i);
+    return result;
+}
+
+static std::vector<ZipIOHandler::ZipEntry> testContent()
+{
+    return {
+        { "first.jpg", testFile },
+        { "../second.jpg", testFile },
+        { "missing.jpg", "testdata/missing.jpg" },
+    };
+}
+
+TEST(ZipIOHandlerTest, StreamsAnnouncedSize)
+{
+    auto handler = ZipIOHandler(testContent());
+    EXPECT_EQ(handler.getEntryCount(), 2);
+
+    auto fileSize = fs::file_size(testFile);
+    auto name = std::string("first.jpg");
+    auto secondName = std::string(".._second.jpg");
+    // local header, data and descriptor, central header, end record
+    EXPECT_EQ(handler.getSize(), static_cast<off_t>(2 * (30 + 16 + 46 + fileSize) + 2 * name.size() + 2 * secondName.size() + 22));
+
+    handler.open(UPNP_READ);
+    auto archive = readAll(handler, 1000);
+    handler.close();
+    ASSERT_EQ(archive.size(), handler.getSize());
+
+    EXPECT_EQ(get32(archive, 0), 0x04034b50U);
+    auto end = archive.size() - 22;
+    EXPECT_EQ(get32(archive, end), 0x06054b50U);
+    EXPECT_EQ(std::to_integer<int>(archive.at(end + 10)), 2);
+    auto centralOffset = get32(archive, end + 16);
+    EXPECT_EQ(get32(archive, centralOffset), 0x02014b50U);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(archive.data()) + 30, name.size()), name);
+
+    // both entries have the same content and checksum
+    auto descriptor = 30 + name.size() + fileSize;
+    EXPECT_EQ(get32(archive, descriptor), 0x08074b50U);
+    EXPECT_EQ(get32(archive, descriptor + 4), get32(archive, descriptor + 16 + 30 + secondName.size() + fileSize + 4));
+    EXPECT_EQ(get32(archive, descriptor + 4), get32(archive, centralOffset + 16));
+}
+
+TEST(ZipIOHandlerTest, CalculatesCrc32)
+{
+    auto file = fs::temp_directory_path() / fmt::format("grb-zip-crc-{}", getpid());
+    std::ofstream(file) << "123456789";
+
+    std::vector<ZipIOHandler::ZipEntry> content { { "check.txt", file } };
+    auto handler = ZipIOHandler(content);
+    handler.open(UPNP_READ);
+    auto archive = readAll(handler, 1000);
+    handler.close();
+    fs::remove(file);
+
+    // check value of CRC-32
+    auto descriptor = 30 + std::string("check.txt").size() + 9;
+    ASSERT_EQ(get32(archive, descriptor), 0x08074b50U);
+    EXPECT_EQ(get32(archive, descriptor + 4), 0xCBF43926U);
+    auto centralOffset = get32(archive, archive.size() - 22 + 16);
+    EXPECT_EQ(get32(archive, centralOffset + 16), 0xCBF43926U);
+}
+
+TEST(ZipIOHandlerTest, ResumesInTheMiddle)
+{
+    auto handler = ZipIOHandler(testContent());
+    handler.open(UPNP_READ);
+    auto expected = readAll(handler, 4096);
+    handler.close();
+
+    // checksum of skipped data has to be calculated for the descriptor and central directory
+    for (off_t start : { off_t(100), handler.getSize() / 2, handler.getSize() - 50 }) {
+        auto resumed = ZipIOHandler(testContent());
+        resumed.open(UPNP_READ);
+        resumed.seek(start, SEEK_SET);
+        EXPECT_EQ(resumed.tell(), start);
+        auto rest = readAll(resumed, 333);
+        resumed.close();
+        EXPECT_EQ(rest, std::vector<std::byte>(expected.begin() + start, expected.end()));
+    }
+}